@@ -49,8 +49,16 @@
     #define PAL_NET_MAX_IF_NAME_LENGTH   16  //15 + '\0'
 #endif
 
-#ifndef PAL_NET_TEST_MAX_ASYNC_SOCKETS
-    #define PAL_NET_TEST_MAX_ASYNC_SOCKETS 5
+#ifndef PAL_NET_SEND_BATCH_SUPPORT
+    #define PAL_NET_SEND_BATCH_SUPPORT true  //!< Use sendmmsg() for pal_sendToBatch()
+#endif
+
+#ifndef PAL_NET_RECEIVE_BATCH_SUPPORT
+    #define PAL_NET_RECEIVE_BATCH_SUPPORT true  //!< Use recvmmsg() for pal_receiveFromBatch()
+#endif
+
+#ifndef PAL_NET_ASYNC_SOCKET_MANAGER_MAX_EVENTS
+    #define PAL_NET_ASYNC_SOCKET_MANAGER_MAX_EVENTS 32  //!< Number of socket events the async socket manager handles per wakeup, the number of async sockets is not limited by this
 #endif
 
 #ifndef PAL_NET_TEST_ASYNC_SOCKET_MANAGER_THREAD_STACK_SIZE
@@ -124,9 +132,4 @@
     #endif
 #endif
 
-#ifndef PAL_TIMER_SIGNAL
-    // Signal number for timer completition signal, a RT signal is needed to get signal queueing
-    #define PAL_TIMER_SIGNAL (SIGRTMIN+0)
-#endif
-
 #endif /* PAL_DEFAULT_LINUX_CONFIGURATION_H_ */
@@ -284,6 +284,56 @@ palStatus_t pal_sendTo(palSocket_t socket, const void* buffer, size_t length, co
 }
 
 
+palStatus_t pal_receiveFromBatch(palSocket_t socket, palSocketBuffer_t* buffers, size_t* bytesReceived, uint32_t count, palSocketAddress_t* from, palSocketLength_t* fromLength, uint32_t* receivedCount)
+{
+    PAL_VALIDATE_ARGUMENTS((NULL == buffers) || (NULL == bytesReceived) || (0 == count) || (NULL == receivedCount) || ((NULL == from) != (NULL == fromLength)));
+
+    palStatus_t result = PAL_SUCCESS;
+#if PAL_NET_RECEIVE_BATCH_SUPPORT
+    result = pal_plat_receiveFromBatch(socket, buffers, bytesReceived, count, from, fromLength, receivedCount);
+#else
+    // a second receive could block, so only one datagram is received per call
+    *receivedCount = 0;
+    result = pal_plat_receiveFrom(socket, buffers[0].buffer, buffers[0].length, from, fromLength, &bytesReceived[0]);
+    if (PAL_SUCCESS == result)
+    {
+        *receivedCount = 1;
+    }
+#endif
+    return result;
+}
+
+
+palStatus_t pal_sendToBatch(palSocket_t socket, const palSocketBuffer_t* buffers, uint32_t count, const palSocketAddress_t* to, palSocketLength_t toLength, uint32_t* sentCount)
+{
+    PAL_VALIDATE_ARGUMENTS((NULL == buffers) || (0 == count) || (NULL == sentCount) || (NULL == to));
+
+    palStatus_t result = PAL_SUCCESS;
+#if PAL_NET_SEND_BATCH_SUPPORT
+    result = pal_plat_sendToBatch(socket, buffers, count, to, toLength, sentCount);
+#else
+    uint32_t i = 0;
+    size_t bytesSent = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        result = pal_plat_sendTo(socket, buffers[i].buffer, buffers[i].length, to, toLength, &bytesSent);
+        if (PAL_SUCCESS != result)
+        {
+            break;
+        }
+    }
+    *sentCount = i;
+    if (i > 0)
+    {
+        // the rest are left to the caller, as with a partial batch send
+        result = PAL_SUCCESS;
+    }
+#endif
+    return result;
+}
+
+
 palStatus_t pal_close(palSocket_t* socket)
 {
     
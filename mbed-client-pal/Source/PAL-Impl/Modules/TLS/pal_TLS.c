@@ -529,6 +529,45 @@ palStatus_t pal_sslGetVerifyResult(palTLSHandle_t palTLSHandle)
 }
 
 
+palStatus_t pal_sslGetSession(palTLSHandle_t palTLSHandle, uint8_t* buffer, uint32_t bufferSize, uint32_t* actualLen)
+{
+	palStatus_t status = PAL_SUCCESS;
+	palTLSService_t* palTLSCtx = (palTLSService_t*)palTLSHandle;
+
+	PAL_VALIDATE_ARGUMENTS (NULLPTR == palTLSHandle);
+	PAL_VALIDATE_ARGUMENTS ((NULLPTR == palTLSCtx->platTlsHandle || NULL == buffer || NULL == actualLen));
+
+	status = pal_plat_sslGetSession(palTLSCtx->platTlsHandle, buffer, bufferSize, actualLen);
+	return status;
+}
+
+
+palStatus_t pal_sslSetSession(palTLSHandle_t palTLSHandle, const uint8_t* buffer, uint32_t len)
+{
+	palStatus_t status = PAL_SUCCESS;
+	palTLSService_t* palTLSCtx = (palTLSService_t*)palTLSHandle;
+
+	PAL_VALIDATE_ARGUMENTS (NULLPTR == palTLSHandle);
+	PAL_VALIDATE_ARGUMENTS ((NULLPTR == palTLSCtx->platTlsHandle || NULL == buffer || 0 == len));
+
+	status = pal_plat_sslSetSession(palTLSCtx->platTlsHandle, buffer, len);
+	return status;
+}
+
+
+palStatus_t pal_sslIsSessionResumed(palTLSHandle_t palTLSHandle, bool* resumed)
+{
+	palStatus_t status = PAL_SUCCESS;
+	palTLSService_t* palTLSCtx = (palTLSService_t*)palTLSHandle;
+
+	PAL_VALIDATE_ARGUMENTS (NULLPTR == palTLSHandle);
+	PAL_VALIDATE_ARGUMENTS ((NULLPTR == palTLSCtx->platTlsHandle || NULL == resumed));
+
+	status = pal_plat_sslIsSessionResumed(palTLSCtx->platTlsHandle, resumed);
+	return status;
+}
+
+
 palStatus_t pal_setHandShakeTimeOut(palTLSConfHandle_t palTLSConf, uint32_t timeoutInMilliSec)
 {
 	palStatus_t status = PAL_SUCCESS;
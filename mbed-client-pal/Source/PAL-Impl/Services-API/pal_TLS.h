@@ -226,6 +226,38 @@ palStatus_t pal_sslGetVerifyResult(palTLSHandle_t palTLSHandle);
 */
 palStatus_t pal_sslGetVerifyResultExtended(palTLSHandle_t palTLSHandle, int32_t* verifyResult);
 
+/*! Export the session negotiated by the last successful handshake, so that it can be resumed on a later connection.
+*	The exported data contains the master secret of the session and must be stored as securely as the private key.
+*
+* @param[in] palTLSHandle: The TLS context.
+* @param[out] buffer: A buffer for the session data, `PAL_TLS_SESSION_MAX_SIZE` bytes is always enough.
+* @param[in] bufferSize: The size of the buffer.
+* @param[out] actualLen: The length of the session data.
+*
+\return PAL_SUCCESS on success. A negative value indicating a specific error code in case of failure.
+*/
+palStatus_t pal_sslGetSession(palTLSHandle_t palTLSHandle, uint8_t* buffer, uint32_t bufferSize, uint32_t* actualLen);
+
+/*! Set a session exported with `pal_sslGetSession` to be resumed by the next handshake of the TLS context.
+*	If the server does not accept the session a full handshake is performed.
+*
+* @param[in] palTLSHandle: The TLS context.
+* @param[in] buffer: The session data.
+* @param[in] len: The length of the session data.
+*
+\return PAL_SUCCESS on success. A negative value indicating a specific error code in case of failure.
+*/
+palStatus_t pal_sslSetSession(palTLSHandle_t palTLSHandle, const uint8_t* buffer, uint32_t len);
+
+/*! Check whether the last handshake resumed a session set with `pal_sslSetSession` instead of negotiating a new one.
+*
+* @param[in] palTLSHandle: The TLS context.
+* @param[out] resumed: True if the session was resumed.
+*
+\return PAL_SUCCESS on success. A negative value indicating a specific error code in case of failure.
+*/
+palStatus_t pal_sslIsSessionResumed(palTLSHandle_t palTLSHandle, bool* resumed);
+
 /*! Read the application data bytes (the max number of bytes).
 *
 * @param[in] palTLSHandle: The TLS context.
@@ -78,6 +78,14 @@
     #define PAL_NET_DNS_SUPPORT                 true/* Add PAL support for DNS lookup. */
 #endif
 
+#ifndef PAL_NET_SEND_BATCH_SUPPORT
+    #define PAL_NET_SEND_BATCH_SUPPORT          false/* Platform can send several datagrams in one call, otherwise pal_sendToBatch() sends them one by one. */
+#endif
+
+#ifndef PAL_NET_RECEIVE_BATCH_SUPPORT
+    #define PAL_NET_RECEIVE_BATCH_SUPPORT       false/* Platform can receive several datagrams in one call, otherwise pal_receiveFromBatch() receives one per call. */
+#endif
+
 #if (PAL_NET_DNS_SUPPORT == true) && !(defined(PAL_DNS_API_VERSION))
 #define PAL_DNS_API_VERSION 1
 #endif
@@ -162,6 +170,12 @@
     #define PAL_DTLS_PEER_MIN_TIMEOUT 1000
 #endif
 
+//! The maximum size of a TLS session exported with `pal_sslGetSession`: 108 bytes of session parameters
+//! and a session ticket of up to 512 bytes.
+#ifndef PAL_TLS_SESSION_MAX_SIZE
+    #define PAL_TLS_SESSION_MAX_SIZE 620
+#endif
+
 //! The debug threshold for TLS API.
 #ifndef PAL_TLS_DEBUG_THRESHOLD
     #define PAL_TLS_DEBUG_THRESHOLD 5
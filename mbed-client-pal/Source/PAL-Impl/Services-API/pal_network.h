@@ -42,6 +42,11 @@ extern "C" {
 typedef uint32_t palSocketLength_t; /*! The length of data. */
 typedef void* palSocket_t; /*! PAL socket handle type. */
 
+typedef struct palSocketBuffer {
+    void* buffer;
+    size_t length;
+} palSocketBuffer_t; /*! A buffer of payload data, used for sending or receiving several datagrams in one call. */
+
 #define  PAL_NET_MAX_ADDR_SIZE 32 // check if we can make this more efficient
 
 typedef struct palSocketAddress {
@@ -189,6 +194,20 @@ palStatus_t pal_bind(palSocket_t socket, palSocketAddress_t* myAddress, palSocke
 */
 palStatus_t pal_receiveFrom(palSocket_t socket, void* buffer, size_t length, palSocketAddress_t* from, palSocketLength_t* fromLength, size_t* bytesReceived);
 
+/*! Receive several datagrams from a given socket, each into a buffer of its own.
+* @param[in] socket The socket to receive from. [The sockets passed to this function should be of type PAL_SOCK_DGRAM.]
+* @param[in] buffers The buffers for the datagrams, `length` of each is the size of the buffer.
+* @param[out] bytesReceived The length of each received datagram, an array of `count` entries.
+* @param[in] count The number of entries in `buffers`.
+* @param[out] from The source address of each received datagram, an array of `count` entries. Optional, may be NULL.
+* @param[in,out] fromLength The length of each address in `from`, set to the address buffer size on input. Optional, may be NULL.
+* @param[out] receivedCount The number of datagrams received, these are in the first `receivedCount` entries of `buffers`.
+\return PAL_SUCCESS (0) if at least one datagram was received or a specific negative error code if none was received.
+\note A blocking socket blocks only until the first datagram is received.
+\note If the platform has no batch receive support (`PAL_NET_RECEIVE_BATCH_SUPPORT`), one datagram is received per call.
+*/
+palStatus_t pal_receiveFromBatch(palSocket_t socket, palSocketBuffer_t* buffers, size_t* bytesReceived, uint32_t count, palSocketAddress_t* from, palSocketLength_t* fromLength, uint32_t* receivedCount);
+
 /*! Send a payload to the given address using the given socket.
 * @param[in] socket The socket to use for sending the payload. [The sockets passed to this function should be of type PAL_SOCK_DGRAM (the implementation may support other types as well).]
 * @param[in] buffer The buffer for the payload data.
@@ -200,6 +219,18 @@ palStatus_t pal_receiveFrom(palSocket_t socket, void* buffer, size_t length, pal
 */
 palStatus_t pal_sendTo(palSocket_t socket, const void* buffer, size_t length, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent);
 
+/*! Send several payloads to the given address using the given socket, each payload as a datagram of its own.
+* @param[in] socket The socket to use for sending the payloads. [The sockets passed to this function should be of type PAL_SOCK_DGRAM.]
+* @param[in] buffers The payloads to send, in order.
+* @param[in] count The number of payloads in `buffers`.
+* @param[in] to The address to which the payloads should be sent.
+* @param[in] toLength The length of the `to` address.
+* @param[out] sentCount The number of payloads sent, these are the first `sentCount` entries of `buffers`.
+\return PAL_SUCCESS (0) if at least one payload was sent or a specific negative error code if none was sent.
+\note If the platform has no batch send support (`PAL_NET_SEND_BATCH_SUPPORT`), the payloads are sent one by one with `pal_sendTo()`.
+*/
+palStatus_t pal_sendToBatch(palSocket_t socket, const palSocketBuffer_t* buffers, uint32_t count, const palSocketAddress_t* to, palSocketLength_t toLength, uint32_t* sentCount);
+
 /*! Close a network socket.
 * @param[in,out] The socket to be closed.
 \return PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure.
@@ -195,6 +195,37 @@ palStatus_t pal_plat_sslSetup(palTLSHandle_t palTLSHandle, palTLSConfHandle_t pa
 */
 palStatus_t pal_plat_handShake(palTLSHandle_t palTLSHandle, uint64_t* serverTime);
 
+/*! Export the session negotiated by the last successful handshake.
+*
+* @param[in] palTLSHandle: The TLS context.
+* @param[out] buffer: A buffer for the session data.
+* @param[in] bufferSize: The size of the buffer.
+* @param[out] actualLen: The length of the session data.
+*
+\return PAL_SUCCESS on success. A negative value indicating a specific error code in case of failure.
+*/
+palStatus_t pal_plat_sslGetSession(palTLSHandle_t palTLSHandle, uint8_t* buffer, uint32_t bufferSize, uint32_t* actualLen);
+
+/*! Set a session exported with `pal_plat_sslGetSession` to be resumed by the next handshake.
+*	The session is applied to the TLS context in `pal_plat_sslSetup`.
+*
+* @param[in] palTLSHandle: The TLS context.
+* @param[in] buffer: The session data.
+* @param[in] len: The length of the session data.
+*
+\return PAL_SUCCESS on success. A negative value indicating a specific error code in case of failure.
+*/
+palStatus_t pal_plat_sslSetSession(palTLSHandle_t palTLSHandle, const uint8_t* buffer, uint32_t len);
+
+/*! Check whether the last handshake resumed a session.
+*
+* @param[in] palTLSHandle: The TLS context.
+* @param[out] resumed: True if the session was resumed.
+*
+\return PAL_SUCCESS on success. A negative value indicating a specific error code in case of failure.
+*/
+palStatus_t pal_plat_sslIsSessionResumed(palTLSHandle_t palTLSHandle, bool* resumed);
+
 #if PAL_USE_SECURE_TIME
 /*! Perform the TLS handshake renegotiation.
 *
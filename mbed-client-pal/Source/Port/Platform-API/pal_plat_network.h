@@ -111,6 +111,36 @@ palStatus_t pal_plat_receiveFrom(palSocket_t socket, void* buffer, size_t length
 */
 palStatus_t pal_plat_sendTo(palSocket_t socket, const void* buffer, size_t length, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent);
 
+#if PAL_NET_RECEIVE_BATCH_SUPPORT
+/*! Receive several datagrams from a given socket, each into a buffer of its own.
+* @param[in] socket The socket to receive from [sockets passed to this function should be of type PAL_SOCK_DGRAM].
+* @param[in] buffers The buffers for the datagrams, `length` of each is the size of the buffer.
+* @param[out] bytesReceived The length of each received datagram.
+* @param[in] count The number of entries in `buffers`, at least one.
+* @param[out] from The source address of each received datagram. Optional, may be NULL.
+* @param[in,out] fromLength The length of each address in `from`. Optional, may be NULL.
+* @param[out] receivedCount The number of datagrams received, the platform may receive fewer than `count` even if more are pending.
+\return PAL_SUCCESS (0) if at least one datagram was received. A specific negative error code if none was received.
+\note A blocking socket must block only until the first datagram is received.
+\note Needed only if `PAL_NET_RECEIVE_BATCH_SUPPORT` is set for the platform.
+*/
+palStatus_t pal_plat_receiveFromBatch(palSocket_t socket, palSocketBuffer_t* buffers, size_t* bytesReceived, uint32_t count, palSocketAddress_t* from, palSocketLength_t* fromLength, uint32_t* receivedCount);
+#endif
+
+#if PAL_NET_SEND_BATCH_SUPPORT
+/*! Send several payloads to the given address using the given socket, each payload as a datagram of its own.
+* @param[in] socket The socket to use for sending the payloads [sockets passed to this function should be of type PAL_SOCK_DGRAM].
+* @param[in] buffers The payloads to send, in order.
+* @param[in] count The number of payloads in `buffers`, at least one.
+* @param[in] to The address to which the payloads should be sent.
+* @param[in] toLength The length of the `to` address.
+* @param[out] sentCount The number of payloads sent.
+\return PAL_SUCCESS (0) if at least one payload was sent. A specific negative error code if none was sent.
+\note Needed only if `PAL_NET_SEND_BATCH_SUPPORT` is set for the platform.
+*/
+palStatus_t pal_plat_sendToBatch(palSocket_t socket, const palSocketBuffer_t* buffers, uint32_t count, const palSocketAddress_t* to, palSocketLength_t toLength, uint32_t* sentCount);
+#endif
+
 /*! Close a network socket. \n
 * \note The function recieves `palSocket_t*` and not `palSocket_t` so that it can zero the socket to avoid re-use.
 * @param[in,out] socket Release and zero socket pointed to by given pointer.
@@ -23,9 +23,21 @@
 #include "string.h"
 #include "sotp.h"
 
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#define mbedtls_calloc calloc
+#endif
+
 
 #define SSL_LIB_SUCCESS 0
 
+//! Format of the session data exported by pal_plat_sslGetSession()
+#define PAL_TLS_SESSION_FORMAT_VERSION 1
+//! Version, start time, cipher suite, compression, session ID length and ID, master secret, verify result,
+//! ticket lifetime, max fragment length, truncated HMAC, encrypt-then-MAC and ticket length, followed by the ticket.
+#define PAL_TLS_SESSION_FIXED_SIZE (1 + 8 + 4 + 1 + 1 + 32 + 48 + 4 + 4 + 1 + 1 + 1 + 2)
+
 #if PAL_USE_SECURE_TIME
 #include "platform_time.h"
 PAL_PRIVATE mbedtls_time_t g_timeFromHS = 0;
@@ -62,6 +74,9 @@ typedef struct palTLS {
     char* psk; //NULL terminated
     char* identity; //NULL terminated
     bool wantReadOrWrite;
+    mbedtls_ssl_session resumeSession; // session to offer in the next handshake, set by pal_plat_sslSetSession
+    bool hasResumeSession;
+    bool sessionResumed;
 }palTLS_t;
 
 
@@ -428,6 +443,7 @@ palStatus_t pal_plat_initTLS(palTLSConfHandle_t palTLSConf, palTLSHandle_t* palT
 
     memset(localTLSHandle, 0 , sizeof(palTLS_t));
     mbedtls_ssl_init(&localTLSHandle->tlsCtx);
+    mbedtls_ssl_session_init(&localTLSHandle->resumeSession);
     localConfigCtx->tlsContext = localTLSHandle;
     localTLSHandle->tlsInit = true;
     mbedtls_ssl_set_timer_cb(&localTLSHandle->tlsCtx, &localConfigCtx->timerCtx, palTimingSetDelay, palTimingGetDelay);
@@ -452,6 +468,7 @@ palStatus_t pal_plat_freeTLS(palTLSHandle_t* palTLSHandle)
 
 
 	mbedtls_ssl_free(&localTLSCtx->tlsCtx);
+	mbedtls_ssl_session_free(&localTLSCtx->resumeSession);
     free(localTLSCtx);
 	*palTLSHandle = NULLPTR;
 
@@ -682,6 +699,17 @@ palStatus_t pal_plat_sslSetup(palTLSHandle_t palTLSHandle, palTLSConfHandle_t pa
 		}
 
 		localConfigCtx->tlsContext = localTLSCtx;
+		localTLSCtx->sessionResumed = false;
+
+		if (localTLSCtx->hasResumeSession)
+		{
+			platStatus = mbedtls_ssl_set_session(&localTLSCtx->tlsCtx, &localTLSCtx->resumeSession);
+			if (SSL_LIB_SUCCESS != platStatus)
+			{
+				//! Not fatal, the handshake just negotiates a new session
+				PAL_LOG(ERR, "SSL set session return code %" PRId32 ".", platStatus);
+			}
+		}
 	}
 finish:
 	return status;
@@ -705,6 +733,11 @@ palStatus_t pal_plat_handShake(palTLSHandle_t palTLSHandle, uint64_t* serverTime
 				( (uint32_t)localTLSCtx->tlsCtx.handshake->randbytes[32 + 2] << 8  ) |
 				( (uint32_t)localTLSCtx->tlsCtx.handshake->randbytes[32 + 3] << 0  );
 		}
+		/* The handshake data is freed when the handshake is over, so follow the resume flag while it exists */
+		if (NULL != localTLSCtx->tlsCtx.handshake)
+		{
+			localTLSCtx->sessionResumed = (0 != localTLSCtx->tlsCtx.handshake->resume);
+		}
 		if (SSL_LIB_SUCCESS != platStatus)
 		{
 			status = translateTLSHandShakeErrToPALError(localTLSCtx, platStatus);
@@ -713,6 +746,195 @@ palStatus_t pal_plat_handShake(palTLSHandle_t palTLSHandle, uint64_t* serverTime
 	return status;
 }
 
+PAL_PRIVATE uint8_t* palSessionWriteUint(uint8_t* p, uint64_t value, uint8_t size)
+{
+	while (size--)
+	{
+		*p++ = (uint8_t)(value >> (size * 8));
+	}
+	return p;
+}
+
+PAL_PRIVATE const uint8_t* palSessionReadUint(const uint8_t* p, uint64_t* value, uint8_t size)
+{
+	*value = 0;
+	while (size--)
+	{
+		*value = (*value << 8) | *p++;
+	}
+	return p;
+}
+
+palStatus_t pal_plat_sslGetSession(palTLSHandle_t palTLSHandle, uint8_t* buffer, uint32_t bufferSize, uint32_t* actualLen)
+{
+	palStatus_t status = PAL_SUCCESS;
+	palTLS_t* localTLSCtx = (palTLS_t*)palTLSHandle;
+	const mbedtls_ssl_session* session = localTLSCtx->tlsCtx.session;
+	uint64_t startTime = 0;
+	uint32_t ticketLifetime = 0;
+	uint8_t mflCode = 0;
+	uint8_t truncHmac = 0;
+	uint8_t encryptThenMac = 0;
+	const unsigned char* ticket = NULL;
+	size_t ticketLen = 0;
+	uint8_t* p = buffer;
+
+	if ((MBEDTLS_SSL_HANDSHAKE_OVER != localTLSCtx->tlsCtx.state) || (NULL == session))
+	{
+		status = PAL_ERR_TLS_CONTEXT_NOT_INITIALIZED;
+		goto finish;
+	}
+
+#if defined(MBEDTLS_HAVE_TIME)
+	startTime = (uint64_t)session->start;
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+	ticketLifetime = session->ticket_lifetime;
+	//! a ticket longer than the maximum is left out, the session ID may still be accepted
+	if (session->ticket_len <= (PAL_TLS_SESSION_MAX_SIZE - PAL_TLS_SESSION_FIXED_SIZE))
+	{
+		ticket = session->ticket;
+		ticketLen = session->ticket_len;
+	}
+#endif
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+	mflCode = session->mfl_code;
+#endif
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+	truncHmac = (uint8_t)session->trunc_hmac;
+#endif
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+	encryptThenMac = (uint8_t)session->encrypt_then_mac;
+#endif
+
+	if ((0 == session->id_len) && (0 == ticketLen))
+	{
+		//! the server did not offer a way to resume the session
+		status = PAL_ERR_NOT_SUPPORTED;
+		goto finish;
+	}
+
+	if (bufferSize < (PAL_TLS_SESSION_FIXED_SIZE + ticketLen))
+	{
+		status = PAL_ERR_BUFFER_TOO_SMALL;
+		goto finish;
+	}
+
+	*p++ = PAL_TLS_SESSION_FORMAT_VERSION;
+	p = palSessionWriteUint(p, startTime, 8);
+	p = palSessionWriteUint(p, (uint32_t)session->ciphersuite, 4);
+	*p++ = (uint8_t)session->compression;
+	*p++ = (uint8_t)session->id_len;
+	memcpy(p, session->id, 32);
+	p += 32;
+	memcpy(p, session->master, 48);
+	p += 48;
+	p = palSessionWriteUint(p, session->verify_result, 4);
+	p = palSessionWriteUint(p, ticketLifetime, 4);
+	*p++ = mflCode;
+	*p++ = truncHmac;
+	*p++ = encryptThenMac;
+	p = palSessionWriteUint(p, ticketLen, 2);
+	if (0 < ticketLen)
+	{
+		memcpy(p, ticket, ticketLen);
+		p += ticketLen;
+	}
+	*actualLen = (uint32_t)(p - buffer);
+
+finish:
+	return status;
+}
+
+palStatus_t pal_plat_sslSetSession(palTLSHandle_t palTLSHandle, const uint8_t* buffer, uint32_t len)
+{
+	palStatus_t status = PAL_SUCCESS;
+	palTLS_t* localTLSCtx = (palTLS_t*)palTLSHandle;
+	mbedtls_ssl_session* session = &localTLSCtx->resumeSession;
+	const uint8_t* p = buffer;
+	uint64_t value = 0;
+
+	//! drop the previous session, also when the new one is not valid
+	mbedtls_ssl_session_free(session);
+	localTLSCtx->hasResumeSession = false;
+
+	if ((PAL_TLS_SESSION_FIXED_SIZE > len) || (PAL_TLS_SESSION_FORMAT_VERSION != *p++))
+	{
+		status = PAL_ERR_TLS_BAD_INPUT_DATA;
+		goto finish;
+	}
+
+	p = palSessionReadUint(p, &value, 8);
+#if defined(MBEDTLS_HAVE_TIME)
+	session->start = (mbedtls_time_t)value;
+#endif
+	p = palSessionReadUint(p, &value, 4);
+	session->ciphersuite = (int)value;
+	session->compression = *p++;
+	session->id_len = *p++;
+	memcpy(session->id, p, 32);
+	p += 32;
+	memcpy(session->master, p, 48);
+	p += 48;
+	p = palSessionReadUint(p, &value, 4);
+	session->verify_result = (uint32_t)value;
+	p = palSessionReadUint(p, &value, 4);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+	session->ticket_lifetime = (uint32_t)value;
+#endif
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+	session->mfl_code = *p;
+#endif
+	p++;
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+	session->trunc_hmac = *p;
+#endif
+	p++;
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+	session->encrypt_then_mac = *p;
+#endif
+	p++;
+	p = palSessionReadUint(p, &value, 2);
+
+	if ((32 < session->id_len) || ((PAL_TLS_SESSION_FIXED_SIZE + value) != len))
+	{
+		status = PAL_ERR_TLS_BAD_INPUT_DATA;
+		goto finish;
+	}
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+	if (0 < value)
+	{
+		//! allocated the way mbedTLS does, as it is freed by mbedtls_ssl_session_free()
+		session->ticket = mbedtls_calloc(1, (size_t)value);
+		if (NULL == session->ticket)
+		{
+			status = PAL_ERR_NO_MEMORY;
+			goto finish;
+		}
+		memcpy(session->ticket, p, (size_t)value);
+		session->ticket_len = (size_t)value;
+	}
+#endif
+
+	localTLSCtx->hasResumeSession = true;
+
+finish:
+	if (PAL_SUCCESS != status)
+	{
+		mbedtls_ssl_session_free(session);
+	}
+	return status;
+}
+
+palStatus_t pal_plat_sslIsSessionResumed(palTLSHandle_t palTLSHandle, bool* resumed)
+{
+	palTLS_t* localTLSCtx = (palTLS_t*)palTLSHandle;
+
+	*resumed = localTLSCtx->sessionResumed;
+	return PAL_SUCCESS;
+}
+
 #if PAL_USE_SECURE_TIME
 palStatus_t pal_plat_renegotiate(palTLSHandle_t palTLSHandle, uint64_t serverTime)
 {
@@ -739,6 +961,8 @@ palStatus_t pal_plat_renegotiate(palTLSHandle_t palTLSHandle, uint64_t serverTim
 		goto finish;
 	}
 
+	//! renegotiation always negotiates a new session
+	localTLSCtx->sessionResumed = false;
 	platStatus = mbedtls_ssl_renegotiate(&localTLSCtx->tlsCtx);    
 	status = translateTLSHandShakeErrToPALError(localTLSCtx, platStatus);
 
@@ -14,7 +14,7 @@
  * limitations under the License.
  *******************************************************************************/
 
-#define _GNU_SOURCE // This is for ppoll found in poll.h
+#define _GNU_SOURCE // This is for sendmmsg and recvmmsg found in sys/socket.h
 #include "pal.h"
 #include "pal_plat_network.h"
 #include "pal_rtos.h"
@@ -33,13 +33,10 @@
 #include <netdb.h>
 #include <ifaddrs.h>
 #include <errno.h>
-#if PAL_NET_ASYNCHRONOUS_SOCKET_API
-#include <pthread.h>
-#include <poll.h>
-#include <signal.h>
 #include <fcntl.h>
-#include <time.h>
-#include <assert.h>
+#if PAL_NET_ASYNCHRONOUS_SOCKET_API
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #endif
 
 #ifdef PAL_NET_TCP_AND_TLS_SUPPORT
@@ -49,6 +46,12 @@
 // invalid socket based on posix
 #define PAL_LINUX_INVALID_SOCKET (-1)
 
+// number of datagrams passed to one sendmmsg() call
+#define PAL_LINUX_SEND_BATCH_SIZE 16
+
+// maximum number of datagrams received by one recvmmsg() call
+#define PAL_LINUX_RECEIVE_BATCH_SIZE 16
+
 
 typedef struct palNetInterfaceName{
     char interfaceName[PAL_NET_MAX_IF_NAME_LENGTH];
@@ -113,226 +116,142 @@ PAL_PRIVATE palStatus_t translateErrorToPALError(int errnoValue)
 }
 
 #if PAL_NET_ASYNCHRONOUS_SOCKET_API
-static pthread_t s_pollThread = NULLPTR;
-static palMutexID_t s_mutexSocketCallbacks = 0;
-static palMutexID_t s_mutexSocketEventFilter = 0;
-static palSemaphoreID_t s_socketCallbackSemaphore = 0;
-static palSemaphoreID_t s_socketCallbackSignalSemaphore = 0;
-
+//! Callback of an asynchronous socket, the table of these is indexed by the socket descriptor.
+typedef struct palAsyncSocketEntry
+{
+    palAsyncSocketCallback_t callback;
+    void* callbackArgument;
+} palAsyncSocketEntry_t;
 
+static palMutexID_t s_mutexSocketCallbacks = 0;
 
 // These must be updated only when protected by s_mutexSocketCallbacks
-static palAsyncSocketCallback_t s_callbacks[PAL_NET_TEST_MAX_ASYNC_SOCKETS] = {0};
-static void* s_callbackArgs[PAL_NET_TEST_MAX_ASYNC_SOCKETS] = { 0 };
-static struct pollfd s_fds[PAL_NET_TEST_MAX_ASYNC_SOCKETS] = {{0,0,0}};
-static uint32_t s_callbackFilter[PAL_NET_TEST_MAX_ASYNC_SOCKETS] = {0};
-static nfds_t s_nfds = 0;
-static volatile bool s_socketThreadTerminateSignaled = false;
-
-// The below function is the signal handler API, doing nothing.
-// The idea is to signal the asyncSocketManager thread with pthread_kill(s_pollThread, SIGUSR1) command
-// which make the ppoll API to be interrupted.
-
-static uint64_t s_palUSR1Counter =0;
-static void sigusr2(int signo) {
-    (void)signo;
-    s_palUSR1Counter++;
-    pal_osSemaphoreRelease(s_socketCallbackSignalSemaphore);
-}
-
-static uint64_t s_palIOCounter =0;
-
-static void sig_io_handler(int signo) {
-    (void)signo;
+static palAsyncSocketEntry_t* s_asyncSockets = NULL;
+static int s_asyncSocketsSize = 0;
 
-    s_palIOCounter++;
-    pal_osSemaphoreRelease(s_socketCallbackSignalSemaphore);
-}
-
-
-static const unsigned int PAL_SOCKETS_TERMINATE = 10000;
+static int s_epollFD = PAL_LINUX_INVALID_SOCKET;
+static int s_wakeupFD = PAL_LINUX_INVALID_SOCKET; // eventfd used to wake up the asyncSocketManager thread for termination
+static volatile bool s_socketThreadTerminateSignaled = false;
 
 
-PAL_PRIVATE void clearSocketFilter( int socketFD)
+// Registers the callback of the socket, growing the table to cover the descriptor if needed.
+PAL_PRIVATE palStatus_t setAsyncSocketCallback(int socketFD, palAsyncSocketCallback_t callback, void* callbackArgument)
 {
     palStatus_t result = PAL_SUCCESS;
-    int i = 0;
-    result = pal_osMutexWait(s_mutexSocketEventFilter, PAL_RTOS_WAIT_FOREVER);
+
+    result = pal_osMutexWait(s_mutexSocketCallbacks, PAL_RTOS_WAIT_FOREVER);
     if (PAL_SUCCESS != result)
     {
-        PAL_LOG(ERR, "error waiting for mutex"); // we want to zero the flag even if this fails beacuse it is better to get an extra event than miss one.
+        return result;
     }
-    for (i = 0; i < PAL_NET_TEST_MAX_ASYNC_SOCKETS; i++)
+
+    if (socketFD >= s_asyncSocketsSize)
     {
+        int newSize = (s_asyncSocketsSize > 0) ? s_asyncSocketsSize : PAL_NET_ASYNC_SOCKET_MANAGER_MAX_EVENTS;
+        palAsyncSocketEntry_t* newTable = NULL;
 
-        if (s_fds[i].fd == socketFD)
+        while (newSize <= socketFD)
         {
-            s_callbackFilter[i] = 0;
-            break;
+            newSize *= 2;
+        }
+        newTable = (palAsyncSocketEntry_t*)realloc(s_asyncSockets, newSize * sizeof(palAsyncSocketEntry_t));
+        if (NULL == newTable)
+        {
+            result = PAL_ERR_NO_MEMORY;
+        }
+        else
+        {
+            memset(newTable + s_asyncSocketsSize, 0, (newSize - s_asyncSocketsSize) * sizeof(palAsyncSocketEntry_t));
+            s_asyncSockets = newTable;
+            s_asyncSocketsSize = newSize;
         }
     }
-    result = pal_osMutexRelease(s_mutexSocketEventFilter);
-    if (PAL_SUCCESS != result)
+
+    if (PAL_SUCCESS == result)
+    {
+        s_asyncSockets[socketFD].callback = callback;
+        s_asyncSockets[socketFD].callbackArgument = callbackArgument;
+    }
+
+    if (PAL_SUCCESS != pal_osMutexRelease(s_mutexSocketCallbacks))
     {
         PAL_LOG(ERR, "error releasing mutex");
     }
+    return result;
 }
 
 
 // Thread function.
+// Waits for edge-triggered events of all the asynchronous sockets in one epoll set and calls the callbacks
+// of the ready sockets only. The callback is expected to read or write until the operation would block.
 PAL_PRIVATE void asyncSocketManager(void const* arg)
 {
     PAL_UNUSED_ARG(arg); // unused
-    int res;
-    palAsyncSocketCallback_t callbacks[PAL_NET_TEST_MAX_ASYNC_SOCKETS] = {0};
-    void* callbackArgs[PAL_NET_TEST_MAX_ASYNC_SOCKETS] = {0};
-    struct pollfd fds[PAL_NET_TEST_MAX_ASYNC_SOCKETS] = {{0,0,0}};
-    nfds_t nfds = 0;
-    struct sigaction s;
-    sigset_t blockedSignals;
-    palStatus_t result = PAL_SUCCESS;
-    uint64_t lastIOCounter=0;
-    uint64_t lastUSRCounter=0;
-
-    const struct timespec timeout_zero = {0, 0};
-
-    // Initialize the signal handler. SIG_IGN and SIG_DFL do not work
-    s.sa_handler = sigusr2;
-    sigemptyset(&s.sa_mask);
-    s.sa_flags = 0;
-    sigaction(SIGUSR1, &s, NULL);
-
-    s.sa_handler = sig_io_handler;
-    sigemptyset(&s.sa_mask);
-    s.sa_flags =  SA_RESTART ;
-    sigaction(SIGIO, &s, NULL);
-
-    // Block the timer signal from interrupting ppoll(), as it does not have a signal handler.
-    // The timer signal is already blocked on all the threads created after pal_init(), but
-    // the ppoll() will change that situation with the given sigmask.
-    // Without this, the libc's default signal handler will kick in and kill the process.
-    sigemptyset(&blockedSignals);
-    sigaddset(&blockedSignals, PAL_TIMER_SIGNAL);
-
-    s_pollThread = pthread_self(); // save the thread id for signal usage
-    // Tell the calling thread that we have finished initialization
-    result = pal_osSemaphoreRelease(s_socketCallbackSemaphore);
-    if (result != PAL_SUCCESS)
-    {
-        PAL_LOG(ERR, "Error in async socket manager on semaphore release");
-    }
-
+    struct epoll_event events[PAL_NET_ASYNC_SOCKET_MANAGER_MAX_EVENTS];
+    palAsyncSocketCallback_t callback = NULL;
+    void* callbackArgument = NULL;
+    bool terminate = false;
+    int count = 0;
+    int i = 0;
 
-    while (result == PAL_SUCCESS) //As long as all goes well loop forever
+    while (!terminate)
     {
-        // block until a SIGIO signal is received
-        if (lastUSRCounter == s_palUSR1Counter) // no updates to the sockets that need to be polled (wait for next IO)  - if there were updates skip waiting and proceeed to poll
+        count = epoll_wait(s_epollFD, events, PAL_NET_ASYNC_SOCKET_MANAGER_MAX_EVENTS, -1);
+        if (count < 0)
         {
-            pal_osSemaphoreWait(s_socketCallbackSignalSemaphore, PAL_RTOS_WAIT_FOREVER, NULL);
-        }
-
-        // Critical section to update globals
-        result = pal_osMutexWait(s_mutexSocketCallbacks, PAL_RTOS_WAIT_FOREVER);
-        if (PAL_SUCCESS != result)
-        {
-            PAL_LOG(ERR, "Error in async socket manager on mutex wait");
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            PAL_LOG(ERR, "Error in async socket manager %d", errno);
             break;
         }
 
-        // Check for thread termination request
-        if(s_nfds == PAL_SOCKETS_TERMINATE)
+        for (i = 0; i < count; i++)
         {
-            result = pal_osMutexRelease(s_mutexSocketCallbacks);
-            if (result != PAL_SUCCESS)
+            if (events[i].data.fd == s_wakeupFD)
             {
-                PAL_LOG(ERR, "Error in async socket manager on mutex release during termination");
+                terminate = true;
+                continue;
             }
-            s_nfds = 0; // Reset s_ndfs
-            s_socketThreadTerminateSignaled = true; // mark that the thread has receieved the termination request
-            // Break out of while(1)
-            break;
-        }
-        // Update the list of sockets to watch from the global list
-        nfds = s_nfds;
-        if(nfds)
-        {
-            memcpy(callbacks, s_callbacks, nfds*sizeof(callbacks[0]));
-            memcpy(callbackArgs, s_callbackArgs, nfds * sizeof(void*));
-            memcpy(fds, s_fds, nfds*sizeof(fds[0]));
 
-            for (int i=0; i < nfds; i++)
+            // This event combination is reported for sockets which are not connected yet, it shouldn't exist
+            // on an active socket.
+            if (events[i].events == (EPOLLOUT | EPOLLHUP))
             {
-                fds[i].events = POLLIN|POLLOUT|POLLRDHUP|POLLERR;
-                fds[i].revents = 0;
-                s_callbackFilter[i] = 0;
+                continue;
             }
-        }
-        result = pal_osMutexRelease(s_mutexSocketCallbacks);
-        if (result != PAL_SUCCESS)
-        {
-            PAL_LOG(ERR, "Error in async socket manager on mutex release");
-            break;
-        }
-
-        // Wait for a socket event or pthread_kill(s_pollThread, SIGUSR1) event
-        lastUSRCounter = s_palUSR1Counter;
-        res = ppoll(&fds[0], nfds, &timeout_zero, &blockedSignals);
-
-
-        // Notes:
-        // If a POLLIN event occurred and recv from the socket results in 0 bytes being read, it means that
-        // the remote socket was closed. Unless this is dealt with in the callback (for example by closing the
-        // socket) the next call to ppoll will also immediately return with the same result.
-        if(res >0 || errno == EINTR)
-        {
-            unsigned int i;
-            errno = 0;
-            // Some event was triggered, so iterate over all watched fds's and call the relevant callbacks.
-                if (lastIOCounter< s_palIOCounter)
-                {
-                    lastIOCounter = s_palIOCounter;
-                    for( i = 0; i < nfds; i++)
-                    {
-                        if(fds[i].revents)
-                        {
-                            uint32_t filter = POLLOUT|POLLHUP; // filter for specific event that is triggered for non-connected sockets- this event combination shouldn't exist in an active socket.
-
-
-                            if ((fds[i].revents != filter) && ((fds[i].revents != POLLOUT) || (fds[i].revents != s_callbackFilter[i])) ) // this is handlign for a special scenario when a specific event which shouldnt happen is sent to all unconnected sockets in Linux triggering an unwanted callback.
-                            {
-                                callbacks[i](callbackArgs[i]);
-                            }
-                            result = pal_osMutexWait(s_mutexSocketEventFilter, PAL_RTOS_WAIT_FOREVER);
-                            if (PAL_SUCCESS != result)
-                            {
-                                PAL_LOG(ERR, "error waiting for mutex");
-                            }
-                            else
-                            {
-                                s_callbackFilter[i] = fds[i].revents;
-                                result = pal_osMutexRelease(s_mutexSocketEventFilter);
-                                if (PAL_SUCCESS != result)
-                                {
-                                    PAL_LOG(ERR, "error releasing mutex");
-                                }
-                            }
-
-
-                        }
-                    }
-                }
 
+            callback = NULL;
+            if (PAL_SUCCESS != pal_osMutexWait(s_mutexSocketCallbacks, PAL_RTOS_WAIT_FOREVER))
+            {
+                PAL_LOG(ERR, "Error in async socket manager on mutex wait");
+                terminate = true;
+                break;
+            }
+            // The socket may have been closed after the event was collected
+            if (events[i].data.fd < s_asyncSocketsSize)
+            {
+                callback = s_asyncSockets[events[i].data.fd].callback;
+                callbackArgument = s_asyncSockets[events[i].data.fd].callbackArgument;
+            }
+            if (PAL_SUCCESS != pal_osMutexRelease(s_mutexSocketCallbacks))
+            {
+                PAL_LOG(ERR, "Error in async socket manager on mutex release");
+            }
 
-        }
-        else if (res == 0)
-        {
-            // Timeout
-        }
-        else
-        {
-            PAL_LOG(ERR, "Error in async socket manager");
+            // Notes:
+            // If an EPOLLIN event occurred and recv from the socket results in 0 bytes being read, it means that
+            // the remote socket was closed. Unless this is dealt with in the callback (for example by closing the
+            // socket), no more events are reported for the socket.
+            if (NULL != callback)
+            {
+                callback(callbackArgument);
+            }
         }
     }  // while
+
+    s_socketThreadTerminateSignaled = true; // mark that the thread has receieved the termination request
 }
 #endif // PAL_NET_ASYNCHRONOUS_SOCKET_API
 
@@ -448,35 +367,29 @@ palStatus_t pal_plat_socketsInit(void* context)
 
 #if PAL_NET_ASYNCHRONOUS_SOCKET_API
 
+    struct epoll_event event;
+
     result = pal_osMutexCreate(&s_mutexSocketCallbacks);
     if (result != PAL_SUCCESS)
     {
         return result;
     }
 
-    result = pal_osMutexCreate(&s_mutexSocketEventFilter);
-    if (PAL_SUCCESS != result)
-    {
-        return result;
-    }
-
-
-    result = pal_osSemaphoreCreate(0, &s_socketCallbackSignalSemaphore);
-    if (result != PAL_SUCCESS)
+    s_epollFD = epoll_create1(EPOLL_CLOEXEC);
+    s_wakeupFD = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ((PAL_LINUX_INVALID_SOCKET == s_epollFD) || (PAL_LINUX_INVALID_SOCKET == s_wakeupFD))
     {
-        // todo: clean up the mess created so far
-        return result;
+        result = translateErrorToPALError(errno);
+        goto end;
     }
 
-    // Sleep at first wait
-    result = pal_osSemaphoreCreate(0, &s_socketCallbackSemaphore);
-    if (result != PAL_SUCCESS)
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = s_wakeupFD;
+    if (-1 == epoll_ctl(s_epollFD, EPOLL_CTL_ADD, s_wakeupFD, &event))
     {
-        if (pal_osMutexDelete(&s_mutexSocketCallbacks) != PAL_SUCCESS) //cleanup allocated resources
-        {
-            // TODO print error using logging mechanism when available.
-        }
-        return result;
+        result = translateErrorToPALError(errno);
+        goto end;
     }
 
     s_socketThreadTerminateSignaled = false;
@@ -493,28 +406,34 @@ palStatus_t pal_plat_socketsInit(void* context)
             result = PAL_ERR_SOCKET_GENERIC;
         }
     }
+#endif
+
+end:
+    if (PAL_SUCCESS == result)
+    {
+        s_pal_network_initialized = 1;
+    }
+#if PAL_NET_ASYNCHRONOUS_SOCKET_API
     else
     {
-        // Wait here for the thread to be initialized.
-        result = pal_osSemaphoreWait(s_socketCallbackSemaphore, PAL_RTOS_WAIT_FOREVER, NULL);
-        if (PAL_SUCCESS != result)
+        //cleanup allocated resources
+        if (PAL_LINUX_INVALID_SOCKET != s_wakeupFD)
+        {
+            close(s_wakeupFD);
+            s_wakeupFD = PAL_LINUX_INVALID_SOCKET;
+        }
+        if (PAL_LINUX_INVALID_SOCKET != s_epollFD)
         {
-            goto end;
+            close(s_epollFD);
+            s_epollFD = PAL_LINUX_INVALID_SOCKET;
         }
-        result = pal_osSemaphoreDelete(&s_socketCallbackSemaphore);
-        if (PAL_SUCCESS != result)
+        if (pal_osMutexDelete(&s_mutexSocketCallbacks) != PAL_SUCCESS)
         {
-            goto end;
+            PAL_LOG(ERR, "error deleting mutex");
         }
     }
 #endif
 
-end:
-    if (PAL_SUCCESS == result)
-    {
-        s_pal_network_initialized = 1;
-    }
-
 
     return result;
 }
@@ -559,52 +478,30 @@ palStatus_t pal_plat_socketsTerminate(void* context)
     palStatus_t firstError = PAL_SUCCESS;
 
 #if PAL_NET_ASYNCHRONOUS_SOCKET_API
-    // Critical section to update globals
-    result = pal_osMutexWait(s_mutexSocketCallbacks, PAL_RTOS_WAIT_FOREVER);
-    if (result != PAL_SUCCESS)
-    {
-        // TODO print error using logging mechanism when available.
-        firstError = result;
-    }
+    uint64_t wakeup = 1;
 
-    s_nfds = PAL_SOCKETS_TERMINATE;
-    result = pal_osSemaphoreRelease(s_socketCallbackSignalSemaphore);
-    if ((PAL_SUCCESS != result) && (PAL_SUCCESS == firstError))
+    // Tell the manager thread to interrupt epoll_wait() so that it can check for termination.
+    if (sizeof(wakeup) != write(s_wakeupFD, &wakeup, sizeof(wakeup)))
     {
-        // TODO print error using logging mechanism when available.
-        firstError = result;
+        PAL_LOG(ERR, "error waking up the async socket manager %d", errno);
+        firstError = PAL_ERR_SOCKET_GENERIC;
     }
-    // Tell the poll thread to interrupt so that it can check for termination.
-    if(s_pollThread != NULLPTR)
-    {
-        pthread_kill(s_pollThread, SIGUSR1);
-    }
-    
-    result = pal_osMutexRelease(s_mutexSocketCallbacks);
-    if ((PAL_SUCCESS != result) && (PAL_SUCCESS == firstError))
-    {
-        // TODO print error using logging mechanism when available.
-        firstError = result;
-    }
-
-    while (!s_socketThreadTerminateSignaled)
+    else
     {
-        pal_osDelay(10);
+        while (!s_socketThreadTerminateSignaled)
+        {
+            pal_osDelay(10);
+        }
     }
 
-    result = pal_osSemaphoreDelete(&s_socketCallbackSignalSemaphore);
-    if ((PAL_SUCCESS != result) && (PAL_SUCCESS == firstError))
-    {
-        // TODO print error using logging mechanism when available.
-        firstError = result;
-    }
+    close(s_wakeupFD);
+    s_wakeupFD = PAL_LINUX_INVALID_SOCKET;
+    close(s_epollFD);
+    s_epollFD = PAL_LINUX_INVALID_SOCKET;
 
-    result = pal_osMutexDelete(&s_mutexSocketEventFilter);
-    if ((PAL_SUCCESS != result) && (PAL_SUCCESS == firstError))
-    {
-        // TODO print error using logging mechanism when available.
-        firstError = result;
-    }
+    free(s_asyncSockets);
+    s_asyncSockets = NULL;
+    s_asyncSocketsSize = 0;
 
     result = pal_osMutexDelete(&s_mutexSocketCallbacks);
     if ((PAL_SUCCESS != result ) && (PAL_SUCCESS == firstError))
@@ -778,7 +675,6 @@ palStatus_t pal_plat_receiveFrom(palSocket_t socket, void* buffer, size_t length
     struct sockaddr_storage internalAddr;
     socklen_t addrlen;
 
-    clearSocketFilter((intptr_t)socket);
     addrlen = sizeof(struct sockaddr_storage);
     res = recvfrom((intptr_t)socket, buffer, length, 0 ,(struct sockaddr *)&internalAddr, &addrlen);
     if(res == -1)
@@ -797,12 +693,68 @@ palStatus_t pal_plat_receiveFrom(palSocket_t socket, void* buffer, size_t length
     return result;
 }
 
+#if PAL_NET_RECEIVE_BATCH_SUPPORT
+palStatus_t pal_plat_receiveFromBatch(palSocket_t socket, palSocketBuffer_t* buffers, size_t* bytesReceived, uint32_t count, palSocketAddress_t* from, palSocketLength_t* fromLength, uint32_t* receivedCount)
+{
+    palStatus_t result = PAL_SUCCESS;
+    struct mmsghdr messages[PAL_LINUX_RECEIVE_BATCH_SIZE];
+    struct iovec vectors[PAL_LINUX_RECEIVE_BATCH_SIZE];
+    struct sockaddr_storage internalAddr[PAL_LINUX_RECEIVE_BATCH_SIZE];
+    uint32_t i = 0;
+    int res;
+
+    *receivedCount = 0;
+    if (count > PAL_LINUX_RECEIVE_BATCH_SIZE)
+    {
+        count = PAL_LINUX_RECEIVE_BATCH_SIZE;
+    }
+
+    memset(messages, 0, count * sizeof(messages[0]));
+    for (i = 0; i < count; i++)
+    {
+        vectors[i].iov_base = buffers[i].buffer;
+        vectors[i].iov_len = buffers[i].length;
+        messages[i].msg_hdr.msg_iov = &vectors[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        if (NULL != from)
+        {
+            messages[i].msg_hdr.msg_name = &internalAddr[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(internalAddr[i]);
+        }
+    }
+
+    // MSG_WAITFORONE turns on MSG_DONTWAIT after the first datagram, so a blocking socket does not wait for a full batch
+    res = recvmmsg((intptr_t)socket, messages, count, MSG_WAITFORONE, NULL);
+    if (res == -1)
+    {
+        result = translateErrorToPALError(errno);
+    }
+    else // only return addresses / lengths in case of success
+    {
+        for (i = 0; i < (uint32_t)res; i++)
+        {
+            bytesReceived[i] = messages[i].msg_len;
+            if (NULL != from)
+            {
+                result = pal_plat_socketAddressToPalSockAddr((struct sockaddr *)&internalAddr[i], &from[i], &fromLength[i]);
+                if (PAL_SUCCESS != result)
+                {
+                    break;
+                }
+            }
+        }
+        *receivedCount = res;
+    }
+
+    return result;
+}
+#endif // PAL_NET_RECEIVE_BATCH_SUPPORT
+
 palStatus_t pal_plat_sendTo(palSocket_t socket, const void* buffer, size_t length, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent)
 {
     palStatus_t result = PAL_SUCCESS;
     ssize_t res;
 
-    clearSocketFilter((intptr_t)socket);
     res = sendto((intptr_t)socket, buffer, length, 0, (struct sockaddr *)to, toLength);
     if(res == -1)
     {
@@ -816,11 +768,62 @@ palStatus_t pal_plat_sendTo(palSocket_t socket, const void* buffer, size_t lengt
     return result;
 }
 
+#if PAL_NET_SEND_BATCH_SUPPORT
+palStatus_t pal_plat_sendToBatch(palSocket_t socket, const palSocketBuffer_t* buffers, uint32_t count, const palSocketAddress_t* to, palSocketLength_t toLength, uint32_t* sentCount)
+{
+    palStatus_t result = PAL_SUCCESS;
+    struct mmsghdr messages[PAL_LINUX_SEND_BATCH_SIZE];
+    struct iovec vectors[PAL_LINUX_SEND_BATCH_SIZE];
+    uint32_t batch = 0;
+    uint32_t i = 0;
+    int res;
+
+    *sentCount = 0;
+    while (*sentCount < count)
+    {
+        batch = count - *sentCount;
+        if (batch > PAL_LINUX_SEND_BATCH_SIZE)
+        {
+            batch = PAL_LINUX_SEND_BATCH_SIZE;
+        }
+
+        memset(messages, 0, batch * sizeof(messages[0]));
+        for (i = 0; i < batch; i++)
+        {
+            vectors[i].iov_base = buffers[*sentCount + i].buffer;
+            vectors[i].iov_len = buffers[*sentCount + i].length;
+            messages[i].msg_hdr.msg_name = (void*)to;
+            messages[i].msg_hdr.msg_namelen = toLength;
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        res = sendmmsg((intptr_t)socket, messages, batch, 0);
+        if (res == -1)
+        {
+            // an error after some datagrams were sent is reported on the next call
+            if (*sentCount == 0)
+            {
+                result = translateErrorToPALError(errno);
+            }
+            break;
+        }
+
+        *sentCount += res;
+        if ((uint32_t)res < batch)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+#endif // PAL_NET_SEND_BATCH_SUPPORT
+
 palStatus_t pal_plat_close(palSocket_t* socket)
 {
     palStatus_t result = PAL_SUCCESS;
     int res;
-    unsigned int i,j;
 
     if  (*socket == (void *)PAL_LINUX_INVALID_SOCKET) // socket already closed - return success.
     {
@@ -836,29 +839,12 @@ palStatus_t pal_plat_close(palSocket_t* socket)
         return result;
     }
 
-    for(i= 0 ; i < s_nfds; i++)
+    // Remove the callback before the descriptor can be reused by another socket
+    if (((intptr_t)*socket < s_asyncSocketsSize) && (NULL != s_asyncSockets[(intptr_t)*socket].callback))
     {
-        // check if we have we found the socket being closed
-        if (s_fds[i].fd == (intptr_t)*socket)
-        {
-            // Remove from async socket list
-            // Close the gap in the socket data structures.
-            for(j = i; j < s_nfds - 1; j++)
-            {
-                s_fds[j].fd = s_fds[j+1].fd;
-                s_fds[j].events = s_fds[j+1].events;
-                s_callbacks[j] = s_callbacks[j+1];
-                s_callbackArgs[j] = s_callbackArgs[j+1];
-            }
-            // Blank out the last one
-            s_fds[j].fd = 0;
-            s_callbacks[j] = 0;
-            s_callbackArgs[j] = 0;
-            s_nfds--;
-            // Tell the poll thread to remove the socket
-            pthread_kill(s_pollThread, SIGUSR1);
-            break;
-        }
+        s_asyncSockets[(intptr_t)*socket].callback = NULL;
+        s_asyncSockets[(intptr_t)*socket].callbackArgument = NULL;
+        epoll_ctl(s_epollFD, EPOLL_CTL_DEL, (intptr_t)*socket, NULL);
     }
     result = pal_osMutexRelease(s_mutexSocketCallbacks);
     if (result != PAL_SUCCESS)
@@ -1010,7 +996,6 @@ palStatus_t pal_plat_recv(palSocket_t socket, void *buffer, size_t len, size_t*
     palStatus_t result = PAL_SUCCESS;
     ssize_t res;
 
-    clearSocketFilter((intptr_t)socket);
     res = recv((intptr_t)socket, buffer, len, 0);
     if(res ==  -1)
     {
@@ -1032,8 +1017,6 @@ palStatus_t pal_plat_send(palSocket_t socket, const void *buf, size_t len, size_
     palStatus_t result = PAL_SUCCESS;
     ssize_t res;
 
-    clearSocketFilter((intptr_t)socket);
-
     res = send((intptr_t)socket, buf, len, 0);
     if(res == -1)
     {
@@ -1053,53 +1036,31 @@ palStatus_t pal_plat_send(palSocket_t socket, const void *buf, size_t len, size_
 #if PAL_NET_ASYNCHRONOUS_SOCKET_API
 palStatus_t pal_plat_asynchronousSocket(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketCallback_t callback, void* callbackArgument, palSocket_t* socket)
 {
-
-    int err;
-    int flags;
+    struct epoll_event event;
     palStatus_t result = pal_plat_socket(domain,  type,  nonBlockingSocket,  interfaceNum, socket);
 
-
-
-        // initialize the socket to be ASYNC so we get SIGIO's for it
-        // XXX: this needs to be conditionalized as the blocking IO might have some use also.
-        err = fcntl((intptr_t)*socket, F_SETOWN, getpid());
-        assert(err != -1);
-
-        flags = fcntl((intptr_t)*socket, F_GETFL, 0);
-        assert(flags >= 0);
-
-        flags |= O_ASYNC;
-
-        err = fcntl((intptr_t)*socket, F_SETFL, flags);
-
-        if (err == -1)
-        {
-            result = translateErrorToPALError(errno);
-        }
-
-
     if (result == PAL_SUCCESS)
     {
-        // Critical section to update globals
-        result = pal_osMutexWait(s_mutexSocketCallbacks, PAL_RTOS_WAIT_FOREVER);
+        // The callback must be in place before the first event can be reported
+        result = setAsyncSocketCallback((intptr_t)*socket, callback, callbackArgument);
         if (result != PAL_SUCCESS)
         {
-            // TODO print error using logging mechanism when available.
+            close((intptr_t)*socket);
+            *socket = (palSocket_t)PAL_LINUX_INVALID_SOCKET;
             return result;
         }
-        s_fds[s_nfds].fd = (intptr_t)*socket;
-        s_fds[s_nfds].events = POLLIN|POLLERR;  //TODO POLLOUT missing is not documented
-        s_callbacks[s_nfds] = callback;
-        s_callbackArgs[s_nfds] = callbackArgument;
-        s_nfds++;
-        result = pal_osMutexRelease(s_mutexSocketCallbacks);
-        if (result != PAL_SUCCESS)
+
+        // Edge-triggered, so the manager thread is woken up only when the state of the socket changes
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.fd = (intptr_t)*socket;
+        if (-1 == epoll_ctl(s_epollFD, EPOLL_CTL_ADD, (intptr_t)*socket, &event))
         {
-            // TODO print error using logging mechanism when available.
-            return result;
+            result = translateErrorToPALError(errno);
+            setAsyncSocketCallback((intptr_t)*socket, NULL, NULL);
+            close((intptr_t)*socket);
+            *socket = (palSocket_t)PAL_LINUX_INVALID_SOCKET;
         }
-        // Tell the poll thread to add the new socket
-        pthread_kill(s_pollThread, SIGUSR1);
     }
 
     return result;
@@ -25,6 +25,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/timerfd.h>
 #include <sys/reboot.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -66,26 +67,33 @@ typedef struct palThreadData
  */
 struct palTimerInfo
 {
-    struct palTimerInfo *next;
-    timer_t handle;
     palTimerFuncPtr function;
     void *funcArgs;
     palTimerType_t timerType;
+    uint64_t expiry; // absolute CLOCK_MONOTONIC time of the next expiration in nanoseconds
+    uint64_t period; // in nanoseconds, zero for a one-shot timer
+    int32_t heapIndex; // position in g_timerHeap, PAL_TIMER_NOT_RUNNING when the timer is stopped
 };
 
+#define PAL_TIMER_NOT_RUNNING (-1)
+#define PAL_TIMER_HEAP_INITIAL_SIZE 16
+
 
 PAL_PRIVATE char g_mqName[MQ_FILENAME_LEN];
 PAL_PRIVATE int g_mqNextNameNum = 0;
 
-// Mutex to prevent simultaneus modification of the linked list of the timers in g_timerList.
-PAL_PRIVATE palMutexID_t g_timerListMutex = 0;
+// Mutex to prevent simultaneus modification of the timer heap and the timerfd.
+PAL_PRIVATE palMutexID_t g_timerHeapMutex = 0;
 
-// A singly linked list of the timers, access may be done only if holding the g_timerListMutex.
-// The list is needed as the timers use async signals and when the signal is finally delivered, the
-// palTimerInfo timer struct may be already deleted. The signals themselves carry pointer to timer,
-// so whenever a signal is received, the thread will look if the palTimerInfo is still on the list,
-// and if it is, uses the struct to find the callback pointer and arguments.
-PAL_PRIVATE volatile struct palTimerInfo *g_timerList = NULL;
+// A binary min-heap of the running timers ordered by expiry, access may be done only if holding
+// the g_timerHeapMutex. The heap has room for every created timer, so starting one never allocates.
+// A single timerfd is armed to the expiry of the first timer, the timer thread reads it and calls
+// the callbacks of the expired timers.
+PAL_PRIVATE struct palTimerInfo **g_timerHeap = NULL;
+PAL_PRIVATE uint32_t g_timerHeapCount = 0;
+PAL_PRIVATE uint32_t g_timerHeapSize = 0;
+PAL_PRIVATE uint32_t g_timerCount = 0;
+PAL_PRIVATE int g_timerFD = -1;
 
 extern palStatus_t pal_plat_getRandomBufferFromHW(uint8_t *randomBuf, size_t bufSizeBytes, size_t* actualRandomSizeBytes);
 
@@ -129,27 +137,9 @@ palStatus_t pal_plat_RTOSInitialize(void* opaqueContext)
     status = pal_plat_rtcInit();
 #endif
 
-    // Setup the signal handler thread which will be shared with all the timers
-
-    status = pal_osMutexCreate(&g_timerListMutex);
-
-    if (status == PAL_SUCCESS) {
-
-        sigset_t blocked;
-
-        sigemptyset(&blocked);
-        sigaddset(&blocked, PAL_TIMER_SIGNAL);
-
-        // Make PAL_TIMER_SIGNAL blocked from this thread and the others
-        // created onwards. Note: there is no handler for that on purpose, as
-        // the signal is handled by the timer thread itself by sigwaitinfo().
-        int err = pthread_sigmask(SIG_BLOCK, &blocked, NULL);
-
-        if (err != 0) {
+    // Setup the timer thread which will be shared with all the timers
 
-            status = PAL_ERR_SYSCALL_FAILED;
-        }
-    }
+    status = pal_osMutexCreate(&g_timerHeapMutex);
 
     if (status == PAL_SUCCESS) {
 
@@ -176,7 +166,7 @@ palStatus_t pal_plat_RTOSDestroy(void)
     }
 
     if (ret == PAL_SUCCESS) {
-        ret = pal_osMutexDelete(&g_timerListMutex);
+        ret = pal_osMutexDelete(&g_timerHeapMutex);
     }
 
     return ret;
@@ -379,7 +369,7 @@ typedef struct palTimerThreadContext
 
     // If set, the timer thread will stop its loop, signal the startStopSemaphore
     // and run out of thread function. This is set and accessed while holding the
-    // g_timerListMutex.
+    // g_timerHeapMutex.
     volatile bool threadStopRequested;
 
 } palTimerThreadContext_t;
@@ -388,91 +378,154 @@ typedef struct palTimerThreadContext
 static palThreadID_t s_palHighResTimerThreadID = NULLPTR;
 static palTimerThreadContext_t s_palTimerThreadContext = {0};
 
+PAL_PRIVATE uint64_t monotonicNanos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * PAL_NANO_PER_SECOND + ts.tv_nsec;
+}
+
 /*
-* Thread for handling the signals from all timers by calling the attached callback
+* Arm the timerfd to the expiry of the first timer on the heap, or disarm it if the heap is empty.
+* Must be called while holding the g_timerHeapMutex.
 */
-
-PAL_PRIVATE void palTimerThread(void const *args)
+PAL_PRIVATE void updateTimerFD(void)
 {
-    palTimerThreadContext_t* context = (palTimerThreadContext_t*)args;
+    struct itimerspec its;
 
-    int err = 0;
+    memset(&its, 0, sizeof(its));
+    if (g_timerHeapCount > 0) {
+        its.it_value.tv_sec = g_timerHeap[0]->expiry / PAL_NANO_PER_SECOND;
+        its.it_value.tv_nsec = g_timerHeap[0]->expiry % PAL_NANO_PER_SECOND;
+    }
 
-    sigset_t signal_set_to_wait;
+    if (-1 == timerfd_settime(g_timerFD, TFD_TIMER_ABSTIME, &its, NULL)) {
+        PAL_LOG(ERR, "updateTimerFD: timerfd_settime failed with %d\n", errno);
+    }
+}
 
-    sigemptyset(&signal_set_to_wait);
-    sigaddset(&signal_set_to_wait, PAL_TIMER_SIGNAL);
+PAL_PRIVATE void timerHeapSet(uint32_t index, struct palTimerInfo *timer)
+{
+    g_timerHeap[index] = timer;
+    timer->heapIndex = (int32_t)index;
+}
 
-    // signal the caller that thread has started
-    pal_osSemaphoreRelease(context->startStopSemaphore);
+PAL_PRIVATE void timerHeapSiftUp(uint32_t index)
+{
+    struct palTimerInfo *timer = g_timerHeap[index];
 
-    // loop until signaled with threadStopRequested
-    while (1) {
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (g_timerHeap[parent]->expiry <= timer->expiry) {
+            break;
+        }
+        timerHeapSet(index, g_timerHeap[parent]);
+        index = parent;
+    }
+    timerHeapSet(index, timer);
+}
 
-        siginfo_t info;
+PAL_PRIVATE void timerHeapSiftDown(uint32_t index)
+{
+    struct palTimerInfo *timer = g_timerHeap[index];
 
-        // wait for signal from a timer
-        err = sigwaitinfo(&signal_set_to_wait, &info);
+    while (1) {
+        uint32_t child = 2 * index + 1;
+        if (child >= g_timerHeapCount) {
+            break;
+        }
+        if ((child + 1 < g_timerHeapCount) && (g_timerHeap[child + 1]->expiry < g_timerHeap[child]->expiry)) {
+            child++;
+        }
+        if (timer->expiry <= g_timerHeap[child]->expiry) {
+            break;
+        }
+        timerHeapSet(index, g_timerHeap[child]);
+        index = child;
+    }
+    timerHeapSet(index, timer);
+}
 
-        // A positive return value is the signal number, negative value is a sign of some
-        // signal handler interrupting the OS call and errno should be then EINTR.
-        // The other two documented errors, EAGAIN or EINVAL should not happen as we're
-        // not using the timeout, but have them logged just in case.
-        if (err <= 0) {
-            if (errno != EINTR) {
-                PAL_LOG(ERR, "palTimerThread: sigwaitinfo failed with %d\n", errno);
-            }
-        } else {
+// Must be called while holding the g_timerHeapMutex.
+PAL_PRIVATE void timerHeapRemove(struct palTimerInfo *timer)
+{
+    uint32_t index = (uint32_t)timer->heapIndex;
+    struct palTimerInfo *last = g_timerHeap[--g_timerHeapCount];
+
+    timer->heapIndex = PAL_TIMER_NOT_RUNNING;
+    if (last != timer) {
+        timerHeapSet(index, last);
+        timerHeapSiftUp(index);
+        timerHeapSiftDown((uint32_t)last->heapIndex);
+    }
+}
 
-            // before using the timer list or threadStopRequested flag, we need to claim the mutex
-            pal_osMutexWait(g_timerListMutex, PAL_RTOS_WAIT_FOREVER);
+/*
+* Thread for handling the expirations of all timers by calling the attached callback
+*/
 
-            if (context->threadStopRequested) {
+PAL_PRIVATE void palTimerThread(void const *args)
+{
+    palTimerThreadContext_t* context = (palTimerThreadContext_t*)args;
+    bool stop = false;
 
-                // release mutex and bail out
-                pal_osMutexRelease(g_timerListMutex);
-                break;
+    // signal the caller that thread has started
+    pal_osSemaphoreRelease(context->startStopSemaphore);
 
-            } else {
+    // loop until signaled with threadStopRequested
+    while (!stop) {
 
-                // the sival_ptr contains the pointer of timer which caused it
-                struct palTimerInfo* signal_timer = (struct palTimerInfo*)info.si_value.sival_ptr;
+        uint64_t expirations;
 
-                struct palTimerInfo *temp_timer = (struct palTimerInfo*)g_timerList;
+        // wait for the first timer to expire, the timerfd is re-armed whenever the first timer changes
+        if (read(g_timerFD, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            if (errno != EINTR) {
+                PAL_LOG(ERR, "palTimerThread: read failed with %d\n", errno);
+            }
+            continue;
+        }
 
-                palTimerFuncPtr found_function = NULL;
-                void *found_funcArgs;
+        // before using the timer heap or threadStopRequested flag, we need to claim the mutex
+        pal_osMutexWait(g_timerHeapMutex, PAL_RTOS_WAIT_FOREVER);
 
-                // Check, if the timer still is on the list. It may have been deleted, if the
-                // signal delivery / client callback has taken some time.
-                while (temp_timer != NULL) {
+        // timers which expire while the callbacks are run are left for the next round
+        uint64_t now = monotonicNanos();
 
-                    if (temp_timer == signal_timer) {
+        while (!context->threadStopRequested && (g_timerHeapCount > 0) && (g_timerHeap[0]->expiry <= now)) {
 
-                        // Ok, found the timer from list, backup the parameters as we release
-                        // the mutex after this loop, before calling the callback and the
-                        // temp_timer may very well get deleted just after the mutex is released.
+            struct palTimerInfo *timer = g_timerHeap[0];
 
-                        found_function = temp_timer->function;
-                        found_funcArgs = temp_timer->funcArgs;
+            // Backup the parameters as we release the mutex before calling the callback and
+            // the timer may very well get deleted just after the mutex is released.
+            palTimerFuncPtr function = timer->function;
+            void *funcArgs = timer->funcArgs;
 
-                        break;
-                    } else {
-                        temp_timer = temp_timer->next;
-                    }
+            if (timer->period) {
+                // skip the missed periods instead of calling the callback for each of them
+                timer->expiry += timer->period;
+                if (timer->expiry <= now) {
+                    timer->expiry = now + timer->period;
                 }
+                timerHeapSiftDown(0);
+            } else {
+                timerHeapRemove(timer);
+            }
 
-                // Release the list mutex before callback to avoid callback deadlocking other threads
-                // if they try to create a timer.
-                pal_osMutexRelease(g_timerListMutex);
+            // Release the heap mutex before callback to avoid callback deadlocking other threads
+            // if they try to create or start a timer.
+            pal_osMutexRelease(g_timerHeapMutex);
 
-                // the function may be NULL here if the timer was already freed
-                if (found_function) {
-                    // finally call the callback function
-                    found_function(found_funcArgs);
-                }
-            }
+            function(funcArgs);
+
+            pal_osMutexWait(g_timerHeapMutex, PAL_RTOS_WAIT_FOREVER);
+        }
+
+        stop = context->threadStopRequested;
+        if (!stop) {
+            updateTimerFD();
         }
+
+        pal_osMutexRelease(g_timerHeapMutex);
     }
 
     // signal the caller that thread is now stopping and it can continue the pal_destroy()
@@ -483,6 +536,11 @@ PAL_PRIVATE palStatus_t startTimerThread()
 {
     palStatus_t status;
 
+    g_timerFD = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (g_timerFD == -1) {
+        return PAL_ERR_SYSCALL_FAILED;
+    }
+
     status = pal_osSemaphoreCreate(0, &s_palTimerThreadContext.startStopSemaphore);
 
     if (status == PAL_SUCCESS) {
@@ -503,6 +561,11 @@ PAL_PRIVATE palStatus_t startTimerThread()
         }
     }
 
+    if (status != PAL_SUCCESS) {
+        close(g_timerFD);
+        g_timerFD = -1;
+    }
+
     return status;
 }
 
@@ -510,29 +573,23 @@ PAL_PRIVATE palStatus_t stopTimerThread()
 {
     palStatus_t status;
 
-    union sigval value;
-    value.sival_ptr = NULL;
-
-    status = pal_osMutexWait(g_timerListMutex, PAL_RTOS_WAIT_FOREVER);
+    status = pal_osMutexWait(g_timerHeapMutex, PAL_RTOS_WAIT_FOREVER);
 
     if (status == PAL_SUCCESS) {
 
         // set the flag to end the thread
         s_palTimerThreadContext.threadStopRequested = true;
 
-        // ping the timer thread that it should start shutdown
-        pthread_t sysThreadID = (pthread_t)s_palHighResTimerThreadID;
-        int err;
+        // ping the timer thread that it should start shutdown by expiring the timerfd right away
+        struct itimerspec its;
+        memset(&its, 0, sizeof(its));
+        its.it_value.tv_nsec = 1;
 
-        do {
+        int err = timerfd_settime(g_timerFD, 0, &its, NULL);
 
-            err = pthread_sigqueue(sysThreadID, PAL_TIMER_SIGNAL, value);
+        pal_osMutexRelease(g_timerHeapMutex);
 
-        } while (err == EAGAIN); // retry (spin, yuck!) if the signal queue is full
-
-        pal_osMutexRelease(g_timerListMutex);
-
-        // pthread_sigqueue() failed, which is a sign of thread being dead, so a wait
+        // timerfd_settime() failed, so the thread would never wake up and a wait
         // on semaphore would cause a deadlock.
         if (err == 0) {
 
@@ -544,6 +601,16 @@ PAL_PRIVATE palStatus_t stopTimerThread()
 
         // and clean up the thread
         status = pal_osThreadTerminate(&s_palHighResTimerThreadID);
+
+        close(g_timerFD);
+        g_timerFD = -1;
+
+        // the timers which were not deleted by their owners are left as they are, only the heap goes
+        free(g_timerHeap);
+        g_timerHeap = NULL;
+        g_timerHeapCount = 0;
+        g_timerHeapSize = 0;
+        g_timerCount = 0;
     }
     return status;
 }
@@ -565,9 +632,6 @@ palStatus_t pal_plat_osTimerCreate(palTimerFuncPtr function, void* funcArgument,
     palStatus_t status = PAL_SUCCESS;
     struct palTimerInfo* timerInfo = NULL;
     {
-        struct sigevent sig;
-        timer_t localTimer;
-
         if ((NULL == timerID) || (NULL == (void*) function))
         {
             return PAL_ERR_INVALID_ARGUMENT;
@@ -583,45 +647,35 @@ palStatus_t pal_plat_osTimerCreate(palTimerFuncPtr function, void* funcArgument,
         timerInfo->function = function;
         timerInfo->funcArgs = funcArgument;
         timerInfo->timerType = timerType;
+        timerInfo->expiry = 0;
+        timerInfo->period = 0;
+        timerInfo->heapIndex = PAL_TIMER_NOT_RUNNING;
 
-        memset(&sig, 0, sizeof(sig));
-
-        sig.sigev_notify = SIGEV_SIGNAL;
-        sig.sigev_signo = PAL_TIMER_SIGNAL;
-
-        // the signal handler uses this to find the correct timer context
-        sig.sigev_value.sival_ptr = timerInfo;
+        pal_osMutexWait(g_timerHeapMutex, PAL_RTOS_WAIT_FOREVER);
 
-        int ret = timer_create(CLOCK_MONOTONIC, &sig, &localTimer);
-        if (-1 == ret)
+        // make room on the heap for the new timer, so pal_plat_osTimerStart() never needs to allocate
+        if (g_timerCount == g_timerHeapSize)
         {
-            if (EINVAL == errno)
+            uint32_t newSize = (g_timerHeapSize > 0) ? (g_timerHeapSize * 2) : PAL_TIMER_HEAP_INITIAL_SIZE;
+            struct palTimerInfo **newHeap = (struct palTimerInfo **) realloc(g_timerHeap, newSize * sizeof(struct palTimerInfo *));
+            if (NULL == newHeap)
             {
-                status = PAL_ERR_INVALID_ARGUMENT;
-                goto finish;
+                status = PAL_ERR_NO_MEMORY;
             }
-            if (ENOMEM == errno)
+            else
             {
-                status = PAL_ERR_NO_MEMORY;
-                goto finish;
+                g_timerHeap = newHeap;
+                g_timerHeapSize = newSize;
             }
-            PAL_LOG(ERR, "Rtos timer create error %d", ret);
-            status = PAL_ERR_GENERIC_FAILURE;
-            goto finish;
         }
 
-        // managed to create the timer - finish up
-        timerInfo->handle = localTimer;
-        *timerID = (palTimerID_t) timerInfo;
-
-        pal_osMutexWait(g_timerListMutex, PAL_RTOS_WAIT_FOREVER);
-
-        // add the new timer to head of the singly linked list
-        timerInfo->next = (struct palTimerInfo *)g_timerList;
-
-        g_timerList = timerInfo;
+        if (PAL_SUCCESS == status)
+        {
+            g_timerCount++;
+            *timerID = (palTimerID_t) timerInfo;
+        }
 
-        pal_osMutexRelease(g_timerListMutex);
+        pal_osMutexRelease(g_timerHeapMutex);
     }
     finish: if (PAL_SUCCESS != status)
     {
@@ -634,14 +688,6 @@ palStatus_t pal_plat_osTimerCreate(palTimerFuncPtr function, void* funcArgument,
     return status;
 }
 
-/* Convert milliseconds into seconds and nanoseconds inside a timespec struct
- */
-PAL_PRIVATE void convertMilli2Timespec(uint32_t millisec, struct timespec* ts)
-{
-    ts->tv_sec = millisec / 1000;
-    ts->tv_nsec = PAL_MILLI_TO_NANO(millisec);
-}
-
 /*! Start or restart a timer.
  *
  * @param[in] timerID The handle for the timer to start.
@@ -658,24 +704,36 @@ palStatus_t pal_plat_osTimerStart(palTimerID_t timerID, uint32_t millisec)
     }
 
     struct palTimerInfo* timerInfo = (struct palTimerInfo *) timerID;
-    struct itimerspec its;
+    uint64_t interval = (uint64_t)millisec * PAL_NANO_PER_MILLI;
+
+    pal_osMutexWait(g_timerHeapMutex, PAL_RTOS_WAIT_FOREVER);
 
-    convertMilli2Timespec(millisec, &(its.it_value));
+    const struct palTimerInfo *first = (g_timerHeapCount > 0) ? g_timerHeap[0] : NULL;
+    uint64_t firstExpiry = first ? first->expiry : 0;
 
-    if (palOsTimerPeriodic == timerInfo->timerType)
+    timerInfo->expiry = monotonicNanos() + interval;
+    timerInfo->period = (palOsTimerPeriodic == timerInfo->timerType) ? interval : 0;
+
+    if (PAL_TIMER_NOT_RUNNING == timerInfo->heapIndex)
     {
-        convertMilli2Timespec(millisec, &(its.it_interval));
+        timerHeapSet(g_timerHeapCount++, timerInfo);
+        timerHeapSiftUp((uint32_t)timerInfo->heapIndex);
     }
     else
-    {  // one time timer
-        convertMilli2Timespec(0, &(its.it_interval));
+    {
+        // restarting a running timer, it may move either way
+        timerHeapSiftUp((uint32_t)timerInfo->heapIndex);
+        timerHeapSiftDown((uint32_t)timerInfo->heapIndex);
     }
 
-    if (-1 == timer_settime(timerInfo->handle, 0, &its, NULL))
+    // the timerfd needs to be re-armed only if the first expiry changed
+    if ((g_timerHeap[0] != first) || (g_timerHeap[0]->expiry != firstExpiry))
     {
-        status = PAL_ERR_INVALID_ARGUMENT;
+        updateTimerFD();
     }
 
+    pal_osMutexRelease(g_timerHeapMutex);
+
     return status;
 }
 
@@ -694,18 +752,22 @@ palStatus_t pal_plat_osTimerStop(palTimerID_t timerID)
     }
 
     struct palTimerInfo* timerInfo = (struct palTimerInfo *) timerID;
-    struct itimerspec its;
 
-    // set timer to 0 to disarm it.
-    convertMilli2Timespec(0, &(its.it_value));
+    pal_osMutexWait(g_timerHeapMutex, PAL_RTOS_WAIT_FOREVER);
 
-    convertMilli2Timespec(0, &(its.it_interval));
-
-    if (-1 == timer_settime(timerInfo->handle, 0, &its, NULL))
+    if (PAL_TIMER_NOT_RUNNING != timerInfo->heapIndex)
     {
-        status = PAL_ERR_INVALID_ARGUMENT;
+        bool wasFirst = (0 == timerInfo->heapIndex);
+
+        timerHeapRemove(timerInfo);
+        if (wasFirst)
+        {
+            updateTimerFD();
+        }
     }
 
+    pal_osMutexRelease(g_timerHeapMutex);
+
     return status;
 }
 
@@ -726,44 +788,26 @@ palStatus_t pal_plat_osTimerDelete(palTimerID_t* timerID)
 
     if (NULL == timerInfo)
     {
-        status = PAL_ERR_RTOS_PARAMETER;
+        return PAL_ERR_RTOS_PARAMETER;
     }
 
-    // the list of timers is protected by a mutex to avoid concurrency issues
-    pal_osMutexWait(g_timerListMutex, PAL_RTOS_WAIT_FOREVER);
-
-    // remove the timer from the list before freeing it
-    struct palTimerInfo *prev_timer = NULL;
-    struct palTimerInfo *temp_timer = (struct palTimerInfo *)g_timerList;
-
-    while (temp_timer) {
+    // the heap of timers is protected by a mutex to avoid concurrency issues
+    pal_osMutexWait(g_timerHeapMutex, PAL_RTOS_WAIT_FOREVER);
 
-        if (temp_timer == timerInfo) {
-            // found the timer from list, now it needs to be removed from there
-
-            if (prev_timer) {
-                // there was a previous item, so update its next to this objects next
-                prev_timer->next = temp_timer->next;
-            } else {
-                // the item was the first/only one, so update the list head instead
-                g_timerList = temp_timer->next;
-            }
-            // all done now
-            break;
+    // remove the timer from the heap before freeing it
+    if (PAL_TIMER_NOT_RUNNING != timerInfo->heapIndex)
+    {
+        bool wasFirst = (0 == timerInfo->heapIndex);
 
-        } else {
-            prev_timer = temp_timer;
-            temp_timer = temp_timer->next;
+        timerHeapRemove(timerInfo);
+        if (wasFirst)
+        {
+            updateTimerFD();
         }
     }
+    g_timerCount--;
 
-    timer_t lt = timerInfo->handle;
-    if (-1 == timer_delete(lt))
-    {
-        status = PAL_ERR_RTOS_RESOURCE;
-    }
-
-    pal_osMutexRelease(g_timerListMutex);
+    pal_osMutexRelease(g_timerHeapMutex);
 
     free(timerInfo);
     *timerID = (palTimerID_t) NULL;
@@ -66,6 +66,9 @@ PAL_PRIVATE palSocket_t g_testSockets[PAL_NET_TEST_SOCKETS] = {0,0,0,0};
 #define PAL_NET_TEST_BUFFERED_UDP_BUF_SIZE_LARGE 512
 #define PAL_NET_TEST_BUFFERED_UDP_PORT 2606
 #define PAL_NET_TEST_BUFFERED_UDP_MESSAGE_SIZE (1024 * 256)
+#define PAL_NET_TEST_BATCH_UDP_PORT 2607
+#define PAL_NET_TEST_BATCH_UDP_COUNT 20
+#define PAL_NET_TEST_BATCH_RECEIVE_UDP_PORT 2608
 PAL_PRIVATE uint8_t *g_testRecvBuffer = NULLPTR;
 PAL_PRIVATE uint8_t *g_testSendBuffer = NULLPTR;
 
@@ -374,6 +377,185 @@ end:
 }
 
 
+/*! \brief Test sending several UDP datagrams with one call.
+*
+** \test
+* | # |    Step                        |   Expected  |
+* |---|--------------------------------|-------------|
+* | 1 | Get the interface address using `pal_getNetInterfaceInfo` and set a test port to it.    | PAL_SUCCESS |
+* | 2 | Create a blocking UDP socket and bind it to the interface address using `pal_bind`.     | PAL_SUCCESS |
+* | 3 | Create a blocking UDP socket for sending.                                               | PAL_SUCCESS |
+* | 4 | Send datagrams of different lengths to the bound socket using `pal_sendToBatch`.        | PAL_SUCCESS |
+* | 5 | Receive the datagrams using `pal_receiveFrom` and check their order and contents.       | PAL_SUCCESS |
+* | 6 | Close the sockets.                                                                      | PAL_SUCCESS |
+*/
+TEST(pal_socket, socketUDPSendToBatch)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palNetInterfaceInfo_t interfaceInfo;
+    palSocketAddress_t from = { 0 };
+    palSocketLength_t fromLength = sizeof(from);
+    palSocketBuffer_t buffers[PAL_NET_TEST_BATCH_UDP_COUNT];
+    uint8_t payload[PAL_NET_TEST_BATCH_UDP_COUNT];
+    uint8_t buffer_in[PAL_NET_TEST_BATCH_UDP_COUNT + 1];
+    int timeout = 5000;
+    uint32_t sentCount = 0;
+    uint32_t total = 0;
+    size_t read = 0;
+    uint32_t i = 0;
+
+    /*#1*/
+    memset(&interfaceInfo, 0, sizeof(interfaceInfo));
+    result = pal_getNetInterfaceInfo(0, &interfaceInfo);
+    if ((PAL_ERR_SOCKET_DNS_ERROR == result) || (PAL_ERR_SOCKET_INVALID_ADDRESS_FAMILY == result))
+    {
+        PAL_LOG(ERR, "error: address lookup returned an address not supported by current configuration can't continue test ( IPv6 add for IPv4 only configuration or IPv4 for IPv6 only configuration)");
+        return;
+    }
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+    result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_BATCH_UDP_PORT);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+
+    /*#2*/
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &g_testSockets[0]);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+    result = pal_setSocketOptions(g_testSockets[0], PAL_SO_RCVTIMEO, &timeout, sizeof(timeout));
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+    result = pal_bind(g_testSockets[0], &interfaceInfo.address, interfaceInfo.addressSize);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+
+    /*#3*/
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &g_testSockets[1]);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+
+    /*#4*/
+    for (i = 0; i < PAL_NET_TEST_BATCH_UDP_COUNT; i++)
+    {
+        payload[i] = (uint8_t)i;
+        buffers[i].buffer = payload;
+        buffers[i].length = i + 1; // the length of each datagram tells its position
+    }
+    while (total < PAL_NET_TEST_BATCH_UDP_COUNT)
+    {
+        result = pal_sendToBatch(g_testSockets[1], &buffers[total], PAL_NET_TEST_BATCH_UDP_COUNT - total, &interfaceInfo.address, interfaceInfo.addressSize, &sentCount);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+        TEST_ASSERT_TRUE(sentCount > 0);
+        total += sentCount;
+    }
+
+    /*#5*/
+    for (i = 0; i < PAL_NET_TEST_BATCH_UDP_COUNT; i++)
+    {
+        result = pal_receiveFrom(g_testSockets[0], buffer_in, sizeof(buffer_in), &from, &fromLength, &read);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+        TEST_ASSERT_EQUAL(i + 1, read);
+        TEST_ASSERT_EQUAL_MEMORY(payload, buffer_in, read);
+    }
+
+    /*#6*/
+    result = pal_close(&g_testSockets[1]);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+    result = pal_close(&g_testSockets[0]);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+}
+
+
+/*! \brief Test receiving several UDP datagrams with one call.
+*
+** \test
+* | # |    Step                        |   Expected  |
+* |---|--------------------------------|-------------|
+* | 1 | Get the interface address using `pal_getNetInterfaceInfo` and set a test port to it.    | PAL_SUCCESS |
+* | 2 | Create a blocking UDP socket and bind it to the interface address using `pal_bind`.     | PAL_SUCCESS |
+* | 3 | Create a blocking UDP socket for sending.                                               | PAL_SUCCESS |
+* | 4 | Send datagrams of different lengths to the bound socket using `pal_sendTo`.             | PAL_SUCCESS |
+* | 5 | Receive the datagrams using `pal_receiveFromBatch` and check their order, contents and source port. | PAL_SUCCESS |
+* | 6 | Close the sockets.                                                                      | PAL_SUCCESS |
+*/
+TEST(pal_socket, socketUDPReceiveFromBatch)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palNetInterfaceInfo_t interfaceInfo;
+    palSocketAddress_t from[PAL_NET_TEST_BATCH_UDP_COUNT];
+    palSocketLength_t fromLength[PAL_NET_TEST_BATCH_UDP_COUNT];
+    palSocketBuffer_t buffers[PAL_NET_TEST_BATCH_UDP_COUNT];
+    size_t read[PAL_NET_TEST_BATCH_UDP_COUNT];
+    uint8_t payload[PAL_NET_TEST_BATCH_UDP_COUNT];
+    uint8_t buffer_in[PAL_NET_TEST_BATCH_UDP_COUNT][PAL_NET_TEST_BATCH_UDP_COUNT + 1];
+    int timeout = 5000;
+    uint32_t receivedCount = 0;
+    uint32_t total = 0;
+    size_t sent = 0;
+    uint16_t port = 0;
+    uint32_t i = 0;
+
+    /*#1*/
+    memset(&interfaceInfo, 0, sizeof(interfaceInfo));
+    result = pal_getNetInterfaceInfo(0, &interfaceInfo);
+    if ((PAL_ERR_SOCKET_DNS_ERROR == result) || (PAL_ERR_SOCKET_INVALID_ADDRESS_FAMILY == result))
+    {
+        PAL_LOG(ERR, "error: address lookup returned an address not supported by current configuration can't continue test ( IPv6 add for IPv4 only configuration or IPv4 for IPv6 only configuration)");
+        return;
+    }
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+    result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_BATCH_RECEIVE_UDP_PORT);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+
+    /*#2*/
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &g_testSockets[0]);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+    result = pal_setSocketOptions(g_testSockets[0], PAL_SO_RCVTIMEO, &timeout, sizeof(timeout));
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+    result = pal_bind(g_testSockets[0], &interfaceInfo.address, interfaceInfo.addressSize);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+
+    /*#3*/
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &g_testSockets[1]);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+
+    /*#4*/
+    for (i = 0; i < PAL_NET_TEST_BATCH_UDP_COUNT; i++)
+    {
+        payload[i] = (uint8_t)i;
+    }
+    for (i = 0; i < PAL_NET_TEST_BATCH_UDP_COUNT; i++)
+    {
+        // the length of each datagram tells its position
+        result = pal_sendTo(g_testSockets[1], payload, i + 1, &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+        TEST_ASSERT_EQUAL(i + 1, sent);
+    }
+
+    /*#5*/
+    for (i = 0; i < PAL_NET_TEST_BATCH_UDP_COUNT; i++)
+    {
+        buffers[i].buffer = buffer_in[i];
+        buffers[i].length = sizeof(buffer_in[i]);
+        fromLength[i] = sizeof(from[i]);
+    }
+    while (total < PAL_NET_TEST_BATCH_UDP_COUNT)
+    {
+        result = pal_receiveFromBatch(g_testSockets[0], &buffers[total], &read[total], PAL_NET_TEST_BATCH_UDP_COUNT - total, &from[total], &fromLength[total], &receivedCount);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+        TEST_ASSERT_TRUE(receivedCount > 0);
+        total += receivedCount;
+    }
+    TEST_ASSERT_EQUAL(PAL_NET_TEST_BATCH_UDP_COUNT, total);
+    for (i = 0; i < PAL_NET_TEST_BATCH_UDP_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(i + 1, read[i]);
+        TEST_ASSERT_EQUAL_MEMORY(payload, buffer_in[i], read[i]);
+        result = pal_getSockAddrPort(&from[i], &port);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+        TEST_ASSERT_NOT_EQUAL(0, port);
+    }
+
+    /*#6*/
+    result = pal_close(&g_testSockets[1]);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+    result = pal_close(&g_testSockets[0]);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, result);
+}
 
 
 // This is an example showing how to check for a socket that has been closed remotely.
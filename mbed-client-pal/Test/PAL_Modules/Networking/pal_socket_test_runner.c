@@ -25,6 +25,8 @@ TEST_GROUP_RUNNER(pal_socket)
     RUN_TEST_CASE(pal_socket, socketUDPCreationOptionsTest);
     RUN_TEST_CASE(pal_socket, basicTCPclientSendRecieve);
     RUN_TEST_CASE(pal_socket, basicUDPclientSendRecieve);
+    RUN_TEST_CASE(pal_socket, socketUDPSendToBatch);
+    RUN_TEST_CASE(pal_socket, socketUDPReceiveFromBatch);
     RUN_TEST_CASE(pal_socket, basicSocketScenario3);
     RUN_TEST_CASE(pal_socket, tProvUDPTest);
     RUN_TEST_CASE(pal_socket, nonBlockingAsyncTest);
@@ -41,6 +41,13 @@ palRecursiveMutexParam_t* recursiveMutexData = NULL;
 #define PAL_TEST_PERCENTAGE_LOW 95
 #define PAL_TEST_PERCENTAGE_HIGH 105
 #define PAL_TEST_PERCENTAGE_HUNDRED  100
+#ifndef PAL_TEST_TIMER_BENCHMARK_COUNT
+#define PAL_TEST_TIMER_BENCHMARK_COUNT 1000
+#endif
+#define PAL_TEST_TIMER_BENCHMARK_MIN_MS 100
+#define PAL_TEST_TIMER_BENCHMARK_STEP_MS 10
+#define PAL_TEST_TIMER_BENCHMARK_STEPS 100
+#define PAL_TEST_TIMER_BENCHMARK_MAX_LATENCY_MS 100
 
 //Forward declarations
 void palRunThreads(void);
@@ -420,6 +427,90 @@ TEST(pal_rtos, TimerUnityTest)
     TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
 }
 
+/*! \brief Measures the latency and jitter of many concurrent one-shot timers.
+* Timers expire spread over about a second, each callback records the tick it was called at.
+* Latency is the delay from the requested expiration to the callback, jitter is the mean
+* absolute deviation of the latency.
+*
+* | # |    Step                        |   Expected  |
+* |---|--------------------------------|-------------|
+* | 1 | Create `PAL_TEST_TIMER_BENCHMARK_COUNT` one-shot timers using `pal_osTimerCreate`.      | PAL_SUCCESS |
+* | 2 | Start the timers with timeouts spread between 100 and 1090 ms using `pal_osTimerStart`. | PAL_SUCCESS |
+* | 3 | Sleep until all the timers should have expired.                                           | PAL_SUCCESS |
+* | 4 | Check that every timer fired, not before its timeout, and within the maximum latency.     | PAL_SUCCESS |
+* | 5 | Delete the timers using `pal_osTimerDelete`.                                              | PAL_SUCCESS |
+*/
+TEST(pal_rtos, TimerLatencyBenchmark)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palTimerID_t* timerIDs = NULL;
+    timerBenchmarkArgument_t* timerArgs = NULL;
+    uint64_t latency = 0;
+    uint64_t totalLatency = 0;
+    uint64_t maxLatency = 0;
+    uint64_t averageLatency = 0;
+    uint64_t totalDeviation = 0;
+    uint32_t i = 0;
+
+    timerIDs = (palTimerID_t*)calloc(PAL_TEST_TIMER_BENCHMARK_COUNT, sizeof(palTimerID_t));
+    timerArgs = (timerBenchmarkArgument_t*)calloc(PAL_TEST_TIMER_BENCHMARK_COUNT, sizeof(timerBenchmarkArgument_t));
+    TEST_ASSERT_NOT_NULL(timerIDs);
+    TEST_ASSERT_NOT_NULL(timerArgs);
+
+    /*#1*/
+    for (i = 0; i < PAL_TEST_TIMER_BENCHMARK_COUNT; i++)
+    {
+        status = pal_osTimerCreate(palTimerBenchmarkFunc, &timerArgs[i], palOsTimerOnce, &timerIDs[i]);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    }
+
+    /*#2*/
+    for (i = 0; i < PAL_TEST_TIMER_BENCHMARK_COUNT; i++)
+    {
+        uint32_t timeout = PAL_TEST_TIMER_BENCHMARK_MIN_MS + (i % PAL_TEST_TIMER_BENCHMARK_STEPS) * PAL_TEST_TIMER_BENCHMARK_STEP_MS;
+        timerArgs[i].expectedTick = pal_osKernelSysTick() + pal_osKernelSysTickMicroSec((uint64_t)timeout * 1000);
+        status = pal_osTimerStart(timerIDs[i], timeout);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    }
+
+    /*#3*/
+    status = pal_osDelay(PAL_TEST_TIMER_BENCHMARK_MIN_MS + PAL_TEST_TIMER_BENCHMARK_STEPS * PAL_TEST_TIMER_BENCHMARK_STEP_MS + PAL_TIME_TO_WAIT_SHORT_MS);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+
+    /*#4*/
+    for (i = 0; i < PAL_TEST_TIMER_BENCHMARK_COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(timerArgs[i].firedTick >= timerArgs[i].expectedTick);
+        latency = timerArgs[i].firedTick - timerArgs[i].expectedTick;
+        totalLatency += latency;
+        if (latency > maxLatency)
+        {
+            maxLatency = latency;
+        }
+    }
+    averageLatency = totalLatency / PAL_TEST_TIMER_BENCHMARK_COUNT;
+    for (i = 0; i < PAL_TEST_TIMER_BENCHMARK_COUNT; i++)
+    {
+        latency = timerArgs[i].firedTick - timerArgs[i].expectedTick;
+        totalDeviation += (latency > averageLatency) ? (latency - averageLatency) : (averageLatency - latency);
+    }
+    PAL_PRINTF("%d timers: average latency %" PRIu64 " us, max latency %" PRIu64 " us, jitter %" PRIu64 " us\n",
+               PAL_TEST_TIMER_BENCHMARK_COUNT,
+               (averageLatency * 1000000) / pal_osKernelSysTickFrequency(),
+               (maxLatency * 1000000) / pal_osKernelSysTickFrequency(),
+               ((totalDeviation / PAL_TEST_TIMER_BENCHMARK_COUNT) * 1000000) / pal_osKernelSysTickFrequency());
+    TEST_ASSERT_TRUE(pal_osKernelSysMilliSecTick(maxLatency) < PAL_TEST_TIMER_BENCHMARK_MAX_LATENCY_MS);
+
+    /*#5*/
+    for (i = 0; i < PAL_TEST_TIMER_BENCHMARK_COUNT; i++)
+    {
+        status = pal_osTimerDelete(&timerIDs[i]);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    }
+    free(timerIDs);
+    free(timerArgs);
+}
+
 /*! \brief Creates mutexes and semaphores and uses them to communicate between
 * the different threads it creates (as defined in `pal_rtos_test_utils.c`).
 * In this test, we check that thread communication is working as expected between the threads and in the designed order.
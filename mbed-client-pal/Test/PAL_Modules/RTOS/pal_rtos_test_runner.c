@@ -39,6 +39,7 @@ TEST_GROUP_RUNNER(pal_rtos)
 	RUN_TEST_CASE(pal_rtos, pal_osDelay_Unity);
 	RUN_TEST_CASE(pal_rtos, BasicTimeScenario);
 	RUN_TEST_CASE(pal_rtos, TimerUnityTest);
+	RUN_TEST_CASE(pal_rtos, TimerLatencyBenchmark);
 	RUN_TEST_CASE(pal_rtos, AtomicIncrementUnityTest);
 	RUN_TEST_CASE(pal_rtos, GetDeviceKeyTest_CMAC);
 	RUN_TEST_CASE(pal_rtos, GetDeviceKeyTest_HMAC_SHA256);
@@ -215,6 +215,12 @@ void palTimerFunc4(void const *argument)
 	g_timerArgs.ticksInFunc1 = counter;
 }
 
+void palTimerBenchmarkFunc(void const *argument) // function to record the tick of the expiration for timer latency test
+{
+    timerBenchmarkArgument_t *timerArg = (timerBenchmarkArgument_t*)argument;
+    timerArg->firedTick = pal_osKernelSysTick();
+}
+
 void palTimerFunc5(void const *argument) // function to count calls + wait alternatin short and long periods for timer drift test
 {
     static int counter = 0;
@@ -75,6 +75,13 @@ void palTimerFunc3(void const *argument);
 void palTimerFunc4(void const *argument);
 void palTimerFunc5(void const *argument);
 
+typedef struct timerBenchmarkArgument{
+    uint64_t expectedTick;
+    uint64_t firedTick;
+}timerBenchmarkArgument_t;
+
+void palTimerBenchmarkFunc(void const *argument);
+
 
 void palThreadFuncWaitForEverTest(void const *argument);
 
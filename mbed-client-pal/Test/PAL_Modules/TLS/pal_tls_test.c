@@ -565,6 +565,120 @@ TEST(pal_tls, tlsHandshakeTCP_nonBlocking)
     handshakeTCP(true);
 }
 
+static void resumableHandshakeTCP(const uint8_t* session, uint32_t sessionLen, uint8_t* sessionOut, uint32_t* sessionOutLen, bool* resumed)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palTLSConfHandle_t palTLSConf = NULLPTR;
+    palTLSHandle_t palTLSHandle = NULLPTR;
+    palTLSTransportMode_t transportationMode = PAL_TLS_MODE;
+    palSocketAddress_t socketAddr = {0};
+    palSocketLength_t addressLength = 0;
+    #if (PAL_ENABLE_X509 == 1)
+        palX509_t pubKey = {(const void*)g_pubKey,sizeof(g_pubKey)};
+        palPrivateKey_t prvKey = {(const void*)g_prvKey,sizeof(g_prvKey)};
+        palX509_t caCert = { (const void*)pal_test_cas,sizeof(pal_test_cas) };
+    #elif (PAL_ENABLE_PSK == 1)
+        const char* identity = PAL_TEST_PSK_IDENTITY;
+        const char psk[]= PAL_TEST_PSK;
+    #endif
+    palTLSSocket_t tlsSocket = { g_socket, &socketAddr, 0, transportationMode };
+
+    status = pal_socket(PAL_AF_INET, PAL_SOCK_STREAM, false, 0, &g_socket);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_getAddressInfo(PAL_TLS_TEST_SERVER_ADDRESS, &socketAddr, &addressLength);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    tlsSocket.addressLength = addressLength;
+    tlsSocket.socket = g_socket;
+    status = pal_setSockAddrPort(&socketAddr, TLS_SERVER_PORT);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_connect(g_socket, &socketAddr, addressLength);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+
+    status = pal_initTLSConfiguration(&palTLSConf, transportationMode);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_initTLS(palTLSConf, &palTLSHandle);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    #if (PAL_ENABLE_X509 == 1)
+        status = pal_setOwnCertAndPrivateKey(palTLSConf, &pubKey, &prvKey);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+        status = pal_setCAChain(palTLSConf, &caCert, NULL);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    #elif (PAL_ENABLE_PSK == 1)
+        status = pal_setPSK(palTLSConf, (const unsigned char*)identity, strlen(identity), (const unsigned char*)psk, sizeof(psk));
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    #endif
+    status = pal_tlsSetSocket(palTLSConf, &tlsSocket);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+
+    status = pal_sslGetSession(palTLSHandle, sessionOut, PAL_TLS_SESSION_MAX_SIZE, sessionOutLen);
+    TEST_ASSERT_EQUAL_HEX(PAL_ERR_TLS_CONTEXT_NOT_INITIALIZED, status);
+    if (NULL != session)
+    {
+        status = pal_sslSetSession(palTLSHandle, session, sessionLen);
+        TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    }
+
+    status = pal_handShake(palTLSHandle, palTLSConf);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_sslGetVerifyResult(palTLSHandle);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_sslIsSessionResumed(palTLSHandle, resumed);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_sslGetSession(palTLSHandle, sessionOut, PAL_TLS_SESSION_MAX_SIZE, sessionOutLen);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+
+    status = pal_freeTLS(&palTLSHandle);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_tlsConfigurationFree(&palTLSConf);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_close(&g_socket);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+}
+
+/**
+* @brief Test TLS session export, import and resumption (TCP blocking).
+*
+*
+* | # |    Step                        |   Expected  |
+* |---|--------------------------------|-------------|
+* | 1 | Perform a full TLS handshake with the server.                                  | PAL_SUCCESS |
+* | 2 | Check the session was not resumed using `pal_sslIsSessionResumed`.             | PAL_SUCCESS |
+* | 3 | Export the session using `pal_sslGetSession`.                                  | PAL_SUCCESS |
+* | 4 | Import a truncated session using `pal_sslSetSession`.                          | PAL_ERR_TLS_BAD_INPUT_DATA |
+* | 5 | Perform a TLS handshake on a new connection with the session set using `pal_sslSetSession`. | PAL_SUCCESS |
+* | 6 | Check the session was resumed using `pal_sslIsSessionResumed`.                 | PAL_SUCCESS |
+*/
+TEST(pal_tls, tlsHandshakeTCP_SessionResumption)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palTLSConfHandle_t palTLSConf = NULLPTR;
+    palTLSHandle_t palTLSHandle = NULLPTR;
+    uint8_t session[PAL_TLS_SESSION_MAX_SIZE] = {0};
+    uint8_t resumedSession[PAL_TLS_SESSION_MAX_SIZE] = {0};
+    uint32_t sessionLen = 0;
+    uint32_t resumedSessionLen = 0;
+    bool resumed = true;
+
+    /*#1 + 2 + 3*/
+    resumableHandshakeTCP(NULL, 0, session, &sessionLen, &resumed);
+    TEST_ASSERT_FALSE(resumed);
+    TEST_ASSERT_TRUE(0 < sessionLen);
+    /*#4*/
+    status = pal_initTLSConfiguration(&palTLSConf, PAL_TLS_MODE);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_initTLS(palTLSConf, &palTLSHandle);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_sslSetSession(palTLSHandle, session, sessionLen - 1);
+    TEST_ASSERT_EQUAL_HEX(PAL_ERR_TLS_BAD_INPUT_DATA, status);
+    status = pal_freeTLS(&palTLSHandle);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    status = pal_tlsConfigurationFree(&palTLSConf);
+    TEST_ASSERT_EQUAL_HEX(PAL_SUCCESS, status);
+    /*#5 + 6*/
+    resumableHandshakeTCP(session, sessionLen, resumedSession, &resumedSessionLen, &resumed);
+    TEST_ASSERT_TRUE(resumed);
+}
+
 /**
 * @brief Test (D)TLS handshake (UDP -blocking).
 *
@@ -28,6 +28,7 @@ TEST_GROUP_RUNNER(pal_tls)
     RUN_TEST_CASE(pal_tls, tlsHandshakeUDPTimeOut);
     RUN_TEST_CASE(pal_tls, tlsHandshakeTCP);
     RUN_TEST_CASE(pal_tls, tlsHandshakeTCP_nonBlocking);
+    RUN_TEST_CASE(pal_tls, tlsHandshakeTCP_SessionResumption);
     RUN_TEST_CASE(pal_tls, tlsHandshakeTCP_FutureLWM2M); //Far future LWM2M - should update the time in SOTP
     RUN_TEST_CASE(pal_tls, tlsHandshakeTCP_FutureLWM2M_NoTimeUpdate); // Near future LWM2M - No SOTP time update
     RUN_TEST_CASE(pal_tls, tlsHandshakeTCP_ExpiredLWM2MCert);   // Expired LWM2M - Certificate verification MUST fail
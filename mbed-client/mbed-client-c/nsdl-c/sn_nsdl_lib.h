@@ -215,6 +215,10 @@ typedef struct sn_nsdl_resource_parameters_ {
     bool                                        always_publish:1;  /**< 1 if resource should always be published in registration or registration update **/
     unsigned                                    publish_value:2;    /**< 0 for non-publishing,1 if resource value to be published in registration message,
                                                                          2 if resource value to be published in Base64 encoded format */
+    struct sn_nsdl_resource_parameters_         *hash_next;         /**< Next resource in the same GRS path index bucket, owned by GRS */
+    uint8_t                                     *link_format_ptr;   /**< Cached link-format of the resource for registration message, owned by NSDL */
+    uint16_t                                    link_format_len;    /**< Length of the cached link-format */
+    bool                                        link_format_dirty:1; /**< 1 if cached link-format must be rebuilt */
 } sn_nsdl_dynamic_resource_parameters_s;
 
 
@@ -682,6 +686,16 @@ extern int8_t sn_nsdl_clear_coap_sent_blockwise_messages(struct nsdl_s *handle);
  */
 extern int8_t sn_nsdl_handle_block2_response_internally(struct nsdl_s *handle, uint8_t handle_response);
 
+/**
+ * \fn void sn_nsdl_resource_link_format_changed(sn_nsdl_dynamic_resource_parameters_s *resource)
+ *
+ * \brief Marks the cached link-format of the resource to be rebuilt for the next registration message.
+ * Must be called when the path, attributes or content type of a resource change after it has been added to NSDL.
+ *
+ * \param *resource Pointer to resource dynamic parameters
+ */
+extern void sn_nsdl_resource_link_format_changed(sn_nsdl_dynamic_resource_parameters_s *resource);
+
 #ifdef RESOURCE_ATTRIBUTES_LIST
 /**
  * \fn int8_t sn_nsdl_free_resource_attributes_list(struct nsdl_s *handle, sn_nsdl_static_resource_parameters_s *params)
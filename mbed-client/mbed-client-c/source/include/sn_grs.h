@@ -58,6 +58,14 @@ struct grs_s {
 
     uint16_t resource_root_count;
     resource_list_t resource_root_list;
+
+    /* Path index over resource_root_list. Hash buckets give exact path lookups, the
+     * path-sorted table gives subtree lookups for SN_GRS_DELETE_METHOD. Either table may be
+     * NULL if it could not be allocated, in which case searches fall back to the list. */
+    sn_nsdl_dynamic_resource_parameters_s **resource_hash_table;
+    sn_nsdl_dynamic_resource_parameters_s **resource_sorted_table;
+    uint16_t resource_hash_size;
+    uint16_t resource_sorted_size;
 };
 
 
@@ -36,12 +36,26 @@
 #define WELLKNOWN_PATH_LEN              16
 #define WELLKNOWN_PATH                  (".well-known/core")
 
+/* Path index sizing. Tables are allocated through sn_grs_alloc() which takes a 16 bit size,
+ * so the tables are capped to what fits in one allocation. */
+#define SN_GRS_INDEX_MIN_SIZE           16
+#define SN_GRS_INDEX_MAX_ENTRIES        (0xFFFF / sizeof(sn_nsdl_dynamic_resource_parameters_s *))
+
 /* Local static function prototypes */
 static int8_t                       sn_grs_resource_info_free(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *resource_ptr);
 static char *sn_grs_convert_uri(uint16_t *uri_len, const char *uri_ptr);
 static int8_t                       sn_grs_core_request(struct nsdl_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *coap_packet_ptr);
 static uint8_t                      coap_tx_callback(uint8_t *, uint16_t, sn_nsdl_addr_s *, void *);
 static int8_t                       coap_rx_callback(sn_coap_hdr_s *coap_ptr, sn_nsdl_addr_s *address_ptr, void *param);
+static void                         sn_grs_remove_from_list(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res);
+static void                         sn_grs_link_format_free(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res);
+static uint32_t                     sn_grs_index_hash(const char *path, uint16_t path_len);
+static void                         sn_grs_index_add(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res);
+static void                         sn_grs_index_remove(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res);
+static void                         sn_grs_index_rebuild_hash(struct grs_s *handle, uint16_t size);
+static void                         sn_grs_index_rebuild_sorted(struct grs_s *handle, uint16_t size);
+static uint16_t                     sn_grs_index_sorted_lower_bound(sn_nsdl_dynamic_resource_parameters_s **table, uint16_t count,
+                                                                    const char *prefix, uint16_t prefix_len, bool subtree);
 
 /* Extern function prototypes */
 extern int8_t                       sn_nsdl_build_registration_body(struct nsdl_s *handle, sn_coap_hdr_s *message_ptr, uint8_t updating_registeration);
@@ -59,8 +73,12 @@ extern int8_t sn_grs_destroy(struct grs_s *handle)
     ns_list_foreach_safe(sn_nsdl_dynamic_resource_parameters_s, tmp, &handle->resource_root_list) {
         ns_list_remove(&handle->resource_root_list, tmp);
         --handle->resource_root_count;
+        tmp->hash_next = NULL;
+        sn_grs_link_format_free(handle, tmp);
         sn_grs_resource_info_free(handle, tmp);
     }
+    handle->sn_grs_free(handle->resource_hash_table);
+    handle->sn_grs_free(handle->resource_sorted_table);
     handle->sn_grs_free(handle);
 
     return 0;
@@ -172,8 +190,7 @@ extern int8_t sn_grs_delete_resource(struct grs_s *handle, const char *path)
     /* If found, delete it and delete also subresources, if there is any */
     do {
         /* Remove from list */
-        ns_list_remove(&handle->resource_root_list, resource_temp);
-        --handle->resource_root_count;
+        sn_grs_remove_from_list(handle, resource_temp);
 
         /* Free */
         sn_grs_resource_info_free(handle, resource_temp);
@@ -206,6 +223,7 @@ int8_t sn_grs_put_resource(struct grs_s *handle, sn_nsdl_dynamic_resource_parame
 
     ns_list_add_to_start(&handle->resource_root_list, res);
     ++handle->resource_root_count;
+    sn_grs_index_add(handle, res);
 
     return SN_NSDL_SUCCESS;
 }
@@ -227,10 +245,26 @@ int8_t sn_grs_pop_resource(struct grs_s *handle, sn_nsdl_dynamic_resource_parame
         return SN_NSDL_FAILURE;
     }
 
+    sn_grs_remove_from_list(handle, res);
+
+    return SN_NSDL_SUCCESS;
+}
+
+static void sn_grs_remove_from_list(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res)
+{
+    sn_grs_index_remove(handle, res);
     ns_list_remove(&handle->resource_root_list, res);
     --handle->resource_root_count;
+    sn_grs_link_format_free(handle, res);
+}
 
-    return SN_NSDL_SUCCESS;
+static void sn_grs_link_format_free(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res)
+{
+    if (res->link_format_ptr) {
+        handle->sn_grs_free(res->link_format_ptr);
+        res->link_format_ptr = NULL;
+        res->link_format_len = 0;
+    }
 }
 
 /**
@@ -585,6 +619,21 @@ sn_nsdl_dynamic_resource_parameters_s *sn_grs_search_resource(struct grs_s *hand
 
     /* Searchs exact path */
     if (search_method == SN_GRS_SEARCH_METHOD) {
+        /* Use the hash index when available */
+        if (handle->resource_hash_table) {
+            uint32_t hash = sn_grs_index_hash(path_temp_ptr, pathlen);
+            sn_nsdl_dynamic_resource_parameters_s *resource_search_temp =
+                    handle->resource_hash_table[hash & (handle->resource_hash_size - 1)];
+            while (resource_search_temp) {
+                const char *temp_path = resource_search_temp->static_resource_parameters->path;
+                if (strlen(temp_path) == pathlen && 0 == memcmp(temp_path, path_temp_ptr, pathlen)) {
+                    return resource_search_temp;
+                }
+                resource_search_temp = resource_search_temp->hash_next;
+            }
+            return NULL;
+        }
+
         /* Scan all nodes on list */
         ns_list_foreach(sn_nsdl_dynamic_resource_parameters_s, resource_search_temp, &handle->resource_root_list) {
             /* If length equals.. */
@@ -607,6 +656,20 @@ sn_nsdl_dynamic_resource_parameters_s *sn_grs_search_resource(struct grs_s *hand
     }
     /* Search also subresources, eg. dr/x -> returns dr/x/1, dr/x/2 etc... */
     else if (search_method == SN_GRS_DELETE_METHOD) {
+        /* Subresources are adjacent in the path-sorted index, starting from "dr/x/" */
+        if (handle->resource_sorted_table) {
+            uint16_t index = sn_grs_index_sorted_lower_bound(handle->resource_sorted_table, handle->resource_root_count,
+                                                             path_temp_ptr, pathlen, true);
+            if (index < handle->resource_root_count) {
+                sn_nsdl_dynamic_resource_parameters_s *resource_search_temp = handle->resource_sorted_table[index];
+                const char *temp_path = resource_search_temp->static_resource_parameters->path;
+                if (0 == strncmp(temp_path, path_temp_ptr, pathlen) && temp_path[pathlen] == '/') {
+                    return resource_search_temp;
+                }
+            }
+            return NULL;
+        }
+
         /* Scan all nodes on list */
         ns_list_foreach(sn_nsdl_dynamic_resource_parameters_s, resource_search_temp, &handle->resource_root_list) {
             char *temp_path = resource_search_temp->static_resource_parameters->path;
@@ -624,6 +687,229 @@ sn_nsdl_dynamic_resource_parameters_s *sn_grs_search_resource(struct grs_s *hand
     return NULL;
 }
 
+/**
+ * \fn  static uint32_t sn_grs_index_hash(const char *path, uint16_t path_len)
+ *
+ * \brief Calculates FNV-1a hash of the path used for the hash index buckets
+ *
+*/
+static uint32_t sn_grs_index_hash(const char *path, uint16_t path_len)
+{
+    uint32_t hash = 2166136261u;
+    for (uint16_t i = 0; i < path_len; i++) {
+        hash ^= (uint8_t)path[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * \fn  static int sn_grs_index_compare(const char *path, const char *prefix, uint16_t prefix_len, bool subtree)
+ *
+ * \brief Compares resource path against a search key in the sort order of the path-sorted index
+ *
+ *  \param  subtree         If true the key is "prefix/" and all the subresources of prefix compare equal,
+ *                          otherwise the key is the exact path prefix[0..prefix_len].
+ *
+ *  \return                 <0, 0 or >0 like strcmp()
+ *
+*/
+static int sn_grs_index_compare(const char *path, const char *prefix, uint16_t prefix_len, bool subtree)
+{
+    int ret = strncmp(path, prefix, prefix_len);
+    if (ret != 0) {
+        return ret;
+    }
+    if (subtree) {
+        return (int)(uint8_t)path[prefix_len] - '/';
+    }
+    return (uint8_t)path[prefix_len];
+}
+
+static int sn_grs_index_sort_compare(const void *a, const void *b)
+{
+    const sn_nsdl_dynamic_resource_parameters_s *res_a = *(sn_nsdl_dynamic_resource_parameters_s * const *)a;
+    const sn_nsdl_dynamic_resource_parameters_s *res_b = *(sn_nsdl_dynamic_resource_parameters_s * const *)b;
+    return strcmp(res_a->static_resource_parameters->path, res_b->static_resource_parameters->path);
+}
+
+/**
+ * \fn  static uint16_t sn_grs_index_sorted_lower_bound(sn_nsdl_dynamic_resource_parameters_s **table, uint16_t count,
+ *                                                     const char *prefix, uint16_t prefix_len, bool subtree)
+ *
+ * \brief Binary search for the first entry of the path-sorted index not less than the search key
+ *
+ *  \param  count           Number of valid entries in the table
+ *
+ *  \return                 Index to the table, count if all entries are less than the key
+ *
+*/
+static uint16_t sn_grs_index_sorted_lower_bound(sn_nsdl_dynamic_resource_parameters_s **table, uint16_t count,
+                                                const char *prefix, uint16_t prefix_len, bool subtree)
+{
+    uint16_t low = 0;
+    uint16_t high = count;
+
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (sn_grs_index_compare(table[mid]->static_resource_parameters->path,
+                                 prefix, prefix_len, subtree) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * \fn  static void sn_grs_index_rebuild_hash(struct grs_s *handle, uint16_t size)
+ *
+ * \brief Reallocates hash buckets and rehashes all resources on the list into them
+ *
+ *  If allocation fails the old buckets are kept, so the index still covers the whole list.
+ *
+ *  \param  size            Number of buckets, must be a power of two
+ *
+*/
+static void sn_grs_index_rebuild_hash(struct grs_s *handle, uint16_t size)
+{
+    sn_nsdl_dynamic_resource_parameters_s **table = handle->sn_grs_alloc(size * sizeof(sn_nsdl_dynamic_resource_parameters_s *));
+    if (!table) {
+        return;
+    }
+    memset(table, 0, size * sizeof(sn_nsdl_dynamic_resource_parameters_s *));
+
+    ns_list_foreach(sn_nsdl_dynamic_resource_parameters_s, res, &handle->resource_root_list) {
+        const char *path = res->static_resource_parameters->path;
+        uint16_t bucket = sn_grs_index_hash(path, strlen(path)) & (size - 1);
+        res->hash_next = table[bucket];
+        table[bucket] = res;
+    }
+
+    handle->sn_grs_free(handle->resource_hash_table);
+    handle->resource_hash_table = table;
+    handle->resource_hash_size = size;
+}
+
+/**
+ * \fn  static void sn_grs_index_rebuild_sorted(struct grs_s *handle, uint16_t size)
+ *
+ * \brief Reallocates the path-sorted index and fills it from the list
+ *
+ *  If allocation fails the sorted index is dropped and subtree searches fall back to the list
+ *  until the next successful rebuild.
+ *
+ *  \param  size            Number of entries to allocate, must not be less than resource_root_count
+ *
+*/
+static void sn_grs_index_rebuild_sorted(struct grs_s *handle, uint16_t size)
+{
+    sn_nsdl_dynamic_resource_parameters_s **table = handle->sn_grs_alloc(size * sizeof(sn_nsdl_dynamic_resource_parameters_s *));
+
+    handle->sn_grs_free(handle->resource_sorted_table);
+    handle->resource_sorted_table = table;
+    handle->resource_sorted_size = table ? size : 0;
+    if (!table) {
+        return;
+    }
+
+    uint16_t count = 0;
+    ns_list_foreach(sn_nsdl_dynamic_resource_parameters_s, res, &handle->resource_root_list) {
+        table[count++] = res;
+    }
+    qsort(table, count, sizeof(sn_nsdl_dynamic_resource_parameters_s *), sn_grs_index_sort_compare);
+}
+
+/**
+ * \fn  static void sn_grs_index_add(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res)
+ *
+ * \brief Adds resource to the path index, the resource must already be on the list
+ *
+*/
+static void sn_grs_index_add(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res)
+{
+    const char *path = res->static_resource_parameters->path;
+    uint16_t path_len = strlen(path);
+    /* Entries in the index before this resource */
+    uint16_t count = handle->resource_root_count - 1;
+
+    /* Hash buckets, keep load factor at most 1 as long as the table fits in one allocation.
+     * A successful rebuild rehashes the whole list, including the new resource. */
+    if ((!handle->resource_hash_table || handle->resource_root_count > handle->resource_hash_size) &&
+            handle->resource_hash_size < SN_GRS_INDEX_MAX_ENTRIES / 2) {
+        sn_nsdl_dynamic_resource_parameters_s **old_table = handle->resource_hash_table;
+        sn_grs_index_rebuild_hash(handle, handle->resource_hash_size ? handle->resource_hash_size * 2 : SN_GRS_INDEX_MIN_SIZE);
+        if (old_table != handle->resource_hash_table) {
+            path = NULL;
+        }
+    }
+    if (path && handle->resource_hash_table) {
+        uint16_t bucket = sn_grs_index_hash(path, path_len) & (handle->resource_hash_size - 1);
+        res->hash_next = handle->resource_hash_table[bucket];
+        handle->resource_hash_table[bucket] = res;
+    }
+
+    /* Path-sorted table, grown by doubling and refilled from the list */
+    if (!handle->resource_sorted_table || handle->resource_root_count > handle->resource_sorted_size) {
+        uint32_t size = handle->resource_sorted_size ? (uint32_t)handle->resource_sorted_size * 2 : SN_GRS_INDEX_MIN_SIZE;
+        while (size < handle->resource_root_count) {
+            size *= 2;
+        }
+        if (size > SN_GRS_INDEX_MAX_ENTRIES) {
+            size = SN_GRS_INDEX_MAX_ENTRIES;
+        }
+        if (size < handle->resource_root_count) {
+            handle->sn_grs_free(handle->resource_sorted_table);
+            handle->resource_sorted_table = NULL;
+            handle->resource_sorted_size = 0;
+        } else {
+            sn_grs_index_rebuild_sorted(handle, size);
+        }
+        return;
+    }
+
+    uint16_t index = sn_grs_index_sorted_lower_bound(handle->resource_sorted_table, count,
+                                                     res->static_resource_parameters->path, path_len, false);
+    memmove(&handle->resource_sorted_table[index + 1], &handle->resource_sorted_table[index],
+            (count - index) * sizeof(sn_nsdl_dynamic_resource_parameters_s *));
+    handle->resource_sorted_table[index] = res;
+}
+
+/**
+ * \fn  static void sn_grs_index_remove(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res)
+ *
+ * \brief Removes resource from the path index, the resource must still be on the list
+ *
+*/
+static void sn_grs_index_remove(struct grs_s *handle, sn_nsdl_dynamic_resource_parameters_s *res)
+{
+    const char *path = res->static_resource_parameters->path;
+    uint16_t path_len = strlen(path);
+
+    if (handle->resource_hash_table) {
+        sn_nsdl_dynamic_resource_parameters_s **next_ptr =
+                &handle->resource_hash_table[sn_grs_index_hash(path, path_len) & (handle->resource_hash_size - 1)];
+        while (*next_ptr) {
+            if (*next_ptr == res) {
+                *next_ptr = res->hash_next;
+                break;
+            }
+            next_ptr = &(*next_ptr)->hash_next;
+        }
+    }
+    res->hash_next = NULL;
+
+    if (handle->resource_sorted_table) {
+        uint16_t index = sn_grs_index_sorted_lower_bound(handle->resource_sorted_table, handle->resource_root_count,
+                                                         path, path_len, false);
+        if (index < handle->resource_root_count && handle->resource_sorted_table[index] == res) {
+            memmove(&handle->resource_sorted_table[index], &handle->resource_sorted_table[index + 1],
+                    (handle->resource_root_count - 1 - index) * sizeof(sn_nsdl_dynamic_resource_parameters_s *));
+        }
+    }
+}
+
 /**
  * \fn  static uint8_t *sn_grs_convert_uri(uint16_t *uri_len, uint8_t *uri_ptr)
  *
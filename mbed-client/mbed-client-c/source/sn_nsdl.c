@@ -110,6 +110,9 @@ static int32_t          sn_nsdl_internal_coap_send(struct nsdl_s *handle, sn_coa
 static void             sn_nsdl_resolve_nsp_address(struct nsdl_s *handle);
 int8_t                  sn_nsdl_build_registration_body(struct nsdl_s *handle, sn_coap_hdr_s *message_ptr, uint8_t updating_registeration);
 static uint16_t         sn_nsdl_calculate_registration_body_size(struct nsdl_s *handle, uint8_t updating_registeration, int8_t *error);
+static uint16_t         sn_nsdl_calculate_link_format_len(const sn_nsdl_dynamic_resource_parameters_s *resource, int8_t *error);
+static uint8_t          *sn_nsdl_write_link_format(const sn_nsdl_dynamic_resource_parameters_s *resource, uint8_t *temp_ptr);
+static int8_t           sn_nsdl_update_link_format(struct nsdl_s *handle, sn_nsdl_dynamic_resource_parameters_s *resource);
 static uint8_t          sn_nsdl_calculate_uri_query_option_len(sn_nsdl_ep_parameters_s *endpoint_info_ptr, uint8_t msg_type, const char *uri_query);
 static int8_t           sn_nsdl_fill_uri_query_options(struct nsdl_s *handle, sn_nsdl_ep_parameters_s *parameter_ptr, sn_coap_hdr_s *source_msg_ptr, uint8_t msg_type, const char *uri_query);
 static int8_t           sn_nsdl_local_rx_function(struct nsdl_s *handle, sn_coap_hdr_s *coap_packet_ptr, sn_nsdl_addr_s *address_ptr);
@@ -989,7 +992,7 @@ int8_t sn_nsdl_build_registration_body(struct nsdl_s *handle, sn_coap_hdr_s *mes
     uint8_t                 *temp_ptr;
     sn_nsdl_dynamic_resource_parameters_s   *resource_temp_ptr;
 
-    /* Calculate needed memory and allocate */
+    /* Calculate needed memory and allocate, this also brings the cached link-formats up to date */
     int8_t error = 0;
     uint16_t msg_len = sn_nsdl_calculate_registration_body_size(handle, updating_registeration, &error);
     if (SN_NSDL_FAILURE == error) {
@@ -1028,86 +1031,9 @@ int8_t sn_nsdl_build_registration_body(struct nsdl_s *handle, sn_coap_hdr_s *mes
                 *temp_ptr++ = ',';
             }
 
-            *temp_ptr++ = '<';
-            *temp_ptr++ = '/';
-            size_t path_len = 0;
-            if (resource_temp_ptr->static_resource_parameters->path) {
-                path_len = strlen(resource_temp_ptr->static_resource_parameters->path);
-            }
-            memcpy(temp_ptr,
-                   resource_temp_ptr->static_resource_parameters->path,
-                   path_len);
-            temp_ptr += path_len;
-            *temp_ptr++ = '>';
-
-            /* Resource attributes */
-#ifndef RESOURCE_ATTRIBUTES_LIST
-#ifndef DISABLE_RESOURCE_TYPE
-            size_t resource_type_len = 0;
-            if (resource_temp_ptr->static_resource_parameters->resource_type_ptr) {
-                resource_type_len = strlen(resource_temp_ptr->static_resource_parameters->resource_type_ptr);
-            }
-            if (resource_type_len) {
-                *temp_ptr++ = ';';
-                memcpy(temp_ptr, resource_type_parameter, RT_PARAMETER_LEN);
-                temp_ptr += RT_PARAMETER_LEN;
-                *temp_ptr++ = '"';
-                memcpy(temp_ptr,
-                       resource_temp_ptr->static_resource_parameters->resource_type_ptr,
-                       resource_type_len);
-                temp_ptr += resource_type_len;
-                *temp_ptr++ = '"';
-            }
-#endif
-#ifndef DISABLE_INTERFACE_DESCRIPTION
-            size_t interface_description_len = 0;
-            if (resource_temp_ptr->static_resource_parameters->interface_description_ptr) {
-                interface_description_len = strlen(resource_temp_ptr->static_resource_parameters->interface_description_ptr);
-            }
-
-            if (interface_description_len) {
-                *temp_ptr++ = ';';
-                memcpy(temp_ptr, if_description_parameter, IF_PARAMETER_LEN);
-                temp_ptr += IF_PARAMETER_LEN;
-                *temp_ptr++ = '"';
-                memcpy(temp_ptr,
-                       resource_temp_ptr->static_resource_parameters->interface_description_ptr,
-                       interface_description_len);
-                temp_ptr += interface_description_len;
-                *temp_ptr++ = '"';
-            }
-#endif
-#else
-            size_t attribute_len = 0;
-            if (resource_temp_ptr->static_resource_parameters->attributes_ptr) {
-                sn_nsdl_attribute_item_s *attribute = resource_temp_ptr->static_resource_parameters->attributes_ptr;
-                while (attribute->attribute_name != ATTR_END) {
-                    switch (attribute->attribute_name) {
-                    case ATTR_RESOURCE_TYPE:
-                        temp_ptr = sn_nsdl_build_resource_attribute_str(temp_ptr, attribute, resource_type_parameter, RT_PARAMETER_LEN);
-                        break;
-                    case ATTR_INTERFACE_DESCRIPTION:
-                        temp_ptr = sn_nsdl_build_resource_attribute_str(temp_ptr, attribute, if_description_parameter, IF_PARAMETER_LEN);
-                        break;
-                    case ATTR_ENDPOINT_NAME:
-                        temp_ptr = sn_nsdl_build_resource_attribute_str(temp_ptr, attribute, name_parameter, NAME_PARAMETER_LEN);
-                        break;
-                    default:
-                        break;
-                    }
-                    attribute++;
-                }
-            }
-#endif
-            if (resource_temp_ptr->coap_content_type != 0) {
-                *temp_ptr++ = ';';
-                memcpy(temp_ptr, coap_con_type_parameter, COAP_CON_PARAMETER_LEN);
-                temp_ptr += COAP_CON_PARAMETER_LEN;
-                *temp_ptr++ = '"';
-                temp_ptr = sn_nsdl_itoa(temp_ptr,
-                                        resource_temp_ptr->coap_content_type);
-                *temp_ptr++ = '"';
-            }
+            /* </path>, attributes and ;ct are taken from the cache */
+            memcpy(temp_ptr, resource_temp_ptr->link_format_ptr, resource_temp_ptr->link_format_len);
+            temp_ptr += resource_temp_ptr->link_format_len;
 
             /* ;v */
             if ((resource_temp_ptr->publish_value > 0) && resource_temp_ptr->resource) {
@@ -1177,7 +1103,7 @@ int8_t sn_nsdl_build_registration_body(struct nsdl_s *handle, sn_coap_hdr_s *mes
  * \fn static uint16_t sn_nsdl_calculate_registration_body_size(struct nsdl_s *handle, uint8_t updating_registeration, int8_t *error)
  *
  *
- * \brief   Calculates registration message payload size
+ * \brief   Calculates registration message payload size, rebuilds the cached link-format of changed resources
  * \param   *handle                 Pointer to nsdl-library handle
  * \param   *updating_registeration Pointer to list of GRS resources
  * \param   *error                  Error code, SN_NSDL_SUCCESS or SN_NSDL_FAILURE
@@ -1190,7 +1116,7 @@ static uint16_t sn_nsdl_calculate_registration_body_size(struct nsdl_s *handle,
     /* Local variables */
     uint16_t return_value = 0;
     *error = SN_NSDL_SUCCESS;
-    const sn_nsdl_dynamic_resource_parameters_s *resource_temp_ptr;
+    sn_nsdl_dynamic_resource_parameters_s *resource_temp_ptr;
 
     /* check pointer */
     resource_temp_ptr = sn_grs_get_first_resource(handle->grs);
@@ -1211,113 +1137,18 @@ static uint16_t sn_nsdl_calculate_registration_body_size(struct nsdl_s *handle,
                 }
             }
 
-            /* Count length for the resource path </path> */
-            size_t path_len = 0;
-            if (resource_temp_ptr->static_resource_parameters->path) {
-                path_len = strlen(resource_temp_ptr->static_resource_parameters->path);
+            /* </path>, attributes and ;ct */
+            if (sn_nsdl_update_link_format(handle, resource_temp_ptr) != SN_NSDL_SUCCESS) {
+                *error = SN_NSDL_FAILURE;
+                break;
             }
-
-            if (sn_nsdl_check_uint_overflow(return_value, 3, path_len)) {
-                return_value += (3 + path_len);
+            if (sn_nsdl_check_uint_overflow(return_value, resource_temp_ptr->link_format_len, 0)) {
+                return_value += resource_temp_ptr->link_format_len;
             } else {
                 *error = SN_NSDL_FAILURE;
                 break;
             }
 
-            /* Count lengths of the attributes */
-#ifndef RESOURCE_ATTRIBUTES_LIST
-#ifndef DISABLE_RESOURCE_TYPE
-            /* Resource type parameter */
-            size_t resource_type_len = 0;
-            if (resource_temp_ptr->static_resource_parameters->resource_type_ptr) {
-                resource_type_len = strlen(resource_temp_ptr->static_resource_parameters->resource_type_ptr);
-            }
-
-            if (resource_type_len) {
-                /* ;rt="restype" */
-                if (sn_nsdl_check_uint_overflow(return_value,
-                                                6,
-                                                resource_type_len)) {
-                    return_value += (6 + resource_type_len);
-                } else {
-                    *error = SN_NSDL_FAILURE;
-                    break;
-                }
-            }
-#endif
-
-#ifndef DISABLE_INTERFACE_DESCRIPTION
-            /* Interface description parameter */
-            size_t interface_description_len = 0;
-            if (resource_temp_ptr->static_resource_parameters->interface_description_ptr) {
-                interface_description_len = strlen(resource_temp_ptr->static_resource_parameters->interface_description_ptr);
-            }
-            if (interface_description_len) {
-                /* ;if="iftype" */
-                if (sn_nsdl_check_uint_overflow(return_value,
-                                                6,
-                                                interface_description_len)) {
-                    return_value += (6 + interface_description_len);
-                } else {
-                    *error = SN_NSDL_FAILURE;
-                    break;
-                }
-            }
-#endif
-#else
-            /* All attributes */
-            if (resource_temp_ptr->static_resource_parameters->attributes_ptr) {
-                size_t attribute_len = 0;
-                size_t attribute_desc_len = 0;
-                uint8_t success = 1;
-                sn_nsdl_attribute_item_s *item = resource_temp_ptr->static_resource_parameters->attributes_ptr;
-                while (item->attribute_name != ATTR_END) {
-                    switch(item->attribute_name) {
-                    case ATTR_RESOURCE_TYPE:
-                        /* ;rt="restype" */
-                        attribute_desc_len = 6;
-                        attribute_len = strlen(item->value);
-                        break;
-                    case ATTR_INTERFACE_DESCRIPTION:
-                        /* ;if="iftype" */
-                        attribute_desc_len = 6;
-                        attribute_len = strlen(item->value);
-                        break;
-                    case ATTR_ENDPOINT_NAME:
-                        /* ;name="name" */
-                        attribute_desc_len = 8;
-                        attribute_len = strlen(item->value);
-                        break;
-                    default:
-                        break;
-                    }
-                    if (sn_nsdl_check_uint_overflow(return_value,
-                                                    attribute_desc_len,
-                                                    attribute_len)) {
-                        return_value += (attribute_desc_len + attribute_len);
-                    } else {
-                        success = 0;
-                        break;
-                    }
-                    item++;
-                }
-                if (!success) {
-                    *error = SN_NSDL_FAILURE;
-                    break;
-                }
-            }
-#endif
-            if (resource_temp_ptr->coap_content_type != 0) {
-                /* ;if="content" */
-                uint8_t len = sn_nsdl_itoa_len(resource_temp_ptr->coap_content_type);
-                if (sn_nsdl_check_uint_overflow(return_value, 6, len)) {
-                    return_value += (6 + len);
-                } else {
-                    *error = SN_NSDL_FAILURE;
-                    break;
-                }
-            }
-
             if ((resource_temp_ptr->publish_value > 0) && resource_temp_ptr->resource) {
                 /* ;v="" */
                 uint16_t len = resource_temp_ptr->resource_len;
@@ -1372,6 +1203,254 @@ static uint16_t sn_nsdl_calculate_registration_body_size(struct nsdl_s *handle,
     return return_value;
 }
 
+/**
+ * \fn static uint16_t sn_nsdl_calculate_link_format_len(const sn_nsdl_dynamic_resource_parameters_s *resource, int8_t *error)
+ *
+ * \brief   Calculates length of the static part of resource link-format: </path>, attributes and ;ct
+ * \param   *resource   Pointer to resource
+ * \param   *error      Error code, SN_NSDL_SUCCESS or SN_NSDL_FAILURE
+ *
+ * \return  Needed length
+ */
+static uint16_t sn_nsdl_calculate_link_format_len(const sn_nsdl_dynamic_resource_parameters_s *resource, int8_t *error)
+{
+    uint16_t return_value = 0;
+    *error = SN_NSDL_FAILURE;
+
+    /* Count length for the resource path </path> */
+    size_t path_len = 0;
+    if (resource->static_resource_parameters->path) {
+        path_len = strlen(resource->static_resource_parameters->path);
+    }
+
+    if (sn_nsdl_check_uint_overflow(return_value, 3, path_len)) {
+        return_value += (3 + path_len);
+    } else {
+        return 0;
+    }
+
+    /* Count lengths of the attributes */
+#ifndef RESOURCE_ATTRIBUTES_LIST
+#ifndef DISABLE_RESOURCE_TYPE
+    /* Resource type parameter */
+    size_t resource_type_len = 0;
+    if (resource->static_resource_parameters->resource_type_ptr) {
+        resource_type_len = strlen(resource->static_resource_parameters->resource_type_ptr);
+    }
+
+    if (resource_type_len) {
+        /* ;rt="restype" */
+        if (sn_nsdl_check_uint_overflow(return_value,
+                                        6,
+                                        resource_type_len)) {
+            return_value += (6 + resource_type_len);
+        } else {
+            return 0;
+        }
+    }
+#endif
+
+#ifndef DISABLE_INTERFACE_DESCRIPTION
+    /* Interface description parameter */
+    size_t interface_description_len = 0;
+    if (resource->static_resource_parameters->interface_description_ptr) {
+        interface_description_len = strlen(resource->static_resource_parameters->interface_description_ptr);
+    }
+    if (interface_description_len) {
+        /* ;if="iftype" */
+        if (sn_nsdl_check_uint_overflow(return_value,
+                                        6,
+                                        interface_description_len)) {
+            return_value += (6 + interface_description_len);
+        } else {
+            return 0;
+        }
+    }
+#endif
+#else
+    /* All attributes */
+    if (resource->static_resource_parameters->attributes_ptr) {
+        const sn_nsdl_attribute_item_s *item = resource->static_resource_parameters->attributes_ptr;
+        while (item->attribute_name != ATTR_END) {
+            size_t attribute_len = 0;
+            size_t attribute_desc_len = 0;
+            switch(item->attribute_name) {
+            case ATTR_RESOURCE_TYPE:
+                /* ;rt="restype" */
+                attribute_desc_len = 6;
+                break;
+            case ATTR_INTERFACE_DESCRIPTION:
+                /* ;if="iftype" */
+                attribute_desc_len = 6;
+                break;
+            case ATTR_ENDPOINT_NAME:
+                /* ;name="name" */
+                attribute_desc_len = 8;
+                break;
+            default:
+                break;
+            }
+            /* Attributes without value are skipped when building */
+            if (attribute_desc_len && item->value) {
+                attribute_len = strlen(item->value);
+                if (sn_nsdl_check_uint_overflow(return_value,
+                                                attribute_desc_len,
+                                                attribute_len)) {
+                    return_value += (attribute_desc_len + attribute_len);
+                } else {
+                    return 0;
+                }
+            }
+            item++;
+        }
+    }
+#endif
+    if (resource->coap_content_type != 0) {
+        /* ;ct="content" */
+        uint8_t len = sn_nsdl_itoa_len(resource->coap_content_type);
+        if (sn_nsdl_check_uint_overflow(return_value, 6, len)) {
+            return_value += (6 + len);
+        } else {
+            return 0;
+        }
+    }
+
+    *error = SN_NSDL_SUCCESS;
+    return return_value;
+}
+
+/**
+ * \fn static uint8_t *sn_nsdl_write_link_format(const sn_nsdl_dynamic_resource_parameters_s *resource, uint8_t *temp_ptr)
+ *
+ * \brief   Writes the static part of resource link-format: </path>, attributes and ;ct
+ * \param   *resource   Pointer to resource
+ * \param   *temp_ptr   Destination, must have room for sn_nsdl_calculate_link_format_len() bytes
+ *
+ * \return  Pointer to the first byte after the written link-format
+ */
+static uint8_t *sn_nsdl_write_link_format(const sn_nsdl_dynamic_resource_parameters_s *resource, uint8_t *temp_ptr)
+{
+    *temp_ptr++ = '<';
+    *temp_ptr++ = '/';
+    size_t path_len = 0;
+    if (resource->static_resource_parameters->path) {
+        path_len = strlen(resource->static_resource_parameters->path);
+    }
+    memcpy(temp_ptr,
+           resource->static_resource_parameters->path,
+           path_len);
+    temp_ptr += path_len;
+    *temp_ptr++ = '>';
+
+    /* Resource attributes */
+#ifndef RESOURCE_ATTRIBUTES_LIST
+#ifndef DISABLE_RESOURCE_TYPE
+    size_t resource_type_len = 0;
+    if (resource->static_resource_parameters->resource_type_ptr) {
+        resource_type_len = strlen(resource->static_resource_parameters->resource_type_ptr);
+    }
+    if (resource_type_len) {
+        *temp_ptr++ = ';';
+        memcpy(temp_ptr, resource_type_parameter, RT_PARAMETER_LEN);
+        temp_ptr += RT_PARAMETER_LEN;
+        *temp_ptr++ = '"';
+        memcpy(temp_ptr,
+               resource->static_resource_parameters->resource_type_ptr,
+               resource_type_len);
+        temp_ptr += resource_type_len;
+        *temp_ptr++ = '"';
+    }
+#endif
+#ifndef DISABLE_INTERFACE_DESCRIPTION
+    size_t interface_description_len = 0;
+    if (resource->static_resource_parameters->interface_description_ptr) {
+        interface_description_len = strlen(resource->static_resource_parameters->interface_description_ptr);
+    }
+
+    if (interface_description_len) {
+        *temp_ptr++ = ';';
+        memcpy(temp_ptr, if_description_parameter, IF_PARAMETER_LEN);
+        temp_ptr += IF_PARAMETER_LEN;
+        *temp_ptr++ = '"';
+        memcpy(temp_ptr,
+               resource->static_resource_parameters->interface_description_ptr,
+               interface_description_len);
+        temp_ptr += interface_description_len;
+        *temp_ptr++ = '"';
+    }
+#endif
+#else
+    if (resource->static_resource_parameters->attributes_ptr) {
+        const sn_nsdl_attribute_item_s *attribute = resource->static_resource_parameters->attributes_ptr;
+        while (attribute->attribute_name != ATTR_END) {
+            switch (attribute->attribute_name) {
+            case ATTR_RESOURCE_TYPE:
+                temp_ptr = (uint8_t*)sn_nsdl_build_resource_attribute_str((char*)temp_ptr, attribute, resource_type_parameter, RT_PARAMETER_LEN);
+                break;
+            case ATTR_INTERFACE_DESCRIPTION:
+                temp_ptr = (uint8_t*)sn_nsdl_build_resource_attribute_str((char*)temp_ptr, attribute, if_description_parameter, IF_PARAMETER_LEN);
+                break;
+            case ATTR_ENDPOINT_NAME:
+                temp_ptr = (uint8_t*)sn_nsdl_build_resource_attribute_str((char*)temp_ptr, attribute, name_parameter, NAME_PARAMETER_LEN);
+                break;
+            default:
+                break;
+            }
+            attribute++;
+        }
+    }
+#endif
+    if (resource->coap_content_type != 0) {
+        *temp_ptr++ = ';';
+        memcpy(temp_ptr, coap_con_type_parameter, COAP_CON_PARAMETER_LEN);
+        temp_ptr += COAP_CON_PARAMETER_LEN;
+        *temp_ptr++ = '"';
+        temp_ptr = sn_nsdl_itoa(temp_ptr,
+                                resource->coap_content_type);
+        *temp_ptr++ = '"';
+    }
+    return temp_ptr;
+}
+
+/**
+ * \fn static int8_t sn_nsdl_update_link_format(struct nsdl_s *handle, sn_nsdl_dynamic_resource_parameters_s *resource)
+ *
+ * \brief   Rebuilds the cached link-format of the resource if it does not exist yet or has been marked as changed.
+ *          Buffer is reallocated only if the length of the link-format changes.
+ * \param   *handle     Pointer to nsdl-library handle
+ * \param   *resource   Pointer to resource
+ *
+ * \return  SN_NSDL_SUCCESS = 0, Failed = -1
+ */
+static int8_t sn_nsdl_update_link_format(struct nsdl_s *handle, sn_nsdl_dynamic_resource_parameters_s *resource)
+{
+    if (resource->link_format_ptr && !resource->link_format_dirty) {
+        return SN_NSDL_SUCCESS;
+    }
+
+    int8_t error = SN_NSDL_SUCCESS;
+    uint16_t len = sn_nsdl_calculate_link_format_len(resource, &error);
+    if (error != SN_NSDL_SUCCESS) {
+        return SN_NSDL_FAILURE;
+    }
+
+    if (!resource->link_format_ptr || resource->link_format_len != len) {
+        if (resource->link_format_ptr) {
+            handle->sn_nsdl_free(resource->link_format_ptr);
+        }
+        resource->link_format_len = 0;
+        resource->link_format_ptr = handle->sn_nsdl_alloc(len);
+        if (!resource->link_format_ptr) {
+            return SN_NSDL_FAILURE;
+        }
+    }
+
+    sn_nsdl_write_link_format(resource, resource->link_format_ptr);
+    resource->link_format_len = len;
+    resource->link_format_dirty = false;
+    return SN_NSDL_SUCCESS;
+}
+
 /**
  * \fn static uint8_t sn_nsdl_calculate_uri_query_option_len(sn_nsdl_ep_parameters_s *endpoint_info_ptr, uint8_t msg_type)
  *
@@ -2138,6 +2217,13 @@ int8_t sn_nsdl_clear_coap_resending_queue(struct nsdl_s *handle)
     return SN_NSDL_SUCCESS;
 }
 
+void sn_nsdl_resource_link_format_changed(sn_nsdl_dynamic_resource_parameters_s *resource)
+{
+    if (resource) {
+        resource->link_format_dirty = true;
+    }
+}
+
 #ifdef RESOURCE_ATTRIBUTES_LIST
 static void sn_nsdl_free_attribute_value(sn_nsdl_attribute_item_s *attribute)
 {
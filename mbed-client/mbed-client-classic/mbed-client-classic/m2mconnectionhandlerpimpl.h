@@ -17,7 +17,6 @@
 #define M2M_CONNECTION_HANDLER_PIMPL_H__
 
 #include "ns_types.h"
-#include "ns_list.h"
 #include "eventOS_event.h"
 #include "mbed-client/m2mconfig.h"
 #include "mbed-client/m2mconstants.h"
@@ -171,6 +170,26 @@ public:
     */
     void force_close();
 
+    /**
+    * @brief Returns the number of packets waiting to be sent.
+    */
+    uint16_t send_queue_depth() const;
+
+    /**
+    * @brief Returns the number of bytes waiting to be sent.
+    */
+    uint32_t send_queue_bytes() const;
+
+    /**
+    * @brief Returns the highest number of packets which have been waiting to be sent at the same time.
+    */
+    uint16_t send_queue_peak_depth() const;
+
+    /**
+    * @brief Returns the highest number of bytes which have been waiting to be sent at the same time.
+    */
+    uint32_t send_queue_peak_bytes() const;
+
 private:
 
     /**
@@ -224,22 +243,59 @@ public:
     bool send_event(SocketEvent event_type);
 
 private:
-    typedef struct send_data_queue {
-        uint8_t *data;
-        uint16_t offset;
-        uint16_t data_len;
-        ns_list_link_t link;
-    } send_data_queue_s;
+    /**
+     * Header of a packet in the send queue. The packet follows the header in the queue,
+     * unless it did not fit and was allocated from heap.
+     */
+    typedef struct send_queue_record {
+        uint8_t *heap_data;
+        uint32_t data_len; // 0 marks the end of the records, the next one is at the start of the queue
+        uint32_t offset; // bytes already sent
+    } send_queue_record_s;
+
+    /**
+     * @brief Copies a packet to the end of the send queue, with the TCP length shim in front
+     * of it if needed. Must be called while holding the mutex.
+     * @return False if there was no room for the packet.
+     */
+    bool queue_packet(const uint8_t *data, uint16_t data_len);
+
+    /**
+     * @brief Reserves a record of the given size at the end of the send queue.
+     * Must be called while holding the mutex.
+     * @return Position of the record or -1 if there is no room for it.
+     */
+    int32_t reserve_queue_record(uint32_t size);
+
+    /**
+     * @brief Reads the record at or after the given position, skipping the end of the queue.
+     * Must be called while holding the mutex.
+     * @return Position of the record.
+     */
+    uint32_t read_queue_record(uint32_t position, send_queue_record_s &record) const;
+
+    /**
+     * @brief Returns the packet of a record read from the given position.
+     */
+    uint8_t* queue_record_data(uint32_t position, const send_queue_record_s &record) const;
+
+    /**
+     * @brief Removes the first packet from the send queue. Must be called while holding the mutex.
+     */
+    void pop_packet();
 
     /**
-     * @brief Get first item from the queue list.
+     * @brief Sends all the queued datagrams of an unsecure UDP connection in batches.
+     * @return False if sending failed, the error has been reported then.
      */
-    send_data_queue_s* get_item_from_list();
+    bool send_queued_datagrams();
 
     /**
-     * @brief Add queue data back to list.
+     * @brief Reads the datagrams of an unsecure UDP connection in batches and passes them to the observer.
+     * @return False if the platform has no batch receive support or the receive buffers could not
+     * be allocated, nothing was read then.
      */
-    void add_item_to_list(send_data_queue_s* data);
+    bool receive_datagrams();
 
 private:
     enum SocketState {
@@ -277,8 +333,6 @@ private:
         ESocketStateSecureConnection
     };
 
-    typedef NS_LIST_HEAD(send_data_queue_s, link) send_data_list_t;
-
     M2MConnectionHandler                        *_base;
     M2MConnectionObserver                       &_observer;
     M2MConnectionSecurity                       *_security_impl; //owned
@@ -321,10 +375,25 @@ private:
      */
     volatile bool                               _suppressable_event_in_flight;
 
-    send_data_list_t                            _linked_list_send_data;
-
     bool                                        _secure_connection;
 
+    // Preallocated ring of outgoing packets, _send_queue_head is the position of the first
+    // record and _send_queue_tail the end of the last one. These must be accessed only
+    // while holding the mutex.
+    uint8_t                                     *_send_queue;
+    uint32_t                                    _send_queue_head;
+    uint32_t                                    _send_queue_tail;
+    uint32_t                                    _send_queue_bytes;
+    uint32_t                                    _send_queue_peak_bytes;
+    uint16_t                                    _send_queue_depth;
+    uint16_t                                    _send_queue_peak_depth;
+    bool                                        _send_event_pending;
+
+    // Receive buffers for MBED_CLIENT_RECEIVE_BATCH_SIZE datagrams, allocated on first use
+    // and freed when the socket is closed
+    uint8_t                                     *_receive_buffers;
+    bool                                        _receive_in_progress;
+
 friend class Test_M2MConnectionHandlerPimpl;
 friend class Test_M2MConnectionHandlerPimpl_mbed;
 friend class Test_M2MConnectionHandlerPimpl_classic;
@@ -84,6 +84,26 @@ void M2MConnectionHandler::release_mutex()
     _private_impl->release_mutex();
 }
 
+uint16_t M2MConnectionHandler::send_queue_depth() const
+{
+    return _private_impl->send_queue_depth();
+}
+
+uint32_t M2MConnectionHandler::send_queue_bytes() const
+{
+    return _private_impl->send_queue_bytes();
+}
+
+uint16_t M2MConnectionHandler::send_queue_peak_depth() const
+{
+    return _private_impl->send_queue_peak_depth();
+}
+
+uint32_t M2MConnectionHandler::send_queue_peak_bytes() const
+{
+    return _private_impl->send_queue_peak_bytes();
+}
+
 void M2MConnectionHandler::force_close()
 {
     _private_impl->force_close();
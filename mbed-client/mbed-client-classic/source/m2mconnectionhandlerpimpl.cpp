@@ -177,7 +177,17 @@ M2MConnectionHandlerPimpl::M2MConnectionHandlerPimpl(M2MConnectionHandler* base,
  _socket_state(ESocketStateDisconnected),
  _handshake_retry(0),
  _suppressable_event_in_flight(false),
- _secure_connection(false)
+ _secure_connection(false),
+ _send_queue((uint8_t*)malloc(MBED_CLIENT_SEND_QUEUE_SIZE)),
+ _send_queue_head(0),
+ _send_queue_tail(0),
+ _send_queue_bytes(0),
+ _send_queue_peak_bytes(0),
+ _send_queue_depth(0),
+ _send_queue_peak_depth(0),
+ _send_event_pending(false),
+ _receive_buffers(NULL),
+ _receive_in_progress(false)
 #if (PAL_DNS_API_VERSION < 2)
  ,_socket_address_len(0)
 #endif
@@ -197,7 +207,9 @@ M2MConnectionHandlerPimpl::M2MConnectionHandlerPimpl(M2MConnectionHandler* base,
     memset((void*)&_socket_address, 0, sizeof _socket_address);
     memset(&_ipV4Addr, 0, sizeof(palIpV4Addr_t));
     memset(&_ipV6Addr, 0, sizeof(palIpV6Addr_t));
-    ns_list_init(&_linked_list_send_data);
+    if (!_send_queue) {
+        tr_error("ConnectionHandler: send queue allocation failed.");
+    }
 
     eventOS_scheduler_mutex_wait();
     if (M2MConnectionHandlerPimpl::_tasklet_id == -1) {
@@ -218,6 +230,8 @@ M2MConnectionHandlerPimpl::~M2MConnectionHandlerPimpl()
 #endif
 
     close_socket();
+    free(_send_queue);
+    free(_receive_buffers);
     delete _security_impl;
     _security_impl = NULL;
     pal_destroy();
@@ -524,55 +538,208 @@ bool M2MConnectionHandlerPimpl::send_data(uint8_t *data,
         return false;
     }
 
-    send_data_queue_s* out_data = (send_data_queue_s*)malloc(sizeof(send_data_queue_s));
-    if (!out_data) {
+    claim_mutex();
+    if (!queue_packet(data, data_len)) {
+        release_mutex();
         return false;
     }
+    // Queued packets are all sent by one event
+    bool post_event = !_send_event_pending;
+    _send_event_pending = true;
+    release_mutex();
+
+    if (post_event && !send_event(ESocketSend)) {
+        // The packet stays queued and goes out with the next send or socket event
+        tr_error("M2MConnectionHandlerPimpl::send_data() - failed to post event");
+        claim_mutex();
+        _send_event_pending = false;
+        release_mutex();
+    }
 
-    memset(out_data, 0, sizeof(send_data_queue_s));
+    return true;
+}
 
-    uint8_t offset = 0;
+bool M2MConnectionHandlerPimpl::queue_packet(const uint8_t *data, uint16_t data_len)
+{
+    uint8_t shim_len = 0;
 #ifdef PAL_NET_TCP_AND_TLS_SUPPORT
     if (is_tcp_connection() && !_secure_connection ) {
-        offset = 4;
+        shim_len = 4;
     }
 #endif
 
-    out_data->data = (uint8_t*)malloc(data_len + offset);
-    if (!out_data->data) {
-        free(out_data);
-        return false;
+    send_queue_record_s record;
+    record.heap_data = NULL;
+    record.data_len = data_len + shim_len;
+    record.offset = 0;
+
+    int32_t position = reserve_queue_record(sizeof(record) + record.data_len);
+    if (position < 0) {
+        // Does not fit in the queue, keep only the record there
+        record.heap_data = (uint8_t*)malloc(record.data_len);
+        if (!record.heap_data) {
+            return false;
+        }
+        position = reserve_queue_record(sizeof(record));
+        if (position < 0) {
+            tr_error("M2MConnectionHandlerPimpl::queue_packet() - queue full");
+            free(record.heap_data);
+            return false;
+        }
     }
 
+    memcpy(_send_queue + position, &record, sizeof(record));
+    uint8_t *out = queue_record_data(position, record);
+
     // TCP non-secure
-    // We need to "shim" the length in front
+    // We need to "shim" the length in front, it is written straight in front of the packet so that
+    // it can be sent with one call without a copy of its own
 #ifdef PAL_NET_TCP_AND_TLS_SUPPORT
-    if (is_tcp_connection() && !_secure_connection ) {
-        out_data->data[0] = 0;
-        out_data->data[1] = 0;
-        out_data->data[2] = (data_len >> 8 ) & 0xff;
-        out_data->data[3] = data_len & 0xff;
+    if (shim_len) {
+        out[0] = 0;
+        out[1] = 0;
+        out[2] = (data_len >> 8 ) & 0xff;
+        out[3] = data_len & 0xff;
     }
 #endif //PAL_NET_TCP_AND_TLS_SUPPORT
+    memcpy(out + shim_len, data, data_len);
 
-    memcpy(out_data->data + offset, data, data_len);
-    out_data->data_len = data_len + offset;
+    _send_queue_depth++;
+    _send_queue_bytes += record.data_len;
+    if (_send_queue_depth > _send_queue_peak_depth) {
+        _send_queue_peak_depth = _send_queue_depth;
+    }
+    if (_send_queue_bytes > _send_queue_peak_bytes) {
+        _send_queue_peak_bytes = _send_queue_bytes;
+    }
+    return true;
+}
 
-    claim_mutex();
-    ns_list_add_to_end(&_linked_list_send_data, out_data);
-    release_mutex();
+int32_t M2MConnectionHandlerPimpl::reserve_queue_record(uint32_t size)
+{
+    if (!_send_queue || size > MBED_CLIENT_SEND_QUEUE_SIZE) {
+        return -1;
+    }
+
+    if (!_send_queue_depth) {
+        // Empty queue, start from the beginning to have the most contiguous room
+        _send_queue_head = 0;
+        _send_queue_tail = size;
+        return 0;
+    }
+
+    uint32_t position = _send_queue_tail;
+    if (_send_queue_tail > _send_queue_head) {
+        if (MBED_CLIENT_SEND_QUEUE_SIZE - _send_queue_tail >= size) {
+            _send_queue_tail += size;
+            return position;
+        }
+        if (_send_queue_head < size) {
+            return -1;
+        }
+        // Wrap around, mark the end of the records if there is room for a record header
+        if (MBED_CLIENT_SEND_QUEUE_SIZE - _send_queue_tail >= sizeof(send_queue_record_s)) {
+            send_queue_record_s end;
+            memset(&end, 0, sizeof(end));
+            memcpy(_send_queue + _send_queue_tail, &end, sizeof(end));
+        }
+        _send_queue_tail = size;
+        return 0;
+    }
+
+    // The tail has wrapped around, the head equals it only when the queue is full
+    if (_send_queue_head - _send_queue_tail < size) {
+        return -1;
+    }
+    _send_queue_tail += size;
+    return position;
+}
 
-    if (!send_event(ESocketSend)) {
-        // Event push failed, free the buffer
+uint32_t M2MConnectionHandlerPimpl::read_queue_record(uint32_t position, send_queue_record_s &record) const
+{
+    if (MBED_CLIENT_SEND_QUEUE_SIZE - position >= sizeof(send_queue_record_s)) {
+        memcpy(&record, _send_queue + position, sizeof(record));
+        if (record.data_len) {
+            return position;
+        }
+    }
+    // Records continue from the beginning of the queue
+    memcpy(&record, _send_queue, sizeof(record));
+    return 0;
+}
+
+uint8_t* M2MConnectionHandlerPimpl::queue_record_data(uint32_t position, const send_queue_record_s &record) const
+{
+    if (record.heap_data) {
+        return record.heap_data;
+    }
+    return _send_queue + position + sizeof(send_queue_record_s);
+}
+
+void M2MConnectionHandlerPimpl::pop_packet()
+{
+    send_queue_record_s record;
+    uint32_t position = read_queue_record(_send_queue_head, record);
+
+    free(record.heap_data);
+    _send_queue_head = position + sizeof(record) + (record.heap_data ? 0 : record.data_len);
+    _send_queue_bytes -= record.data_len;
+    if (!--_send_queue_depth) {
+        _send_queue_head = 0;
+        _send_queue_tail = 0;
+    }
+}
+
+bool M2MConnectionHandlerPimpl::send_queued_datagrams()
+{
+    palSocketBuffer_t buffers[MBED_CLIENT_SEND_BATCH_SIZE];
+    send_queue_record_s record;
+
+    for (;;) {
+        uint32_t count = 0;
         claim_mutex();
-        ns_list_remove(&_linked_list_send_data, out_data);
+        uint32_t position = _send_queue_head;
+        for (; count < _send_queue_depth && count < MBED_CLIENT_SEND_BATCH_SIZE; count++) {
+            position = read_queue_record(position, record);
+            buffers[count].buffer = queue_record_data(position, record);
+            buffers[count].length = record.data_len;
+            position += sizeof(record) + (record.heap_data ? 0 : record.data_len);
+        }
         release_mutex();
-        free(out_data->data);
-        free(out_data);
-        return false;
-    }
 
-    return true;
+        if (!count) {
+            return true;
+        }
+
+        uint32_t sent = 0;
+        palStatus_t ret = pal_sendToBatch(_socket, buffers, count,
+                                          (palSocketAddress_t*)&_socket_address,
+                                          sizeof(_socket_address),
+                                          &sent);
+        if (ret == PAL_ERR_SOCKET_WOULD_BLOCK) {
+            // Return and wait next event
+            return true;
+        }
+        if (ret < 0) {
+            tr_error("M2MConnectionHandlerPimpl::send_queued_datagrams() - failed %d", (int)ret);
+            return false;
+        }
+
+        claim_mutex();
+        for (uint32_t i = 0; i < sent; i++) {
+            pop_packet();
+        }
+        release_mutex();
+
+        for (uint32_t i = 0; i < sent; i++) {
+            _observer.data_sent();
+        }
+
+        if (_socket_state != ESocketStateUnsecureConnection) {
+            // Connection was closed by an observer
+            return true;
+        }
+    }
 }
 
 void M2MConnectionHandlerPimpl::send_socket_data()
@@ -580,75 +747,101 @@ void M2MConnectionHandlerPimpl::send_socket_data()
     tr_debug("M2MConnectionHandlerPimpl::send_socket_data()");
     int bytes_sent = 0;
     bool success = true;
+    send_queue_record_s record;
+
+    claim_mutex();
+    _send_event_pending = false;
+    bool empty = !_send_queue_depth;
+    release_mutex();
 
-    send_data_queue_s* out_data = get_item_from_list();
-    if (!out_data) {
+    if (empty) {
         return;
     }
 
-    if (!out_data->data || !out_data->data_len || _socket_state < ESocketStateUnsecureConnection) {
+    if (_socket_state < ESocketStateUnsecureConnection) {
         tr_warn("M2MConnectionHandlerPimpl::send_socket_data() - too early");
-        add_item_to_list(out_data);
         return;
     }
 
-    // Loop until all the data is sent
-    for (; out_data->offset < out_data->data_len; out_data->offset += bytes_sent) {
-        // Secure send
-        if (_socket_state == ESocketStateSecureConnection) {
-            // TODO! Change the send_message API to take bytes_sent as a out param like the pal send API's.
-            while ((bytes_sent = _security_impl->send_message(out_data->data + out_data->offset,
-                                                            out_data->data_len - out_data->offset)) <= 0) {
-                if (bytes_sent == M2MConnectionHandler::CONNECTION_ERROR_WANTS_WRITE) {
-                    // Return and wait the next event
-                    add_item_to_list(out_data);
-                    return;
-                }
+    const bool datagrams = (_socket_state == ESocketStateUnsecureConnection && !is_tcp_connection());
+    if (datagrams) {
+        success = send_queued_datagrams();
+    }
 
-                if (bytes_sent != M2MConnectionHandler::CONNECTION_ERROR_WANTS_READ) {
-                    tr_error("M2MConnectionHandlerPimpl::send_socket_data() - secure, failed %d", bytes_sent);
-                    success = false;
+    // Loop until all the queued packets are sent
+    while (success && !datagrams && _socket_state >= ESocketStateUnsecureConnection) {
+        claim_mutex();
+        if (!_send_queue_depth) {
+            release_mutex();
+            break;
+        }
+        uint32_t position = read_queue_record(_send_queue_head, record);
+        release_mutex();
+
+        uint8_t *data = queue_record_data(position, record);
+
+        // Loop until all the data is sent
+        for (; record.offset < record.data_len; record.offset += bytes_sent) {
+            // Secure send
+            if (_socket_state == ESocketStateSecureConnection) {
+                // TODO! Change the send_message API to take bytes_sent as a out param like the pal send API's.
+                while ((bytes_sent = _security_impl->send_message(data + record.offset,
+                                                                record.data_len - record.offset)) <= 0) {
+                    if (bytes_sent == M2MConnectionHandler::CONNECTION_ERROR_WANTS_WRITE) {
+                        // Return and wait the next event
+                        memcpy(_send_queue + position, &record, sizeof(record));
+                        return;
+                    }
+
+                    if (bytes_sent != M2MConnectionHandler::CONNECTION_ERROR_WANTS_READ) {
+                        tr_error("M2MConnectionHandlerPimpl::send_socket_data() - secure, failed %d", bytes_sent);
+                        success = false;
+                        break;
+                    }
+                }
+                if (!success) {
                     break;
                 }
             }
-            if (!success) {
-                break;
-            }
-        }
-        // Unsecure send
-        else {
-            bytes_sent = 0;
-            palStatus_t ret;
-            if (is_tcp_connection()) {
+            // Unsecure send
+            else {
+                bytes_sent = 0;
+                palStatus_t ret;
+                if (is_tcp_connection()) {
 #ifdef PAL_NET_TCP_AND_TLS_SUPPORT
-                ret = pal_send(_socket,
-                               out_data->data + out_data->offset,
-                               out_data->data_len - out_data->offset,
-                               (size_t*)&bytes_sent);
+                    ret = pal_send(_socket,
+                                   data + record.offset,
+                                   record.data_len - record.offset,
+                                   (size_t*)&bytes_sent);
 #endif
-            } else {
-                ret = pal_sendTo(_socket,
-                                 out_data->data + out_data->offset,
-                                 out_data->data_len - out_data->offset,
-                                 (palSocketAddress_t*)&_socket_address,
-                                 sizeof(_socket_address),
-                                 (size_t*)&bytes_sent);
-            }
-            if (ret == PAL_ERR_SOCKET_WOULD_BLOCK) {
-                // Return and wait next event
-                add_item_to_list(out_data);
-                return;
-            }
-            if (ret < 0) {
-                tr_error("M2MConnectionHandlerPimpl::send_socket_data() - unsecure failed %d", (int)ret);
-                success = false;
-                break;
+                } else {
+                    ret = pal_sendTo(_socket,
+                                     data + record.offset,
+                                     record.data_len - record.offset,
+                                     (palSocketAddress_t*)&_socket_address,
+                                     sizeof(_socket_address),
+                                     (size_t*)&bytes_sent);
+                }
+                if (ret == PAL_ERR_SOCKET_WOULD_BLOCK) {
+                    // Return and wait next event
+                    memcpy(_send_queue + position, &record, sizeof(record));
+                    return;
+                }
+                if (ret < 0) {
+                    tr_error("M2MConnectionHandlerPimpl::send_socket_data() - unsecure failed %d", (int)ret);
+                    success = false;
+                    break;
+                }
             }
         }
-    }
 
-    free(out_data->data);
-    free(out_data);
+        if (success) {
+            claim_mutex();
+            pop_packet();
+            release_mutex();
+            _observer.data_sent();
+        }
+    }
 
     if (!success) {
         if (bytes_sent == M2MConnectionHandler::SSL_PEER_CLOSE_NOTIFY) {
@@ -658,11 +851,65 @@ void M2MConnectionHandlerPimpl::send_socket_data()
             _observer.socket_error(M2MConnectionHandler::SOCKET_SEND_ERROR, true);
         }
         close_socket();
-    } else {
-        _observer.data_sent();
     }
 }
 
+bool M2MConnectionHandlerPimpl::receive_datagrams()
+{
+#if PAL_NET_RECEIVE_BATCH_SUPPORT
+    palSocketBuffer_t buffers[MBED_CLIENT_RECEIVE_BATCH_SIZE];
+    size_t recv[MBED_CLIENT_RECEIVE_BATCH_SIZE];
+    uint32_t count = 0;
+    palStatus_t status;
+
+    if (!_receive_buffers) {
+        _receive_buffers = (uint8_t*)malloc(MBED_CLIENT_RECEIVE_BATCH_SIZE * BUFFER_LENGTH);
+        if (!_receive_buffers) {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < MBED_CLIENT_RECEIVE_BATCH_SIZE; i++) {
+        buffers[i].buffer = _receive_buffers + i * BUFFER_LENGTH;
+        buffers[i].length = BUFFER_LENGTH;
+    }
+
+    // Observer may close the socket while a buffer is in use, the buffers are freed on return then
+    _receive_in_progress = true;
+    do {
+        status = pal_receiveFromBatch(_socket, buffers, recv, MBED_CLIENT_RECEIVE_BATCH_SIZE, NULL, NULL, &count);
+
+        if (status == PAL_ERR_SOCKET_WOULD_BLOCK) {
+            break;
+        } else if (status != PAL_SUCCESS) {
+            tr_error("M2MConnectionHandlerPimpl::receive_datagrams() - SOCKET_READ_ERROR (%d)", (int)status);
+            _observer.socket_error(M2MConnectionHandler::SOCKET_READ_ERROR, true);
+            close_socket();
+            break;
+        }
+
+        tr_debug("M2MConnectionHandlerPimpl::receive_datagrams() - %" PRIu32 " datagrams received", count);
+
+        // The observer may close the connection, the rest of the datagrams are dropped then
+        for (uint32_t i = 0; i < count && _socket_state == ESocketStateUnsecureConnection; i++) {
+            if (recv[i]) {
+                _observer.data_available((uint8_t*)buffers[i].buffer, recv[i], _address);
+            }
+        }
+    } while (count > 0 && _socket_state == ESocketStateUnsecureConnection);
+    _receive_in_progress = false;
+
+    if (_socket_state != ESocketStateUnsecureConnection) {
+        free(_receive_buffers);
+        _receive_buffers = NULL;
+    }
+    return true;
+#else
+    // Only one datagram per call, receive_handler() reads it to its stack buffer
+    return false;
+#endif
+}
+
 bool M2MConnectionHandlerPimpl::start_listening_for_data()
 {
     return true;
@@ -777,7 +1024,8 @@ void M2MConnectionHandlerPimpl::receive_handler()
             }
         } while (rcv_size > 0 && _socket_state == ESocketStateSecureConnection);
 
-    } else {
+    } else if (is_tcp_connection() || !receive_datagrams()) {
+        // TCP, or UDP without batch receive support or memory for its buffers
         size_t recv;
         palStatus_t status;
         unsigned char recv_buffer[BUFFER_LENGTH];
@@ -918,38 +1166,36 @@ void M2MConnectionHandlerPimpl::close_socket()
     }
 
     claim_mutex();
-    /*ns_list_foreach_safe(M2MConnectionHandlerPimpl::send_data_queue_s, tmp, &_linked_list_send_data) {
-        ns_list_remove(&_linked_list_send_data, tmp);
-        free(tmp->data);
-        free(tmp);
-    }*/
-    // Workaround for IAR compilation issue. ns_list_foreach does not compile with IAR.
-    // Error[Pe144]: a value of type "void *" cannot be used to initialize an entity of type "M2MConnectionHandlerPimpl::send_data_queue *"
-    while (!ns_list_is_empty(&_linked_list_send_data)) {
-        send_data_queue_s* data = (send_data_queue_s*)ns_list_get_first(&_linked_list_send_data);
-        ns_list_remove(&_linked_list_send_data, data);
-        free(data->data);
-        free(data);
+    while (_send_queue_depth) {
+        pop_packet();
     }
+    _send_event_pending = false;
     release_mutex();
+
+    if (!_receive_in_progress) {
+        free(_receive_buffers);
+        _receive_buffers = NULL;
+    }
 }
 
-M2MConnectionHandlerPimpl::send_data_queue_s* M2MConnectionHandlerPimpl::get_item_from_list()
+uint16_t M2MConnectionHandlerPimpl::send_queue_depth() const
 {
-    claim_mutex();
-    send_data_queue_s* out_data = (send_data_queue_s*)ns_list_get_first(&_linked_list_send_data);
-    if (out_data) {
-        ns_list_remove(&_linked_list_send_data, out_data);
-    }
-    release_mutex();
-    return out_data;
+    return _send_queue_depth;
 }
 
-void M2MConnectionHandlerPimpl::add_item_to_list(M2MConnectionHandlerPimpl::send_data_queue_s *data)
+uint32_t M2MConnectionHandlerPimpl::send_queue_bytes() const
 {
-    claim_mutex();
-    ns_list_add_to_start(&_linked_list_send_data, data);
-    release_mutex();
+    return _send_queue_bytes;
+}
+
+uint16_t M2MConnectionHandlerPimpl::send_queue_peak_depth() const
+{
+    return _send_queue_peak_depth;
+}
+
+uint32_t M2MConnectionHandlerPimpl::send_queue_peak_bytes() const
+{
+    return _send_queue_peak_bytes;
 }
 
 void M2MConnectionHandlerPimpl::force_close()
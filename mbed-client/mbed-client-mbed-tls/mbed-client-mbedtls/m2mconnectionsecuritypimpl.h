@@ -119,10 +119,31 @@ public:
      */
     void set_socket(palSocket_t socket, palSocketAddress_t *address);
 
+    /**
+     * \brief Returns the number of handshakes that negotiated a new session.
+     */
+    uint32_t full_handshake_count() const;
+
+    /**
+     * \brief Returns the number of handshakes that resumed the stored session.
+     */
+    uint32_t resumed_handshake_count() const;
+
 private:
 
     int start_handshake();
 
+    /**
+    *  \brief Sets the session stored in the security object to be resumed by the next handshake.
+    *  \return true if a session was set.
+    */
+    bool set_stored_session();
+
+    /**
+    *  \brief Stores the session negotiated by the handshake in the security object.
+    */
+    void store_session();
+
     /**
     *  \brief Returns certificate expiration time in epoch format.
     *  \param certificate, The certificate to be extracted.
@@ -156,6 +177,12 @@ private:
     M2MConnectionSecurity::SecurityMode _sec_mode;
     palTLSSocket_t                      _tls_socket;
     entropy_cb                          _entropy;
+    const M2MSecurity                   *_security; //non-owned
+    uint16_t                            _security_instance_id;
+    uint32_t                            _full_handshakes;
+    uint32_t                            _resumed_handshakes;
+    bool                                _session_set;
+    bool                                _resumption_failed;
 
     friend class Test_M2MConnectionSecurityPimpl;
 };
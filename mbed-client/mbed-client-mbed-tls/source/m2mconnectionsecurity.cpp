@@ -62,3 +62,13 @@ void M2MConnectionSecurity::set_socket(void *socket, void *address)
 {
     _private_impl->set_socket((palSocket_t) socket, (palSocketAddress_t*) address);
 }
+
+uint32_t M2MConnectionSecurity::full_handshake_count() const
+{
+    return _private_impl->full_handshake_count();
+}
+
+uint32_t M2MConnectionSecurity::resumed_handshake_count() const
+{
+    return _private_impl->resumed_handshake_count();
+}
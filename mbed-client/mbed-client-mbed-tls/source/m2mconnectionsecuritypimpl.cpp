@@ -30,6 +30,7 @@
 #include "mbed-client/m2mconnectionhandler.h"
 #include "mbed-client-mbedtls/m2mconnectionsecuritypimpl.h"
 #include "mbed-client/m2msecurity.h"
+#include "mbed-client/m2mresource.h"
 #include "mbed-trace/mbed_trace.h"
 #include "mbed-client/m2mconstants.h"
 #include "pal.h"
@@ -43,7 +44,13 @@ M2MConnectionSecurityPimpl::M2MConnectionSecurityPimpl(M2MConnectionSecurity::Se
     :_init_done(M2MConnectionSecurityPimpl::INIT_NOT_STARTED),
      _conf(0),
      _ssl(0),
-     _sec_mode(mode)
+     _sec_mode(mode),
+     _security(NULL),
+     _security_instance_id(0),
+     _full_handshakes(0),
+     _resumed_handshakes(0),
+     _session_set(false),
+     _resumption_failed(false)
 {
     memset(&_entropy, 0, sizeof(entropy_cb));
     memset(&_tls_socket, 0, sizeof(palTLSSocket_t));
@@ -79,6 +86,9 @@ int M2MConnectionSecurityPimpl::init(const M2MSecurity *security, uint16_t secur
         return -1;
     }
 
+    _security = security;
+    _security_instance_id = security_instance_id;
+
     if(_entropy.entropy_source_ptr) {
         if(PAL_SUCCESS != pal_addEntropySource(_entropy.entropy_source_ptr)){
             return -1;
@@ -190,6 +200,12 @@ int M2MConnectionSecurityPimpl::init(const M2MSecurity *security, uint16_t secur
         return -1;
     }
 
+    // Try an abbreviated handshake first, unless resuming the session failed the last time
+    _session_set = false;
+    if(!_resumption_failed){
+        _session_set = set_stored_session();
+    }
+
     _init_done = M2MConnectionSecurityPimpl::INIT_DONE;
 
 #ifdef MBED_CONF_MBED_TRACE_ENABLE
@@ -218,20 +234,73 @@ int M2MConnectionSecurityPimpl::start_handshake()
         return M2MConnectionHandler::SSL_PEER_CLOSE_NOTIFY;
     }
 
-    if(ret != PAL_SUCCESS){ //We loose the original error here!
+    if(ret == PAL_SUCCESS){
+        ret = pal_sslGetVerifyResult(_ssl);
+        if(PAL_SUCCESS != ret){
+            tr_debug("M2MConnectionSecurityPimpl::start_handshake pal_sslGetVerifyResult() error %" PRId32, ret);
+        }
+    } else { //We loose the original error here!
         tr_debug("M2MConnectionSecurityPimpl::start_handshake pal_handShake() error %" PRId32, ret);
-        return -1;
     }
 
-    ret = pal_sslGetVerifyResult(_ssl);
-    if(PAL_SUCCESS != ret){
-        tr_debug("M2MConnectionSecurityPimpl::start_handshake pal_sslGetVerifyResult() error %" PRId32, ret);
+    if(ret != PAL_SUCCESS){
+        // Do a full handshake on the next attempt in case the server chokes on the offered session
+        _resumption_failed = _session_set;
         return -1;
     }
 
+    bool resumed = false;
+    pal_sslIsSessionResumed(_ssl, &resumed);
+    if(resumed){
+        _resumed_handshakes++;
+    } else {
+        // A resumed session is not stored again to save writes to the storage
+        _full_handshakes++;
+        store_session();
+    }
+    _resumption_failed = false;
+
+    tr_info("M2MConnectionSecurityPimpl::start_handshake - %s handshake, full: %" PRIu32 ", resumed: %" PRIu32,
+            resumed ? "resumed" : "full", _full_handshakes, _resumed_handshakes);
+
     return ret;
 }
 
+bool M2MConnectionSecurityPimpl::set_stored_session()
+{
+    uint8_t session[PAL_TLS_SESSION_MAX_SIZE];
+    uint8_t *session_ptr = (uint8_t *)&session;
+    size_t session_len = sizeof(session);
+
+    if(_security->resource_value_buffer(M2MSecurity::TLSSession, session_ptr, _security_instance_id, &session_len) < 0 ||
+       session_len == 0){
+        return false;
+    }
+
+    if(PAL_SUCCESS != pal_sslSetSession(_ssl, session_ptr, session_len)){
+        tr_warn("M2MConnectionSecurityPimpl::set_stored_session - stored session is not valid");
+        return false;
+    }
+
+    return true;
+}
+
+void M2MConnectionSecurityPimpl::store_session()
+{
+    uint8_t session[PAL_TLS_SESSION_MAX_SIZE];
+    uint32_t session_len = 0;
+
+    // Fails if the server does not support resumption
+    if(PAL_SUCCESS != pal_sslGetSession(_ssl, session, sizeof(session), &session_len)){
+        return;
+    }
+
+    M2MResource *res = _security->get_resource(M2MSecurity::TLSSession, _security_instance_id);
+    if(!res || !res->set_value(session, session_len)){
+        tr_warn("M2MConnectionSecurityPimpl::store_session - failed to store session");
+    }
+}
+
 int M2MConnectionSecurityPimpl::connect(M2MConnectionHandler* connHandler)
 {
     tr_debug("M2MConnectionSecurityPimpl::connect");
@@ -328,6 +397,16 @@ void M2MConnectionSecurityPimpl::set_socket(palSocket_t socket, palSocketAddress
     }
 }
 
+uint32_t M2MConnectionSecurityPimpl::full_handshake_count() const
+{
+    return _full_handshakes;
+}
+
+uint32_t M2MConnectionSecurityPimpl::resumed_handshake_count() const
+{
+    return _resumed_handshakes;
+}
+
 bool M2MConnectionSecurityPimpl::certificate_parse_valid_time(const char *certificate, uint32_t certificate_len, uint64_t *valid_from, uint64_t *valid_to)
 {
     palX509Handle_t cert = 0;
@@ -161,6 +161,25 @@ public:
                                                          and the resource value is not stored anymore in M2MResourceBase. */
     } lwm2m_parameters_s;
 
+    /**
+     * \brief Heap memory held by a part of the object tree in bytes, see get_memory_usage().
+     * Parameters that are not freed with the tree, like pre-built tables, and the overhead
+     * of the allocator are not counted.
+     */
+    typedef struct memory_usage {
+        uint16_t            object_id;          ///< Object ID, set by M2MInterface::get_memory_usage().
+        uint16_t            object_instances;   ///< Number of object instances counted.
+        uint16_t            resources;          ///< Number of resources counted.
+        uint16_t            resource_instances; ///< Number of resource instances counted.
+        size_t              nodes;              ///< Object, instance and resource classes and their lists.
+        size_t              names;              ///< Names, paths, resource types and interface descriptions.
+        size_t              lwm2m_parameters;   ///< lwm2m_parameters_s structures.
+        size_t              nsdl_parameters;    ///< sn_nsdl static and dynamic resource parameters.
+        size_t              values;             ///< Resource values and received block data.
+        size_t              report_handlers;    ///< Report handlers, excluding tokens.
+        size_t              tokens;             ///< Observation tokens.
+    } memory_usage_s;
+
 protected:
 
     // Prevents the use of default constructor.
@@ -524,6 +543,21 @@ public:
      */
     bool set_notification_delivery_status_cb(notification_delivery_status_cb callback, void *client_args);
 
+    /**
+     * @brief Adds the heap memory held by this object and everything below it in the
+     * object tree to the given counters. Counters are not cleared first, so usage of
+     * several objects can be summed up.
+     * @param usage Counters to add to.
+     */
+    virtual void get_memory_usage(memory_usage_s &usage) const;
+
+    /**
+     * @brief Returns the sum of all the byte counters of the given usage.
+     * @param usage Memory usage.
+     * @return Total number of bytes.
+     */
+    static size_t memory_usage_total(const memory_usage_s &usage);
+
 #ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
     static char* create_path(const M2MEndpoint &parent, const char *name);
 #endif
@@ -607,6 +641,14 @@ protected:
 
     static char* stringdup(const char* s);
 
+    /**
+     * \brief Adds the memory held by this object, excluding the objects below it,
+     * to the given counters.
+     * \param usage Counters to add to.
+     * \param node_size Size of the class of the object and its lists.
+     */
+    void add_memory_usage(memory_usage_s &usage, size_t node_size) const;
+
     /**
      * \brief Delete the resource structures owned by this object. Note: this needs
      * to be called separately from each subclass' destructor as this method uses a
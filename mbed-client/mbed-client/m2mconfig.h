@@ -127,6 +127,26 @@ using namespace m2m;
 #define MBED_CLIENT_DTLS_PEER_MAX_TIMEOUT MBED_CONF_MBED_CLIENT_DTLS_PEER_MAX_TIMEOUT
 #endif
 
+#ifdef MBED_CONF_MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL
+#define MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL MBED_CONF_MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL
+#endif
+
+#ifdef MBED_CONF_MBED_CLIENT_COMPOSITE_NOTIFICATION_MAX_PAYLOAD
+#define MBED_CLIENT_COMPOSITE_NOTIFICATION_MAX_PAYLOAD MBED_CONF_MBED_CLIENT_COMPOSITE_NOTIFICATION_MAX_PAYLOAD
+#endif
+
+#ifdef MBED_CONF_MBED_CLIENT_SEND_QUEUE_SIZE
+#define MBED_CLIENT_SEND_QUEUE_SIZE MBED_CONF_MBED_CLIENT_SEND_QUEUE_SIZE
+#endif
+
+#ifdef MBED_CONF_MBED_CLIENT_SEND_BATCH_SIZE
+#define MBED_CLIENT_SEND_BATCH_SIZE MBED_CONF_MBED_CLIENT_SEND_BATCH_SIZE
+#endif
+
+#ifdef MBED_CONF_MBED_CLIENT_RECEIVE_BATCH_SIZE
+#define MBED_CLIENT_RECEIVE_BATCH_SIZE MBED_CONF_MBED_CLIENT_RECEIVE_BATCH_SIZE
+#endif
+
 
 #if defined (__ICCARM__)
 #define m2m_deprecated
@@ -191,4 +211,34 @@ typedef struct mbedtls_entropy {
 #define MBED_CLIENT_DTLS_PEER_MAX_TIMEOUT 80000
 #endif
 
+/*
+ * Flush window of composite notifications in milliseconds. When non-zero, resource
+ * notifications which become pending within the window are sent together in one
+ * notification, carried by the observation of the first one. 0 disables the feature.
+ */
+#ifndef MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL
+#define MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL 0
+#endif
+
+// Maximum payload size of a composite notification, the rest is sent in the next one
+#ifndef MBED_CLIENT_COMPOSITE_NOTIFICATION_MAX_PAYLOAD
+#define MBED_CLIENT_COMPOSITE_NOTIFICATION_MAX_PAYLOAD 1024
+#endif
+
+// Size of the preallocated queue of outgoing packets in bytes, a packet which does not fit is allocated from heap
+#ifndef MBED_CLIENT_SEND_QUEUE_SIZE
+#define MBED_CLIENT_SEND_QUEUE_SIZE 2048
+#endif
+
+// Maximum number of queued datagrams passed to the socket in one call
+#ifndef MBED_CLIENT_SEND_BATCH_SIZE
+#define MBED_CLIENT_SEND_BATCH_SIZE 8
+#endif
+
+// Maximum number of datagrams read from the socket in one call, each of them takes a receive buffer of BUFFER_LENGTH bytes,
+// used only if the platform supports batch receive (PAL_NET_RECEIVE_BATCH_SUPPORT)
+#ifndef MBED_CLIENT_RECEIVE_BATCH_SIZE
+#define MBED_CLIENT_RECEIVE_BATCH_SIZE 4
+#endif
+
 #endif // M2MCONFIG_H
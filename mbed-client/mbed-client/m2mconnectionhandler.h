@@ -144,6 +144,26 @@ public:
     */
     void release_mutex();
 
+    /**
+    * \brief Returns the number of packets waiting to be sent.
+    */
+    uint16_t send_queue_depth() const;
+
+    /**
+    * \brief Returns the number of bytes waiting to be sent.
+    */
+    uint32_t send_queue_bytes() const;
+
+    /**
+    * \brief Returns the highest number of packets which have been waiting to be sent at the same time.
+    */
+    uint16_t send_queue_peak_depth() const;
+
+    /**
+    * \brief Returns the highest number of bytes which have been waiting to be sent at the same time.
+    */
+    uint32_t send_queue_peak_bytes() const;
+
 private:
 
     M2MConnectionObserver                       &_observer;
@@ -132,6 +132,17 @@ public:
      */
     void set_socket(void *socket, void *address);
 
+    /**
+     * \brief Returns the number of secure handshakes that negotiated a new session.
+     */
+    uint32_t full_handshake_count() const;
+
+    /**
+     * \brief Returns the number of secure handshakes that resumed the session
+     * stored by an earlier connection, skipping the key exchange.
+     */
+    uint32_t resumed_handshake_count() const;
+
 private:
 
     M2MConnectionSecurityPimpl* _private_impl;
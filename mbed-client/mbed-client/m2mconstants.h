@@ -132,6 +132,7 @@ extern const String EMPTY;
 #define SECURITY_OPEN_CERTIFICATE_CHAIN  "12"
 #define SECURITY_CLOSE_CERTIFICATE_CHAIN  "13"
 #define SECURITY_READ_CERTIFICATE_CHAIN  "14"
+#define SECURITY_TLS_SESSION  "15"
 
 //SERVER RESOURCES
 #define SERVER_PATH_PREFIX "1/0/"
@@ -238,6 +239,8 @@ const uint8_t COAP_CONTENT_OMA_TLV_TYPE_OLD = 99;
 const uint16_t COAP_CONTENT_OMA_TLV_TYPE = 11542;
 const uint16_t COAP_CONTENT_OMA_JSON_TYPE = 11543;
 const uint8_t COAP_CONTENT_OMA_OPAQUE_TYPE = 42;
+const uint8_t COAP_CONTENT_SENML_JSON_TYPE = 110;
+const uint8_t COAP_CONTENT_SENML_CBOR_TYPE = 112;
 
 const uint16_t MAX_UNINT_16_COUNT = 65535;
 
@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include "mbed-client/m2mvector.h"
 #include "mbed-client/m2mconfig.h"
+#include "mbed-client/m2mbase.h"
 #include "mbed-client/functionpointer.h"
 
 //FORWARD DECLARATION
@@ -338,6 +339,15 @@ public:
      * @return False if maximum length exceeded otherwise True.
     */
     virtual bool set_uri_query_parameters(const char *uri_query_params) = 0;
+
+    /**
+     * @brief Collects the heap memory held by the registered object tree, aggregated
+     * per object. Pass a NULL array to get the number of objects only.
+     * @param usage Array filled with one entry per object, in registration order.
+     * @param count Number of entries in the array.
+     * @return Number of registered objects, entries beyond count are not written.
+     */
+    virtual uint16_t get_memory_usage(M2MBase::memory_usage_s *usage, uint16_t count) = 0;
 };
 
 #endif // M2M_INTERFACE_H
@@ -20,6 +20,7 @@
 #include "mbed-client/m2msecurity.h"
 #include "mbed-client/m2mresource.h"
 #include "mbed-client/m2minterfaceobserver.h"
+#include "mbed-client/m2mstaticobject.h"
 
 //FORWARD DECLARATION
 class M2MDevice;
@@ -111,6 +112,16 @@ public:
      */
     static M2MObject *create_object(const String &name);
 
+    /**
+     * \brief Creates a whole object tree from pre-built parameter tables in one pass.
+     * Names, paths and static resource parameters are referenced from the tables, not copied.
+     * The tables must outlive the object and can be instantiated only once at a time.
+     * \param definition The object definition, see m2mstaticobject.h.
+     * \return M2MObject The object with all its object instances and resources, or NULL if
+     * the definition is invalid.
+     */
+    static M2MObject *create_object(const m2m_static_object_s &definition);
+
 #ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
     /**
      * \brief Creates a endpoint object for the mbed Client Inteface. With this, the
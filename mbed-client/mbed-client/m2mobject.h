@@ -19,6 +19,7 @@
 #include "mbed-client/m2mvector.h"
 #include "mbed-client/m2mbase.h"
 #include "mbed-client/m2mobjectinstance.h"
+#include "mbed-client/m2mstaticobject.h"
 
 //FORWARD DECLARATION
 typedef Vector<M2MObjectInstance *> M2MObjectInstanceList;
@@ -112,6 +113,12 @@ public:
      */
     uint16_t instance_count() const;
 
+    /**
+     * \brief Adds the heap memory held by the object and its object instances to the given counters.
+     * \param usage Counters to add to.
+     */
+    virtual void get_memory_usage(memory_usage_s &usage) const;
+
     /**
      * \brief Returns the Observation Handler object.
      * \return M2MObservationHandler object.
@@ -179,6 +186,26 @@ public:
 
     void notification_update(uint16_t obj_instance_id);
 
+    /**
+     * \brief Starts an update transaction covering all the instances of the object.
+     * Value changes are not reported until the matching commit_transaction().
+     * Transactions can be nested, changes are reported on the outermost commit.
+     */
+    void begin_transaction();
+
+    /**
+     * \brief Ends an update transaction. On the outermost commit the value changes of each
+     * object instance are reported as in M2MObjectInstance::commit_transaction(), except for
+     * instances still in their own transaction which are reported when it is committed.
+     */
+    void commit_transaction();
+
+    /**
+     * \brief Returns whether an update transaction of the object is ongoing.
+     * \return True if value changes are deferred, else false.
+     */
+    bool is_in_transaction() const;
+
 #ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
     void set_endpoint(M2MEndpoint *endpoint);
 
@@ -191,6 +218,17 @@ protected :
      */
     virtual M2MBase *get_parent() const;
 
+private:
+
+    /**
+     * \brief Creates the object instances and their resources from pre-built tables.
+     * Used by M2MInterfaceFactory, the ids in the tables are expected to be unique so
+     * no lookups are done while loading.
+     * \param instances Object instance definitions.
+     * \param count Number of object instance definitions.
+     */
+    void add_static_object_instances(const m2m_static_object_instance_s *instances, uint16_t count);
+
 private:
 
     M2MObjectInstanceList     _instance_list; // owned
@@ -201,6 +239,8 @@ private:
     M2MEndpoint              *_endpoint; // Parent endpoint
 #endif
 
+    uint8_t                  _transaction_depth;
+
 friend class Test_M2MObject;
 friend class Test_M2MEndpoint;
 friend class Test_M2MInterfaceImpl;
@@ -25,6 +25,9 @@ typedef Vector<M2MResourceInstance *> M2MResourceInstanceList;
 
 
 class M2MObject;
+#ifndef DISABLE_BLOCK_MESSAGE
+class M2MTLVStreamDeserializer;
+#endif
 
 /*! \file m2mobjectinstance.h
  *  \brief M2MObjectInstance.
@@ -210,6 +213,12 @@ public:
      */
     uint16_t resource_count() const;
 
+    /**
+     * \brief Adds the heap memory held by the object instance and its resources to the given counters.
+     * \param usage Counters to add to.
+     */
+    virtual void get_memory_usage(memory_usage_s &usage) const;
+
     /**
      * \brief Returns the total number of single resource instances.
      * Note: this will be removed in next version, please use the
@@ -295,6 +304,27 @@ public:
     // callback used from M2MResource/M2MResourceInstance
     void notification_update(M2MBase::Observation observation_level);
 
+    /**
+     * \brief Starts an update transaction. Value changes of the resources of this
+     * object instance are not reported until the matching commit_transaction().
+     * Transactions can be nested, changes are reported on the outermost commit.
+     */
+    void begin_transaction();
+
+    /**
+     * \brief Ends an update transaction. On the outermost commit the value changes made
+     * during the transaction are reported to the observers of the resources, followed by
+     * at most one notification to the observers of this object instance and its object.
+     * Notifications are still subject to pmin and pmax of the observers.
+     */
+    void commit_transaction();
+
+    /**
+     * \brief Returns whether an update transaction of this object instance or its object is ongoing.
+     * \return True if value changes are deferred, else false.
+     */
+    bool is_in_transaction() const;
+
 protected:
     virtual M2MBase *get_parent() const;
 
@@ -308,12 +338,31 @@ private:
      */
     M2MBase::DataType convert_resource_type(M2MResourceInstance::ResourceType);
 
+    /**
+     * \brief Reports the value changes deferred by an update transaction, followed by
+     * a single object instance level notification if anything changed.
+     */
+    void report_pending_changes();
+
+    /**
+     * \brief Creates resources from a pre-built table without checking for duplicates.
+     * \param resources Resource parameters.
+     * \param count Number of resources.
+     */
+    void add_static_resources(const lwm2m_parameters_s *resources, uint16_t count);
+
 private:
 
     M2MObject      &_parent;
 
     M2MResourceList     _resource_list; // owned
 
+    uint8_t             _transaction_depth;
+
+#ifndef DISABLE_BLOCK_MESSAGE
+    M2MTLVStreamDeserializer *_tlv_stream; // owned, TLV payload received in blocks
+#endif
+
     friend class Test_M2MObjectInstance;
     friend class Test_M2MObject;
     friend class Test_M2MDevice;
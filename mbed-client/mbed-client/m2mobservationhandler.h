@@ -19,6 +19,8 @@
 //FORWARD DECLARATION
 class M2MBase;
 class M2MResourceInstance;
+class M2MReportQueue;
+class M2MReportTimerWheel;
 
 /*! \file m2mobservationhandler.h
  * \brief M2MObservationHandler.
@@ -65,6 +67,18 @@ class M2MObservationHandler
      */
     virtual void remove_object(M2MBase *object) = 0;
 
+    /**
+     * \brief Returns the queue of the report handlers which have a notification pending.
+     * \return The queue kept by the handler.
+     */
+    virtual M2MReportQueue *report_queue() = 0;
+
+    /**
+     * \brief Returns the timer wheel driving the pmin and pmax timers of the report handlers.
+     * \return The timer wheel kept by the handler.
+     */
+    virtual M2MReportTimerWheel *report_timer_wheel() = 0;
+
 #ifndef DISABLE_DELAYED_RESPONSE
     /**
      * \brief A delayed response callback to be sent to the
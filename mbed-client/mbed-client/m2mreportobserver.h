@@ -19,6 +19,9 @@
 #include <inttypes.h>
 #include <mbed-client/m2mvector.h>
 
+//FORWARD DECLARATION
+class M2MObservationHandler;
+
 /*! \file m2mreportobserver.h
  * \brief M2MReportObserver.
  * An interface for inviting the base class
@@ -42,6 +45,12 @@ class M2MReportObserver
                                         uint16_t obs_number,
                                         bool send_object = false) = 0;
 
+    /**
+     * \brief Returns the handler which sends the observation callbacks to the server.
+     * \return The handler, NULL if the observer is not registered to one.
+     */
+    virtual M2MObservationHandler* observation_handler() const = 0;
+
 };
 
 #endif // M2MREPORTOBSERVER_H
@@ -176,6 +176,12 @@ public:
      */
     uint16_t resource_instance_count() const;
 
+    /**
+     * \brief Adds the heap memory held by the resource and its resource instances to the given counters.
+     * \param usage Counters to add to.
+     */
+    virtual void get_memory_usage(memory_usage_s &usage) const;
+
     /**
      * \brief Returns the value set for delayed response.
      * \return The value for delayed response.
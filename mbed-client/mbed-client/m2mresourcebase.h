@@ -171,6 +171,12 @@ protected: // Constructor and destructor are private
      */
     virtual ~M2MResourceBase();
 
+    /**
+     * \brief Adds the memory held by the value of the resource to the given counters.
+     * \param usage Counters to add to.
+     */
+    void add_value_memory_usage(memory_usage_s &usage) const;
+
 public:
 
     /**
@@ -471,21 +477,66 @@ public:
 
 private:
 
-    void report();
+    /*
+     * \brief Reports the current value to observers. While the parent object instance is
+     * in an update transaction the report is only marked as pending.
+     * \param notify_instance If false, object and object instance level observers are
+     * left for the caller to notify.
+     */
+    void report(bool notify_instance = true);
+
+    void report_value_change(bool notify_instance = true);
 
-    void report_value_change();
+    /*
+     * \brief Reports a change deferred by an update transaction, leaving the object instance
+     * level notification to the caller.
+     * \return True if a change was pending.
+     */
+    bool report_pending_change();
 
     bool has_value_changed(const uint8_t* value, const uint32_t value_len);
 
     M2MResourceBase::ResourceType convert_data_type(M2MBase::DataType type) const;
 
+    typedef enum {
+        NATIVE_VALUE_NONE = 0,  // Value is stored only as text in nsdl resource.
+        NATIVE_VALUE_INT,
+        NATIVE_VALUE_FLOAT
+    } NativeValueType;
+
+    /*
+     * \brief Checks whether a numeric value can be kept in native form. Not possible if the value
+     * is handed over to application callbacks, is read directly by the nsdl library
+     * (static resources or value published in registration) or if resource is not numeric.
+     */
+    bool can_store_native_value() const;
+
+    /*
+     * \brief Stores numeric value in native form, the text representation is rendered only when needed.
+     * Change is detected by comparing the numbers.
+     */
+    void set_native_value(NativeValueType type, int64_t int_value, float float_value);
+
+    /*
+     * \brief Renders the native value into text representation of the nsdl resource, if not yet done.
+     */
+    void render_native_value() const;
+
 private:
 
 #ifndef DISABLE_BLOCK_MESSAGE
     M2MBlockMessage     *_block_message_data;
 #endif
 
+    union {
+        int64_t         _int;
+        float           _float;
+    }                     _native_value;
+
     NotificationStatus    _notification_status : 2;
+    NativeValueType       _native_value_type : 2;
+    mutable bool          _native_value_rendered : 1;
+    bool                  _report_pending : 1;
 
     friend class Test_M2MResourceInstance;
     friend class Test_M2MResource;
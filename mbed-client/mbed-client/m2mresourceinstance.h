@@ -144,6 +144,12 @@ public:
      */
     virtual M2MResource& get_parent_resource() const;
 
+    /**
+     * \brief Adds the heap memory held by the resource instance to the given counters.
+     * \param usage Counters to add to.
+     */
+    virtual void get_memory_usage(memory_usage_s &usage) const;
+
 private:
 
     // Parent resource which owns this resource instance
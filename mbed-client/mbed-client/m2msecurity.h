@@ -54,7 +54,8 @@ public:
         ClientHoldOffTime,
         OpenCertificateChain,
         CloseCertificateChain,
-        ReadDeviceCertificateChain
+        ReadDeviceCertificateChain,
+        TLSSession
     } SecurityResource;
 
     /**
@@ -197,7 +198,7 @@ public:
      * \brief Populates the data buffer and returns the size of the buffer.
      * \param resource With this function, the following resources can return a value:
      * 'PublicKey', 'ServerPublicKey', 'Secretkey',
-     * 'OpenCertificateChain', 'CloseCertificateChain' 'ReadDeviceCertificateChain'.
+     * 'OpenCertificateChain', 'CloseCertificateChain' 'ReadDeviceCertificateChain', 'TLSSession'.
      * \param [OUT]data A copy of the data buffer that contains the value. The caller
      * is responsible for freeing this buffer.
      * \param instance_id Instance id of the security instance where resource value should be retrieve.
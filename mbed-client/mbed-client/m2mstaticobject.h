@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_STATIC_OBJECT_H
+#define M2M_STATIC_OBJECT_H
+
+#include "mbed-client/m2mbase.h"
+
+/*! \file m2mstaticobject.h
+ *  \brief Table definitions of pre-built LWM2M object trees.
+ *
+ *  The tables are normally produced by tools/m2m_static_object_generator.py from an
+ *  object model description and instantiated in one pass by
+ *  M2MInterfaceFactory::create_object(const m2m_static_object_s &).
+ *  Names, paths and the static resource parameters are referenced, not copied, so they
+ *  can be placed in ROM. The dynamic resource parameters hold the runtime state of the
+ *  resources and must be in RAM, which also means a table can be instantiated only once
+ *  at a time.
+ */
+
+// The static resource parameters can be put into flash only with MEMORY_OPTIMIZED_API,
+// otherwise the old API may modify them.
+#ifdef MEMORY_OPTIMIZED_API
+#define M2M_STATIC_PARAM_TYPE const
+#else
+#define M2M_STATIC_PARAM_TYPE
+#endif
+
+// Initializer for the attribute fields of sn_nsdl_static_resource_parameters_s
+// when the resource has no resource type nor interface description.
+#ifndef RESOURCE_ATTRIBUTES_LIST
+#ifndef DISABLE_RESOURCE_TYPE
+#define M2M_STATIC_NO_RESOURCE_TYPE NULL,
+#else
+#define M2M_STATIC_NO_RESOURCE_TYPE
+#endif
+#ifndef DISABLE_INTERFACE_DESCRIPTION
+#define M2M_STATIC_NO_INTERFACE_DESCRIPTION NULL,
+#else
+#define M2M_STATIC_NO_INTERFACE_DESCRIPTION
+#endif
+#define M2M_STATIC_NO_ATTRIBUTES M2M_STATIC_NO_RESOURCE_TYPE M2M_STATIC_NO_INTERFACE_DESCRIPTION
+#else
+#define M2M_STATIC_NO_ATTRIBUTES NULL,
+#endif
+
+/**
+ * \brief Defines an object instance and its resources.
+ */
+typedef struct m2m_static_object_instance {
+    M2MBase::lwm2m_parameters_s         *params;            /**< Instance parameters, identifier is set by the loader */
+    uint16_t                            instance_id;        /**< Object instance id */
+    uint16_t                            resource_count;     /**< Number of entries in resources */
+    const M2MBase::lwm2m_parameters_s   *resources;         /**< Resource parameters, base_type must be M2MBase::Resource */
+} m2m_static_object_instance_s;
+
+/**
+ * \brief Defines an object and its object instances.
+ */
+typedef struct m2m_static_object {
+    const M2MBase::lwm2m_parameters_s   *params;            /**< Object parameters, base_type must be M2MBase::Object */
+    uint16_t                            instance_count;     /**< Number of entries in instances */
+    const m2m_static_object_instance_s  *instances;         /**< Object instances */
+} m2m_static_object_s;
+
+#endif // M2M_STATIC_OBJECT_H
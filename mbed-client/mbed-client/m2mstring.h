@@ -29,9 +29,14 @@ namespace m2m
    */
   class String
   {
-    char* p;           ///< The data.
+    enum {
+        INLINE_SIZE = 8 ///< Strings shorter than this are stored in the object itself.
+    };
+
+    char* p;           ///< The data, points to inline_ or to heap memory.
     size_t allocated_;  ///< The allocated memory size (including trailing NULL).
     size_t size_;       ///< The currently used memory size (excluding trailing NULL).
+    char inline_[INLINE_SIZE]; ///< Storage of short strings, avoids heap allocation of most names.
 
   public:
     typedef size_t size_type;
@@ -117,8 +122,10 @@ namespace m2m
 
   private:
     // reallocate the internal memory
-    void new_realloc( size_type n);
-    char* strdup(const char* other);
+    bool new_realloc( size_type n);
+    // set the initial content, used by constructors
+    void init(const char* str, size_type n);
+    bool is_inline() const { return p == inline_; }
 
     friend class ::Test_M2MString;
 
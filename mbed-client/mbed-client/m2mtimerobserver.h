@@ -37,7 +37,9 @@ public:
         QueueSleep,
         RetryTimer,
         BootstrapFlowTimer,
-        RegistrationFlowTimer
+        RegistrationFlowTimer,
+        ReportTimerWheel,
+        CompositeNotification
     }Type;
 
     /**
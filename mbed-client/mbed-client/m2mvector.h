@@ -21,10 +21,41 @@
 * \brief A simple C++ Vector class, used as replacement for std::vector.
 */
 
+#include <stdlib.h> // malloc, realloc, free
+#include <string.h> // memmove
+#include <new>      // placement new
 
 namespace m2m
 {
 
+/**
+ * Tells whether an object can be moved to another address with a plain memory copy,
+ * without running its copy constructor and destructor. Vector grows with realloc()
+ * and shifts elements with memmove() for such types. True for pointers and arithmetic
+ * types, can be specialised for other types that do not point into themselves.
+ */
+template <typename T> struct is_trivially_relocatable { enum { value = false }; };
+template <typename T> struct is_trivially_relocatable<T*> { enum { value = true }; };
+template <> struct is_trivially_relocatable<bool> { enum { value = true }; };
+template <> struct is_trivially_relocatable<char> { enum { value = true }; };
+template <> struct is_trivially_relocatable<signed char> { enum { value = true }; };
+template <> struct is_trivially_relocatable<unsigned char> { enum { value = true }; };
+template <> struct is_trivially_relocatable<short> { enum { value = true }; };
+template <> struct is_trivially_relocatable<unsigned short> { enum { value = true }; };
+template <> struct is_trivially_relocatable<int> { enum { value = true }; };
+template <> struct is_trivially_relocatable<unsigned int> { enum { value = true }; };
+template <> struct is_trivially_relocatable<long> { enum { value = true }; };
+template <> struct is_trivially_relocatable<unsigned long> { enum { value = true }; };
+template <> struct is_trivially_relocatable<long long> { enum { value = true }; };
+template <> struct is_trivially_relocatable<unsigned long long> { enum { value = true }; };
+template <> struct is_trivially_relocatable<float> { enum { value = true }; };
+template <> struct is_trivially_relocatable<double> { enum { value = true }; };
+
+/**
+ * Only the elements in [0, size()) are constructed, the storage is allocated on the first
+ * insertion. If an allocation fails the vector is left unchanged and push_back() drops
+ * the element.
+ */
 template <typename ObjectTemplate>
 
 class Vector
@@ -32,27 +63,31 @@ class Vector
   public:
     explicit Vector( int init_size = MIN_CAPACITY)
             : _size(0),
-              _capacity((init_size >= MIN_CAPACITY) ? init_size : MIN_CAPACITY) {
-        _object_template = new ObjectTemplate[ _capacity ];
+              _capacity(0),
+              _object_template(0) {
+        if(init_size > MIN_CAPACITY) {
+            reserve(init_size);
+        }
     }
 
-    Vector(const Vector & rhs ): _object_template(0) {
+    Vector(const Vector & rhs ): _size(0), _capacity(0), _object_template(0) {
         operator=(rhs);
     }
- 
+
     ~Vector() {
-        delete [] _object_template;
+        clear();
+        free(_object_template);
     }
 
     const Vector & operator=(const Vector & rhs) {
         if(this != &rhs) {
-            delete[] _object_template;
-            _size = rhs.size();
-            _capacity = rhs._capacity;
-
-            _object_template = new ObjectTemplate[capacity()];
-            for(int k = 0; k < size(); k++) {
-                _object_template[k] = rhs._object_template[k];
+            clear();
+            reserve(rhs.size());
+            if(_capacity >= rhs.size()) {
+                for(int k = 0; k < rhs.size(); k++) {
+                    new (&_object_template[k]) ObjectTemplate(rhs._object_template[k]);
+                }
+                _size = rhs.size();
             }
         }
         return *this;
@@ -61,22 +96,44 @@ class Vector
     void resize(int new_size) {
         if(new_size > _capacity) {
             reserve(new_size * 2 + 1);
+            if(new_size > _capacity) {
+                return;
+            }
+        }
+        for(int k = _size; k < new_size; k++) {
+            new (&_object_template[k]) ObjectTemplate();
+        }
+        for(int k = new_size; k < _size; k++) {
+            _object_template[k].~ObjectTemplate();
         }
         _size = new_size;
     }
 
     void reserve(int new_capacity) {
-        if(new_capacity < _size) {
+        if(new_capacity <= _capacity) {
             return;
         }
-        ObjectTemplate *old_array = _object_template;
 
-        _object_template = new ObjectTemplate[new_capacity];
-        for(int k = 0; k < _size; k++) {
-            _object_template[k] = old_array[k];
+        ObjectTemplate *new_array;
+        if(is_trivially_relocatable<ObjectTemplate>::value) {
+            // May grow in place, otherwise realloc copies the bytes
+            new_array = static_cast<ObjectTemplate*>(realloc(_object_template, new_capacity * sizeof(ObjectTemplate)));
+            if(!new_array) {
+                return;
+            }
+        } else {
+            new_array = static_cast<ObjectTemplate*>(malloc(new_capacity * sizeof(ObjectTemplate)));
+            if(!new_array) {
+                return;
+            }
+            for(int k = 0; k < _size; k++) {
+                new (&new_array[k]) ObjectTemplate(_object_template[k]);
+                _object_template[k].~ObjectTemplate();
+            }
+            free(_object_template);
         }
+        _object_template = new_array;
         _capacity = new_capacity;
-        delete [] old_array;
     }
 
     ObjectTemplate & operator[](int idx) {
@@ -101,17 +158,28 @@ class Vector
 
     void push_back(const ObjectTemplate& x) {
         if(_size == _capacity) {
+            // x may refer to an element of this vector, copy it before the storage moves
+            ObjectTemplate copy(x);
             reserve(2 * _capacity + 1);
+            if(_size == _capacity) {
+                return;
+            }
+            new (&_object_template[_size]) ObjectTemplate(copy);
+        } else {
+            new (&_object_template[_size]) ObjectTemplate(x);
         }
-        _object_template[_size] = x;
         _size++;
     }
 
     void pop_back() {
         _size--;
+        _object_template[_size].~ObjectTemplate();
     }
 
     void clear() {
+        for(int k = 0; k < _size; k++) {
+            _object_template[k].~ObjectTemplate();
+        }
         _size = 0;
     }
 
@@ -123,27 +191,50 @@ class Vector
     typedef const ObjectTemplate* const_iterator;
 
     iterator begin() {
-        return &_object_template[0];
+        return _object_template;
     }
 
     const_iterator begin() const {
-        return &_object_template[0];
+        return _object_template;
     }
 
     iterator end() {
-        return &_object_template[_size];
+        return _object_template + _size;
     }
 
     const_iterator end() const {
-        return &_object_template[_size];
+        return _object_template + _size;
     }
 
+    /**
+     * Removes the element and keeps the order of the rest, O(n).
+     */
     void erase(int position) {
         if(position < _size) {
-            for(int k = position; k + 1 < _size; k++) {
-                _object_template[k] = _object_template[k + 1];
+            if(is_trivially_relocatable<ObjectTemplate>::value) {
+                _object_template[position].~ObjectTemplate();
+                memmove(&_object_template[position], &_object_template[position + 1],
+                        (_size - position - 1) * sizeof(ObjectTemplate));
+                _size--;
+            } else {
+                for(int k = position; k + 1 < _size; k++) {
+                    _object_template[k] = _object_template[k + 1];
+                }
+                pop_back();
+            }
+        }
+    }
+
+    /**
+     * Removes the element by moving the last element in its place, O(1).
+     * Use when the order of the elements does not matter.
+     */
+    void erase_unordered(int position) {
+        if(position < _size) {
+            if(position + 1 < _size) {
+                _object_template[position] = _object_template[_size - 1];
             }
-            _size--;
+            pop_back();
         }
     }
 
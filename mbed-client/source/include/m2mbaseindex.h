@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef M2MBASEINDEX_H
+#define M2MBASEINDEX_H
+
+#include "ns_types.h"
+
+class M2MBase;
+
+/**
+ * @brief M2MBaseIndex
+ * Side index used by M2MNsdlInterface to map an URI path or an outstanding
+ * notification message id to the M2MBase owning it without walking the object tree.
+ * Both maps are open addressing hash tables with linear probing.
+ */
+class M2MBaseIndex {
+
+private:
+    // Prevents the use of assignment operator by accident.
+    M2MBaseIndex& operator=( const M2MBaseIndex& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MBaseIndex( const M2MBaseIndex& /*other*/ );
+
+public:
+
+    M2MBaseIndex();
+
+    ~M2MBaseIndex();
+
+    /**
+     * @brief Adds the object to the path index, using M2MBase::uri_path() as the key.
+     * Adding an already indexed object is a no-op.
+     * @param base Object to be added.
+     * @return true if object is indexed, false on allocation failure.
+     */
+    bool add_path(M2MBase *base);
+
+    /**
+     * @brief Stores the message id of the notification sent for the object.
+     * Any previous message id of the object is dropped from the index.
+     * @param base Object whose notification was sent.
+     * @param msg_id Message id of the notification.
+     */
+    void set_notification_msgid(M2MBase *base, uint16_t msg_id);
+
+    /**
+     * @brief Removes the object from both indexes.
+     * Must be called before the path of the object is released.
+     * @param base Object to be removed.
+     */
+    void remove(M2MBase *base);
+
+    /**
+     * @brief Finds object by its URI path.
+     * @param path URI path without leading '/'.
+     * @return Object or NULL if not found.
+     */
+    M2MBase *find_by_path(const char *path) const;
+
+    /**
+     * @brief Finds object by the message id of the last notification sent for it.
+     * @param msg_id Message id.
+     * @return Object or NULL if not found.
+     */
+    M2MBase *find_by_msgid(uint16_t msg_id) const;
+
+    /**
+     * @brief Removes all the entries.
+     */
+    void clear();
+
+private:
+
+    struct entry_s {
+        M2MBase     *base;
+        uint32_t    key;
+    };
+
+    struct table_s {
+        entry_s     *entries;
+        uint16_t    size; // power of two, 0 when not allocated
+        uint16_t    count;
+    };
+
+    static uint32_t path_hash(const char *path);
+
+    static uint16_t home_slot(const table_s &table, uint32_t key);
+
+    static bool insert(table_s &table, M2MBase *base, uint32_t key);
+
+    static int32_t find_slot(const table_s &table, const M2MBase *base, uint32_t key);
+
+    static void erase(table_s &table, uint16_t slot);
+
+    static bool grow(table_s &table);
+
+    static void free_table(table_s &table);
+
+private:
+
+    table_s     _path_table;
+    table_s     _msgid_table;
+};
+
+#endif // M2MBASEINDEX_H
@@ -16,14 +16,12 @@
 #ifndef __M2M_CALLBACK_STORAGE_H__
 #define __M2M_CALLBACK_STORAGE_H__
 
-#include "mbed-client/m2mvector.h"
+#include "ns_types.h"
 
 class M2MBase;
 class M2MCallbackAssociation;
 class M2MCallbackStorage;
 
-typedef m2m::Vector<M2MCallbackAssociation> M2MCallbackAssociationList;
-
 // XXX: this should not be visible for client code
 class M2MCallbackAssociation
 {
@@ -149,10 +147,14 @@ public:
     static void* get_callback(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type);
 
     static M2MCallbackAssociation* get_association_item(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type);
-    // XXX: this is actually not needed unless the client has multiple callbacks per object and type.
-    inline const M2MCallbackAssociationList& get_callbacks() const;
 
 private:
+    M2MCallbackStorage();
+
+    // Prevents the use of assignment operator and copy constructor by accident.
+    M2MCallbackStorage& operator=(const M2MCallbackStorage& /*other*/);
+    M2MCallbackStorage(const M2MCallbackStorage& /*other*/);
+
     bool does_callback_exist(const M2MBase &object, void *callback, M2MCallbackAssociation::M2MCallbackType type) const;
     void do_remove_callbacks(const M2MBase &object);
     void* do_remove_callback(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type);
@@ -161,6 +163,11 @@ private:
 
     M2MCallbackAssociation* do_get_association_item(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type) const;
 
+    uint32_t home_slot(const M2MBase *object, M2MCallbackAssociation::M2MCallbackType type) const;
+    int32_t find_slot(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type) const;
+    void erase(uint32_t slot);
+    bool grow();
+
 private:
 
     /**
@@ -175,13 +182,13 @@ private:
      * But that should not be too hard if the feature was added to M2M object API too, it just
      * requires the M2M objects to iterate through the callbacks associated to it, not just call
      * the get_callback(<object>,<type>) and call the first one.
+     *
+     * Stored as an open addressing hash table with linear probing, keyed by <object>+<type>.
+     * Free slots have NULL _object.
      */
-    M2MCallbackAssociationList _callbacks;
+    M2MCallbackAssociation *_callbacks;
+    uint32_t                _callbacks_size; // power of two, 0 when not allocated
+    uint32_t                _callbacks_count;
 };
 
-inline const M2MCallbackAssociationList& M2MCallbackStorage::get_callbacks() const
-{
-    return _callbacks;
-}
-
 #endif // !__M2M_CALLBACK_STORAGE_H__
@@ -285,6 +285,15 @@ public:
     */
     virtual bool set_uri_query_parameters(const char *uri_query_params);
 
+    /**
+     * @brief Collects the heap memory held by the registered object tree, aggregated
+     * per object.
+     * @param usage Array filled with one entry per object, in registration order.
+     * @param count Number of entries in the array.
+     * @return Number of registered objects, entries beyond count are not written.
+     */
+    virtual uint16_t get_memory_usage(M2MBase::memory_usage_s *usage, uint16_t count);
+
 protected: // From M2MNsdlObserver
 
     virtual void coap_message_ready(uint8_t *data_ptr,
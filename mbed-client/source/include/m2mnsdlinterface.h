@@ -26,6 +26,9 @@
 #include "mbed-client/m2mbase.h"
 #include "mbed-client/m2mserver.h"
 #include "include/nsdllinker.h"
+#include "include/m2mbaseindex.h"
+#include "include/m2mreporttimerwheel.h"
+#include "include/m2mreporthandler.h"
 #include "eventOS_event.h"
 
 //FORWARD DECLARARTION
@@ -309,6 +312,18 @@ public:
      */
     M2MTimer &get_nsdl_execution_timer();
 
+    /*
+     * @brief Get the timer wheel used for pmin and pmax of all the observations.
+     * @return Report timer wheel.
+     */
+    const M2MReportTimerWheel &get_report_timer_wheel() const;
+
+    /*
+     * @brief Get the queue of report handlers which have a notification pending.
+     * @return Report queue.
+     */
+    const M2MReportQueue &get_report_queue() const;
+
     /**
      * @brief Get unregister state.
      * @return Is unregistration ongoing.
@@ -348,6 +363,14 @@ public:
     */
     bool set_uri_query_parameters(const char *uri_query_params);
 
+    /**
+     * @brief Collects the heap memory held by the registered objects, one entry per object.
+     * @param usage Array to fill, may be NULL if count is 0.
+     * @param count Number of entries in the array.
+     * @return Number of registered objects, entries beyond count are not written.
+     */
+    uint16_t get_memory_usage(M2MBase::memory_usage_s *usage, uint16_t count);
+
     /**
      * @brief Clears the sent blockwise message list in CoAP library.
     */
@@ -416,6 +439,10 @@ protected: // from M2MObservationHandler
     virtual void value_updated(M2MBase *base);
 
     virtual void remove_object(M2MBase *object);
+
+    virtual M2MReportQueue *report_queue();
+
+    virtual M2MReportTimerWheel *report_timer_wheel();
 #ifndef DISABLE_DELAYED_RESPONSE
     virtual void send_delayed_response(M2MBase *base);
 #endif
@@ -461,26 +488,20 @@ private:
 
     uint64_t registration_time() const;
 
+    /**
+     * @brief Finds the object by its URI path or by the message id of its last notification.
+     * @param object, URI path of the object, used if msg_id is 0.
+     * @param msg_id, Notification message id.
+     * @return Found object, NULL otherwise.
+     */
     M2MBase* find_resource(const String &object,
                            const uint16_t msg_id) const;
 
-#ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
-    M2MBase* find_resource(const M2MEndpoint *endpoint,
-                                             const String &object_name,
-                                             const uint16_t msg_id) const;
-#endif
-
-    M2MBase* find_resource(const M2MObject *object,
-                           const String &object_instance,
-                           const uint16_t msg_id) const;
-
-    M2MBase* find_resource(const M2MObjectInstance *object_instance,
-                           const String &resource_instance,
-                           const uint16_t msg_id) const;
-
-    M2MBase* find_resource(const M2MResource *resource,
-                           const String &object_name,
-                           const String &resource_instance) const;
+    /**
+     * @brief Removes object and all its children from the lookup index.
+     * @param object, Object to be removed.
+     */
+    void remove_object_from_index(M2MObject *object);
 
     bool object_present(M2MBase *base) const;
 
@@ -498,6 +519,36 @@ private:
 
     void send_resource_observation(M2MResource *resource, uint16_t obs_number);
 
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+    /**
+     * @brief Adds resource to the notifications sent when the flush window closes.
+     */
+    void queue_composite_notification(M2MResource *resource);
+
+    /**
+     * @brief Sends pending resource notifications in one notification, carried by
+     * the observation of the first pending resource. Payload is TLV if the carrier
+     * uses TLV and all resources are in the same object instance, SenML otherwise.
+     */
+    void send_composite_notification();
+
+    /**
+     * @brief Reports the delivery status of a composite notification to the resources
+     * carried with the given one. Returns false if base is not carrying one.
+     */
+    bool complete_composite_notification(M2MBase *base, NotificationDeliveryStatus status);
+
+    /**
+     * @brief Drops all composite notifications when registration changes, pending
+     * resources are queued to be notified as separate notifications.
+     */
+    void clear_composite_notifications();
+
+    /**
+     * @brief Drops resource which is about to be deleted from composite notifications.
+     */
+    void remove_composite_notification(M2MBase *base);
+#endif
 
 
     /**
@@ -648,13 +699,21 @@ private:
 
     M2MNsdlObserver                         &_observer;
     M2MBaseList                             _base_list;
+    M2MBaseIndex                            _base_index;
     sn_nsdl_ep_parameters_s                 *_endpoint;
     nsdl_s                                  *_nsdl_handle;
     M2MSecurity                             *_security; // Not owned
     M2MServer                               *_server;
     M2MTimer                                _nsdl_execution_timer;
     M2MTimer                                _registration_timer;
+    M2MReportTimerWheel                     _report_timer_wheel;
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+    M2MTimer                                _composite_timer;
+    M2MResourceList                         _composite_pending;
+    M2MResourceList                         _composite_in_flight; // First one carries the notification
+#endif
     M2MConnectionHandler                    &_connection_handler;
+    M2MReportQueue                          _report_queue;
     String                                  _endpoint_name;
     String                                  _internal_endpoint_name;
     uint32_t                                _counter_for_nsdl;
@@ -673,6 +732,9 @@ private:
     bool                                    _notification_send_ongoing;
     bool                                    _registered;
     bool                                    _bootstrap_finish_ack_received;
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+    bool                                    _composite_timer_running;
+#endif
 
 friend class Test_M2MNsdlInterface;
 
@@ -23,12 +23,83 @@
 #include "mbed-client/m2mtimerobserver.h"
 #include "mbed-client/m2mresourceinstance.h"
 #include "mbed-client/m2mvector.h"
-#include "mbed-client/m2mtimer.h"
+#include "include/m2mreporttimerwheel.h"
 
 //FORWARD DECLARATION
 class M2MReportObserver;
-class M2MTimer;
 class M2MResourceInstance;
+class M2MConnectionHandler;
+class M2MReportHandler;
+
+/**
+ *  @brief M2MReportQueue.
+ *  FIFO of the report handlers which have a notification pending, i.e. they are under
+ *  observation and have notification in queue or send in progress. Each M2MNsdlInterface
+ *  owns one and the handlers link themselves in and out of the queue of their observation
+ *  handler, while holding the mutex of the connection handler.
+ */
+class M2MReportQueue
+{
+private:
+    // Prevents the use of assignment operator by accident.
+    M2MReportQueue& operator=( const M2MReportQueue& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MReportQueue( const M2MReportQueue& /*other*/ );
+
+public:
+
+    /**
+     * @brief Constructor.
+     * @param connection_handler Connection handler whose mutex protects the queue.
+     */
+    M2MReportQueue(M2MConnectionHandler &connection_handler);
+
+    /**
+     * @brief Destructor, detaches the handlers still in the queue.
+     */
+    ~M2MReportQueue();
+
+    /**
+     * @brief Returns the oldest report handler in the queue.
+     * Must be called while holding the mutex.
+     *
+     * @return First handler in the queue, NULL if queue is empty.
+     */
+    M2MReportHandler *first() const;
+
+    /**
+     * @brief Returns the number of report handlers in the queue.
+     *
+     * @return Queue depth.
+     */
+    uint32_t depth() const;
+
+    /**
+     * @brief Returns the total number of report handlers which have left the queue,
+     * i.e. whose pending notifications have been delivered or cancelled.
+     * Sampling this periodically gives the drain rate of the queue.
+     *
+     * @return Drained count, wraps around.
+     */
+    uint32_t drained() const;
+
+private:
+
+    /**
+     * @brief Adds the handler to the end of the queue or removes it from the queue.
+     */
+    void update(M2MReportHandler &handler, bool pending);
+
+private:
+    M2MConnectionHandler        &_connection_handler;
+    M2MReportHandler            *_head;
+    M2MReportHandler            *_tail;
+    uint32_t                    _depth;
+    uint32_t                    _drained;
+
+friend class M2MReportHandler;
+};
 
 /**
  *  @brief M2MReportHandler.
@@ -119,6 +190,13 @@ public:
      */
     void get_observation_token(uint8_t *token, uint8_t &token_length) const;
 
+    /**
+     * \brief Adds the memory held by the handler and its observation token
+     * to the given counters.
+     * \param usage Counters to add to.
+     */
+    void get_memory_usage(M2MBase::memory_usage_s &usage) const;
+
     /**
      * \brief Returns the observation number.
      * \return The observation number of the object.
@@ -255,6 +333,12 @@ private:
     */
     static uint8_t* alloc_string_copy(const uint8_t* source, uint32_t size);
 
+    /**
+     * @brief Adds to or removes from the ready queue of the observation handler
+     * according to the current observation and notification state.
+     */
+    void update_ready_queue();
+
 private:
     M2MReportObserver           &_observer;
     bool                        _is_under_observation : 1;
@@ -265,8 +349,8 @@ private:
     bool                        _pmin_exceeded : 1;
     bool                        _pmax_exceeded : 1;
     unsigned                    _observation_number : 24;
-    M2MTimer                    _pmin_timer;
-    M2MTimer                    _pmax_timer;
+    M2MReportTimer              _pmin_timer;
+    M2MReportTimer              _pmax_timer;
     uint8_t                     *_token;
     int32_t                     _pmax;
     int32_t                     _pmin;
@@ -282,8 +366,12 @@ private:
     bool                        _notification_in_queue : 1;
     bool                        _blockwise_notify : 1;
     bool                        _pmin_quiet_period : 1;
+    M2MReportQueue              *_ready_queue; // NULL when not in a queue
+    M2MReportHandler            *_ready_prev;
+    M2MReportHandler            *_ready_next;
 
 friend class Test_M2MReportHandler;
+friend class M2MReportQueue;
 
 };
 
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef M2MREPORTTIMERWHEEL_H
+#define M2MREPORTTIMERWHEEL_H
+
+#include "ns_types.h"
+#include "mbed-client/m2mtimer.h"
+#include "mbed-client/m2mtimerobserver.h"
+
+// Number of one second slots in the wheel, must be power of two.
+// Longer intervals wrap around and stay in their slot for several rounds.
+#define M2M_REPORT_TIMER_WHEEL_SLOTS 64
+
+// Longest wait of the tick timer, keeps the event loop tick count used as
+// the time base from wrapping between two ticks.
+#define M2M_REPORT_TIMER_WHEEL_MAX_WAIT_MS (24UL * 60 * 60 * 1000)
+
+class M2MReportTimerWheel;
+
+/**
+ * @brief M2MReportTimer
+ * Single shot timer with one second resolution, driven by a M2MReportTimerWheel.
+ * Used by M2MReportHandler for pmin and pmax instead of M2MTimer so that each observed
+ * object does not keep its own timer events in the event loop.
+ */
+class M2MReportTimer {
+
+private:
+    // Prevents the use of assignment operator by accident.
+    M2MReportTimer& operator=( const M2MReportTimer& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MReportTimer( const M2MReportTimer& /*other*/ );
+
+public:
+
+    M2MReportTimer(M2MTimerObserver &observer);
+
+    ~M2MReportTimer();
+
+    /**
+     * @brief Starts the timer, a running timer is restarted.
+     * Timer expires no earlier than the given interval, but may expire up to one second later.
+     * @param wheel Wheel driving the timer.
+     * @param interval Interval in seconds.
+     * @param type Type given to M2MTimerObserver::timer_expired().
+     */
+    void start_timer(M2MReportTimerWheel &wheel, uint32_t interval, M2MTimerObserver::Type type);
+
+    /**
+     * @brief Stops the timer.
+     */
+    void stop_timer();
+
+private:
+
+    M2MTimerObserver            &_observer;
+    M2MReportTimerWheel         *_wheel; // NULL when not running
+    M2MReportTimer              *_prev;
+    M2MReportTimer              *_next;
+    uint32_t                    _deadline;
+    M2MTimerObserver::Type      _type;
+
+friend class M2MReportTimerWheel;
+};
+
+/**
+ * @brief M2MReportTimerWheel
+ * Coarse grained timing wheel, owned by M2MNsdlInterface, for the pmin and pmax timers
+ * of all the report handlers. A single shot M2MTimer is aimed at the earliest deadline,
+ * so the device only wakes up when some timer is due, and all the timers due on that
+ * second expire in the same event.
+ */
+class M2MReportTimerWheel : public M2MTimerObserver {
+
+private:
+    // Prevents the use of assignment operator by accident.
+    M2MReportTimerWheel& operator=( const M2MReportTimerWheel& /*other*/ );
+
+    // Prevents the use of copy constructor by accident
+    M2MReportTimerWheel( const M2MReportTimerWheel& /*other*/ );
+
+public:
+
+    M2MReportTimerWheel();
+
+    virtual ~M2MReportTimerWheel();
+
+    /**
+     * @brief Returns the number of timers which expired on the last tick.
+     */
+    uint32_t expired_on_last_tick() const;
+
+    /**
+     * @brief Returns the number of running timers.
+     */
+    uint32_t running_timers() const;
+
+protected: // from M2MTimerObserver
+
+    virtual void timer_expired(M2MTimerObserver::Type type);
+
+private:
+
+    void add(M2MReportTimer &timer, uint32_t interval);
+
+    void remove(M2MReportTimer &timer);
+
+    void advance();
+
+    bool earliest_deadline(uint32_t &deadline) const;
+
+    void arm(uint32_t deadline);
+
+    void rearm();
+
+private:
+
+    M2MTimer                    _tick_timer;
+    M2MReportTimer              *_slots[M2M_REPORT_TIMER_WHEEL_SLOTS];
+    M2MReportTimer              *_expire_next; // next timer to check while expiring a slot
+    uint32_t                    _tick; // seconds
+    uint32_t                    _epoch; // event loop ticks at the start of _tick
+    uint32_t                    _armed_deadline; // tick the tick timer is aimed at
+    uint32_t                    _running_timers;
+    uint32_t                    _expired_on_last_tick;
+    bool                        _armed;
+    bool                        _in_tick;
+
+friend class M2MReportTimer;
+};
+
+#endif // M2MREPORTTIMERWHEEL_H
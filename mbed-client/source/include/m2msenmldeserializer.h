@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_SENML_DESERIALIZER_H
+#define M2M_SENML_DESERIALIZER_H
+
+#include "mbed-client/m2mobjectinstance.h"
+#include "include/m2msenmlserializer.h"
+#include "include/m2mtlvdeserializer.h"
+
+/**
+ * @brief M2MSenMLDeserializer
+ * SenML Deserialiser parses SenML-CBOR or SenML-JSON (RFC 8428) records and writes
+ * the values into the resources and resource instances they name. Errors are reported
+ * with the error codes of M2MTLVDeserializer so that both formats share the response
+ * handling.
+ */
+class M2MSenMLDeserializer {
+
+public:
+
+    /**
+     * Deserialises the given records, which must name existing writable resources or
+     * resource instances of the object instance. The whole payload is validated before
+     * any value is written. Resources not present in the payload are left untouched.
+     * @param payload SenML payload.
+     * @param payload_size Length of the payload.
+     * @param format SenML format of the payload.
+     * @param object_instance Target object instance.
+     * @return M2MTLVDeserializer::None on success, otherwise the reason of failure.
+     */
+    static M2MTLVDeserializer::Error deserialize_resources(const uint8_t *payload,
+                                                           uint32_t payload_size,
+                                                           M2MSenMLSerializer::Format format,
+                                                           M2MObjectInstance &object_instance);
+};
+
+#endif // M2M_SENML_DESERIALIZER_H
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_SENML_SERIALIZER_H
+#define M2M_SENML_SERIALIZER_H
+
+#include "mbed-client/m2mvector.h"
+#include "mbed-client/m2mobject.h"
+#include "mbed-client/m2mobjectinstance.h"
+#include "mbed-client/m2mresource.h"
+
+class M2MResourceBase;
+
+/**
+ * @brief M2MSenMLSerializer
+ * SenML Serialiser constructs the SenML-CBOR or SenML-JSON (RFC 8428) representation
+ * of object instances, resources and resource instances as described in
+ * OMA-LWM2M 1.1 specification, chapter 7.4.
+ *
+ * The first record carries the path of the target as base name and the record names
+ * are relative to it. Numeric and boolean values are encoded natively, opaque values
+ * as byte strings in CBOR and as base64url in JSON.
+ */
+class M2MSenMLSerializer {
+
+public:
+
+    typedef enum {
+        CBOR,
+        JSON
+    } Format;
+
+    /**
+     * Checks whether the given CoAP content format is SenML-CBOR or SenML-JSON.
+     * @param content_format CoAP content format.
+     * @param format Set to the matching format if supported.
+     * @return true if content format is SenML.
+     */
+    static bool is_senml(uint16_t content_format, Format &format);
+
+    /**
+     * Serialises given object instances of an object and their resources, used when
+     * an operation targets an object like "GET /3303".
+     * @param object Parent object of the instances, provides the base name.
+     * @param object_instance_list Object instances to be serialised.
+     * @param format SenML format.
+     * @param size Set to the length of the encoded data.
+     * @return Encoded data, to be freed by caller, or NULL on failure.
+     */
+    static uint8_t* serialize(const M2MObject &object, const M2MObjectInstanceList &object_instance_list,
+                              Format format, uint32_t &size);
+
+    /**
+     * Serialises the resources of an object instance, used when an operation
+     * targets an object instance like "GET /3303/0".
+     * @param object_instance Object instance.
+     * @param format SenML format.
+     * @param size Set to the length of the encoded data.
+     * @return Encoded data, to be freed by caller, or NULL on failure.
+     */
+    static uint8_t* serialize(const M2MObjectInstance &object_instance, Format format, uint32_t &size);
+
+    /**
+     * Serialises resources of any object instances into one payload, used for composite
+     * notifications. The base name is "/" and the record names are the full paths.
+     * @param resource_list Resources to be serialised.
+     * @param format SenML format.
+     * @param size Set to the length of the encoded data.
+     * @return Encoded data, to be freed by caller, or NULL on failure.
+     */
+    static uint8_t* serialize(const M2MResourceList &resource_list, Format format, uint32_t &size);
+
+    /**
+     * Serialises a resource, including all its instances if it is a multiple resource,
+     * or a single resource instance.
+     * @param resource Resource or resource instance.
+     * @param format SenML format.
+     * @param size Set to the length of the encoded data.
+     * @return Encoded data, to be freed by caller, or NULL on failure.
+     */
+    static uint8_t* serialize(const M2MResourceBase &resource, Format format, uint32_t &size);
+};
+
+#endif // M2M_SENML_SERIALIZER_H
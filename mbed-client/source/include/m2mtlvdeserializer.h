@@ -13,6 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifndef M2M_TLV_DESERIALIZER_H
+#define M2M_TLV_DESERIALIZER_H
+
 #include "mbed-client/m2mvector.h"
 #include "mbed-client/m2mobject.h"
 #include "mbed-client/m2mobjectinstance.h"
@@ -34,7 +37,8 @@ public :
         NotFound,
         NotAllowed,
         NotValid,
-        OutOfMemory
+        OutOfMemory,
+        Incomplete
     } Error;
 
     typedef enum {
@@ -162,6 +166,8 @@ private:
                                  uint32_t tlv_size,
                                  M2MResource &resource,
                                  uint32_t offset_size);
+
+    friend class M2MTLVStreamDeserializer;
 };
 
 class TypeIdLength {
@@ -183,3 +189,5 @@ public:
 
     friend class Test_M2MTLVDeserializer;
 };
+
+#endif // M2M_TLV_DESERIALIZER_H
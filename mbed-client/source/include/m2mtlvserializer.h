@@ -76,29 +76,53 @@ public:
 
     static uint8_t* serialize(const M2MResource *resource, uint32_t &size);
 
+    /**
+     * Serialises given object instances into a caller supplied buffer, see
+     * serialize(const M2MObjectInstanceList&, uint32_t&) for the format.
+     * @param buffer Output buffer, if NULL only the required size is computed.
+     * @param buffer_size Size of the output buffer.
+     * @param size Set to the length of the encoded data.
+     * @return true on success, false if the buffer is too small.
+     */
+    static bool serialize(const M2MObjectInstanceList &object_instance_list, uint8_t *buffer,
+                          uint32_t buffer_size, uint32_t &size);
+
+    /**
+     * Serialises given resources into a caller supplied buffer, see
+     * serialize(const M2MResourceList&, uint32_t&) for the format.
+     * @param buffer Output buffer, if NULL only the required size is computed.
+     * @param buffer_size Size of the output buffer.
+     * @param size Set to the length of the encoded data.
+     * @return true on success, false if the buffer is too small or a resource has no numeric id.
+     */
+    static bool serialize(const M2MResourceList &resource_list, uint8_t *buffer,
+                          uint32_t buffer_size, uint32_t &size);
+
 private :
 
-    static uint8_t* serialize_object_instances(const M2MObjectInstanceList &object_instance_list, uint32_t &size);
+    /*
+     * The write_ functions append the encoding at data + size and advance size.
+     * When data is NULL nothing is written and only size is advanced, which is
+     * used to compute the exact buffer size before the actual write pass.
+     * Nothing is written beyond capacity, a mismatch between the final size and
+     * the computed size means that values changed in between.
+     */
+    static uint8_t* allocate_and_write(const M2MObjectInstanceList *object_instance_list,
+                                       const M2MResourceList *resource_list,
+                                       const M2MResource *resource,
+                                       uint32_t &size);
 
-    static uint8_t* serialize_resources(const M2MResourceList &resource_list, uint32_t &size, bool &valid);
+    static void write_object_instances(const M2MObjectInstanceList &object_instance_list, uint8_t *data, uint32_t capacity, uint32_t &size);
 
-    static bool serialize(uint16_t id, const M2MObjectInstance *object_instance, uint8_t *&data, uint32_t &size);
-    
-    static bool serialize(const M2MResource *resource, uint8_t *&data, uint32_t &size);
+    static bool write_resources(const M2MResourceList &resource_list, uint8_t *data, uint32_t capacity, uint32_t &size);
 
-    static bool serialize_resource(const M2MResource *resource, uint8_t *&data, uint32_t &size);
+    static bool write_resource(const M2MResource *resource, uint8_t *data, uint32_t capacity, uint32_t &size);
 
-    static bool serialize_multiple_resource(const M2MResource *resource, uint8_t *&data, uint32_t &size);
+    static void write_resource_value(const M2MResourceBase *resource, uint8_t type, uint16_t id, uint8_t *data, uint32_t capacity, uint32_t &size);
 
-    static bool serialize_resource_instance(uint16_t id, const M2MResourceInstance *resource, uint8_t *&data, uint32_t &size);
-    
-    static bool serialize_TILV (uint8_t type, uint16_t id, uint8_t *value, uint32_t value_length, uint8_t *&data, uint32_t &size);
+    static void write_TILV_header(uint8_t type, uint16_t id, uint32_t value_length, uint8_t *data, uint32_t capacity, uint32_t &size);
 
     static void serialize_id(uint16_t id, uint32_t &size, uint8_t *id_ptr);
 
     static void serialize_length(uint32_t length, uint32_t &size, uint8_t *length_ptr);
-
-    static bool serialize_TLV_binary_int(const M2MResourceBase *resource, uint8_t type, uint16_t id, uint8_t *&data, uint32_t &size);
-
-    static bool serialize_TLV_binary_float(const M2MResourceBase *resource, uint8_t type, uint16_t id, uint8_t *&data, uint32_t &size);
 };
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef M2M_TLV_STREAM_DESERIALIZER_H
+#define M2M_TLV_STREAM_DESERIALIZER_H
+
+#include "include/m2mtlvdeserializer.h"
+
+/**
+ * @brief M2MTLVStreamDeserializer
+ * Resumable TLV deserialiser for resources of an object instance received in
+ * CoAP blocks. Data is pushed in as it arrives and every resource or resource
+ * instance value is written as soon as its record is complete, so the whole
+ * payload is never held in memory. Only a record split between two blocks is
+ * buffered, and only until the rest of it is pushed.
+ *
+ * Unlike M2MTLVDeserializer::deserialize_resources() the payload can not be
+ * validated before it is applied: values of the records preceding an invalid
+ * one stay written, and a PUT does not remove the resources missing from
+ * the payload.
+ */
+class M2MTLVStreamDeserializer {
+
+public:
+
+    /**
+     * Constructor.
+     * @param object_instance Object instance the records are written to.
+     * @param operation Put updates existing resources only, Post creates
+     * the missing ones.
+     */
+    M2MTLVStreamDeserializer(M2MObjectInstance &object_instance,
+                             M2MTLVDeserializer::Operation operation);
+
+    ~M2MTLVStreamDeserializer();
+
+    /**
+     * Parses the next part of the payload. Once an error is returned all the
+     * following data is ignored.
+     * @param data Next bytes of the payload.
+     * @param size Length of the data.
+     * @return M2MTLVDeserializer::None on success, otherwise the reason of failure.
+     */
+    M2MTLVDeserializer::Error push(const uint8_t *data, uint32_t size);
+
+    /**
+     * Ends the payload.
+     * @return M2MTLVDeserializer::NotValid if the payload ended in the middle
+     * of a record, otherwise the result of the earlier pushes.
+     */
+    M2MTLVDeserializer::Error finish();
+
+    /**
+     * Identifier of the first record of the payload.
+     */
+    uint16_t first_id() const;
+
+    /**
+     * True once the payload has been ended with finish().
+     */
+    bool finished() const;
+
+    /**
+     * Number of the next CoAP block of the payload, as recorded by the caller.
+     */
+    uint32_t next_block() const;
+
+    /**
+     * Records the number of the next CoAP block expected after a block is pushed.
+     */
+    void set_next_block(uint32_t block);
+
+private:
+
+    typedef enum {
+        Header,
+        Value
+    } State;
+
+    M2MTLVDeserializer::Error begin_record();
+
+    M2MTLVDeserializer::Error end_record(const uint8_t *value);
+
+    M2MTLVDeserializer::Error find_resource();
+
+    M2MTLVDeserializer::Error find_resource_instance();
+
+    void leave_multiple_resource();
+
+private:
+
+    M2MObjectInstance                   &_object_instance;
+    M2MResource                         *_multiple_resource;
+    M2MResourceBase                     *_target;
+    uint8_t                             *_value;
+    uint32_t                            _offset;
+    uint32_t                            _multiple_resource_end;
+    uint32_t                            _length;
+    uint32_t                            _received;
+    uint32_t                            _next_block;
+    uint16_t                            _id;
+    uint16_t                            _first_id;
+    uint8_t                             _header[6];
+    uint8_t                             _header_len;
+    uint8_t                             _type;
+    State                               _state;
+    M2MTLVDeserializer::Operation       _operation;
+    M2MTLVDeserializer::Error           _error;
+    bool                                _first;
+    bool                                _finished;
+
+private:
+    // Prevents the use of assignment operator and copy constructor
+    M2MTLVStreamDeserializer& operator=(const M2MTLVStreamDeserializer&);
+    M2MTLVStreamDeserializer(const M2MTLVStreamDeserializer&);
+};
+
+#endif // M2M_TLV_STREAM_DESERIALIZER_H
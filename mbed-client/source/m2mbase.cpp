@@ -208,6 +208,7 @@ void M2MBase::set_interface_description(const char *desc)
         _sn_resource->dynamic_resource_params->static_resource_parameters->interface_description_ptr =
                 (char*)alloc_string_copy((uint8_t*) desc, len);
     }
+    sn_nsdl_resource_link_format_changed(_sn_resource->dynamic_resource_params);
     set_changed();
 }
 
@@ -235,6 +236,7 @@ void M2MBase::set_resource_type(const char *res_type)
         _sn_resource->dynamic_resource_params->static_resource_parameters->resource_type_ptr = (char*)
                 alloc_string_copy((uint8_t*) res_type, len);
     }
+    sn_nsdl_resource_link_format_changed(_sn_resource->dynamic_resource_params);
     set_changed();
 }
 #endif // DISABLE_RESOURCE_TYPE
@@ -249,6 +251,7 @@ void M2MBase::set_interface_description(const char *desc)
         item.attribute_name = ATTR_INTERFACE_DESCRIPTION;
         item.value = (char*)alloc_string_copy((uint8_t*) desc, len);
         sn_nsdl_set_resource_attribute(_sn_resource->dynamic_resource_params->static_resource_parameters, &item);
+        sn_nsdl_resource_link_format_changed(_sn_resource->dynamic_resource_params);
         set_changed();
     }
 }
@@ -274,6 +277,7 @@ void M2MBase::set_resource_type(const char *res_type)
         item.attribute_name = ATTR_RESOURCE_TYPE;
         item.value = (char*)alloc_string_copy((uint8_t*) res_type, len);
         sn_nsdl_set_resource_attribute(_sn_resource->dynamic_resource_params->static_resource_parameters, &item);
+        sn_nsdl_resource_link_format_changed(_sn_resource->dynamic_resource_params);
         set_changed();
     }
 }
@@ -282,6 +286,7 @@ void M2MBase::set_resource_type(const char *res_type)
 void M2MBase::set_coap_content_type(const uint16_t con_type)
 {
     _sn_resource->dynamic_resource_params->coap_content_type = con_type;
+    sn_nsdl_resource_link_format_changed(_sn_resource->dynamic_resource_params);
     set_changed();
 }
 
@@ -840,6 +845,79 @@ void M2MBase::free_resources()
     }
 }
 
+void M2MBase::get_memory_usage(memory_usage_s &usage) const
+{
+    add_memory_usage(usage, sizeof(M2MBase));
+}
+
+size_t M2MBase::memory_usage_total(const memory_usage_s &usage)
+{
+    return usage.nodes + usage.names + usage.lwm2m_parameters + usage.nsdl_parameters +
+           usage.values + usage.report_handlers + usage.tokens;
+}
+
+void M2MBase::add_memory_usage(memory_usage_s &usage, size_t node_size) const
+{
+    usage.nodes += node_size;
+
+    switch (base_type()) {
+        case M2MBase::ObjectInstance:
+            usage.object_instances++;
+            break;
+        case M2MBase::Resource:
+            usage.resources++;
+            break;
+        case M2MBase::ResourceInstance:
+            usage.resource_instances++;
+            break;
+        default:
+            break;
+    }
+
+    // Same ownership rules as in free_resources()
+    const sn_nsdl_dynamic_resource_parameters_s *dynamic_params = _sn_resource->dynamic_resource_params;
+    const sn_nsdl_static_resource_parameters_s *static_params = dynamic_params->static_resource_parameters;
+    if (static_params->free_on_delete) {
+        usage.nsdl_parameters += sizeof(sn_nsdl_static_resource_parameters_s);
+        if (static_params->path) {
+            usage.names += strlen(static_params->path) + 1;
+        }
+#ifndef RESOURCE_ATTRIBUTES_LIST
+#ifndef DISABLE_RESOURCE_TYPE
+        if (static_params->resource_type_ptr) {
+            usage.names += strlen(static_params->resource_type_ptr) + 1;
+        }
+#endif
+#ifndef DISABLE_INTERFACE_DESCRIPTION
+        if (static_params->interface_description_ptr) {
+            usage.names += strlen(static_params->interface_description_ptr) + 1;
+        }
+#endif
+#else
+        const sn_nsdl_attribute_item_s *item = static_params->attributes_ptr;
+        if (item) {
+            for (; item->attribute_name != ATTR_END; item++) {
+                usage.names += sizeof(sn_nsdl_attribute_item_s) + (item->value ? strlen(item->value) + 1 : 0);
+            }
+            usage.names += sizeof(sn_nsdl_attribute_item_s);
+        }
+#endif
+    }
+    if (dynamic_params->free_on_delete) {
+        usage.nsdl_parameters += sizeof(sn_nsdl_dynamic_resource_parameters_s);
+    }
+    if (_sn_resource->free_on_delete) {
+        usage.lwm2m_parameters += sizeof(lwm2m_parameters_s);
+        if (!_sn_resource->identifier_int_type && _sn_resource->identifier.name) {
+            usage.names += strlen(_sn_resource->identifier.name) + 1;
+        }
+    }
+
+    if (_report_handler) {
+        _report_handler->get_memory_usage(usage);
+    }
+}
+
 size_t M2MBase::resource_name_length() const
 {
     assert(_sn_resource->identifier_int_type == false);
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "include/m2mbaseindex.h"
+#include "mbed-client/m2mbase.h"
+#include "mbed-trace/mbed_trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_GROUP "mClt"
+
+// Initial amount of slots, tables grow by doubling when 3/4 full.
+#define M2M_BASE_INDEX_MIN_SIZE 16
+#define M2M_BASE_INDEX_MAX_SIZE 0x8000
+
+M2MBaseIndex::M2MBaseIndex()
+{
+    memset(&_path_table, 0, sizeof(_path_table));
+    memset(&_msgid_table, 0, sizeof(_msgid_table));
+}
+
+M2MBaseIndex::~M2MBaseIndex()
+{
+    clear();
+}
+
+bool M2MBaseIndex::add_path(M2MBase *base)
+{
+    const char *path = base->uri_path();
+    if (!path) {
+        return false;
+    }
+
+    uint32_t key = path_hash(path);
+    if (find_slot(_path_table, base, key) >= 0) {
+        return true;
+    }
+    return insert(_path_table, base, key);
+}
+
+void M2MBaseIndex::set_notification_msgid(M2MBase *base, uint16_t msg_id)
+{
+    int32_t slot = find_slot(_msgid_table, base, base->get_notification_msgid());
+    if (slot >= 0) {
+        erase(_msgid_table, slot);
+    }
+    if (!insert(_msgid_table, base, msg_id)) {
+        tr_warn("M2MBaseIndex::set_notification_msgid - failed to index msgid %d", msg_id);
+    }
+}
+
+void M2MBaseIndex::remove(M2MBase *base)
+{
+    int32_t slot;
+    const char *path = base->uri_path();
+    if (path) {
+        slot = find_slot(_path_table, base, path_hash(path));
+        if (slot >= 0) {
+            erase(_path_table, slot);
+        }
+    }
+
+    slot = find_slot(_msgid_table, base, base->get_notification_msgid());
+    if (slot >= 0) {
+        erase(_msgid_table, slot);
+    }
+}
+
+M2MBase *M2MBaseIndex::find_by_path(const char *path) const
+{
+    if (!_path_table.size || !path) {
+        return NULL;
+    }
+
+    uint32_t key = path_hash(path);
+    uint16_t slot = home_slot(_path_table, key);
+    while (_path_table.entries[slot].base) {
+        const entry_s &entry = _path_table.entries[slot];
+        if (entry.key == key && strcmp(entry.base->uri_path(), path) == 0) {
+            return entry.base;
+        }
+        slot = (slot + 1) & (_path_table.size - 1);
+    }
+    return NULL;
+}
+
+M2MBase *M2MBaseIndex::find_by_msgid(uint16_t msg_id) const
+{
+    if (!_msgid_table.size) {
+        return NULL;
+    }
+
+    uint16_t slot = home_slot(_msgid_table, msg_id);
+    while (_msgid_table.entries[slot].base) {
+        if (_msgid_table.entries[slot].key == msg_id) {
+            return _msgid_table.entries[slot].base;
+        }
+        slot = (slot + 1) & (_msgid_table.size - 1);
+    }
+    return NULL;
+}
+
+void M2MBaseIndex::clear()
+{
+    free_table(_path_table);
+    free_table(_msgid_table);
+}
+
+uint32_t M2MBaseIndex::path_hash(const char *path)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    while (*path) {
+        hash ^= (uint8_t)*path++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint16_t M2MBaseIndex::home_slot(const table_s &table, uint32_t key)
+{
+    return (uint16_t)((key * 2654435761u) >> 16) & (table.size - 1);
+}
+
+bool M2MBaseIndex::insert(table_s &table, M2MBase *base, uint32_t key)
+{
+    // Keep the load factor below 3/4 so that probe sequences stay short
+    if ((uint32_t)(table.count + 1) * 4 > (uint32_t)table.size * 3) {
+        if (!grow(table)) {
+            return false;
+        }
+    }
+
+    uint16_t slot = home_slot(table, key);
+    while (table.entries[slot].base) {
+        slot = (slot + 1) & (table.size - 1);
+    }
+    table.entries[slot].base = base;
+    table.entries[slot].key = key;
+    table.count++;
+    return true;
+}
+
+int32_t M2MBaseIndex::find_slot(const table_s &table, const M2MBase *base, uint32_t key)
+{
+    if (!table.size) {
+        return -1;
+    }
+
+    uint16_t slot = home_slot(table, key);
+    while (table.entries[slot].base) {
+        if (table.entries[slot].base == base && table.entries[slot].key == key) {
+            return slot;
+        }
+        slot = (slot + 1) & (table.size - 1);
+    }
+    return -1;
+}
+
+void M2MBaseIndex::erase(table_s &table, uint16_t slot)
+{
+    const uint16_t mask = table.size - 1;
+    uint16_t hole = slot;
+    uint16_t next = slot;
+
+    // Backward shift deletion, move up entries whose probe sequence passes the hole
+    for (;;) {
+        next = (next + 1) & mask;
+        if (!table.entries[next].base) {
+            break;
+        }
+        uint16_t home = home_slot(table, table.entries[next].key);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table.entries[hole] = table.entries[next];
+            hole = next;
+        }
+    }
+    table.entries[hole].base = NULL;
+    table.entries[hole].key = 0;
+    table.count--;
+}
+
+bool M2MBaseIndex::grow(table_s &table)
+{
+    uint32_t new_size = table.size ? (uint32_t)table.size * 2 : M2M_BASE_INDEX_MIN_SIZE;
+    if (new_size > M2M_BASE_INDEX_MAX_SIZE) {
+        return false;
+    }
+
+    entry_s *entries = (entry_s*)calloc(new_size, sizeof(entry_s));
+    if (!entries) {
+        return false;
+    }
+
+    table_s old_table = table;
+    table.entries = entries;
+    table.size = (uint16_t)new_size;
+    table.count = 0;
+
+    for (uint32_t i = 0; i < old_table.size; i++) {
+        if (old_table.entries[i].base) {
+            insert(table, old_table.entries[i].base, old_table.entries[i].key);
+        }
+    }
+    free(old_table.entries);
+    return true;
+}
+
+void M2MBaseIndex::free_table(table_s &table)
+{
+    free(table.entries);
+    table.entries = NULL;
+    table.size = 0;
+    table.count = 0;
+}
@@ -17,6 +17,11 @@
 #include "include/m2mcallbackstorage.h"
 
 #include <cstddef>
+#include <stdlib.h>
+#include <string.h>
+
+// Initial amount of slots, table grows by doubling when 3/4 full.
+#define M2M_CALLBACK_STORAGE_MIN_SIZE 16
 
 // Dummy constructor, which does not init any value to something meaningful but needed for array construction.
 // It is better to leave values unintialized, so the Valgrind will point out if the Vector is used without
@@ -46,11 +51,19 @@ void M2MCallbackStorage::delete_instance()
     M2MCallbackStorage::_static_instance = NULL;
 }
 
+M2MCallbackStorage::M2MCallbackStorage()
+: _callbacks(NULL),
+  _callbacks_size(0),
+  _callbacks_count(0)
+{
+}
+
 M2MCallbackStorage::~M2MCallbackStorage()
 {
     // TODO: go through the list and delete all the FP<n> objects if there are any.
     // On the other hand, if the system is done properly, each m2mobject should actually
     // remove its callbacks from its destructor so there is nothing here to do
+    free(_callbacks);
 }
 
 bool M2MCallbackStorage::add_callback(const M2MBase &object,
@@ -74,15 +87,26 @@ bool M2MCallbackStorage::do_add_callback(const M2MBase &object, void *callback,
     // verify that the same callback is not re-added.
     if (does_callback_exist(object, callback, type) == false) {
 
-        const M2MCallbackAssociation association(&object, callback, type, client_args);
-        _callbacks.push_back(association);
+        // Keep the load factor below 3/4 so that probe sequences stay short
+        if ((_callbacks_count + 1) * 4 > _callbacks_size * 3) {
+            if (!grow()) {
+                return false;
+            }
+        }
+
+        // Entries with the same key stay in insertion order along the probe sequence
+        uint32_t slot = home_slot(&object, type);
+        while (_callbacks[slot]._object) {
+            slot = (slot + 1) & (_callbacks_size - 1);
+        }
+        _callbacks[slot] = M2MCallbackAssociation(&object, callback, type, client_args);
+        _callbacks_count++;
         add_success = true;
     }
 
     return add_success;
 }
 
-#if 0 // Functions not used currently
 void M2MCallbackStorage::remove_callbacks(const M2MBase &object)
 {
    // do not use the get_instance() here as it might create the instance
@@ -95,16 +119,15 @@ void M2MCallbackStorage::remove_callbacks(const M2MBase &object)
 
 void M2MCallbackStorage::do_remove_callbacks(const M2MBase &object)
 {
-    // find any association to given object and delete them from the vector
-    for (int index = 0; index < _callbacks.size();) {
-        if (_callbacks[index]._object == &object) {
-            _callbacks.erase(index);
-        } else {
-            index++;
+    // find any association to given object and delete them from the table
+    for (int type = M2MCallbackAssociation::M2MBaseValueUpdatedCallback;
+         type <= M2MCallbackAssociation::M2MResourceBaseValueWriteCallback; type++) {
+        int32_t slot;
+        while ((slot = find_slot(object, (M2MCallbackAssociation::M2MCallbackType)type)) >= 0) {
+            erase(slot);
         }
     }
 }
-#endif
 
 void* M2MCallbackStorage::remove_callback(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type)
 {
@@ -122,13 +145,10 @@ void* M2MCallbackStorage::remove_callback(const M2MBase &object, M2MCallbackAsso
 void* M2MCallbackStorage::do_remove_callback(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type)
 {
     void* callback = NULL;
-    for (int index = 0; index < _callbacks.size(); index++) {
-
-        if ((_callbacks[index]._object == &object) && (_callbacks[index]._type == type)) {
-            callback = _callbacks[index]._callback;
-            _callbacks.erase(index);
-            break;
-        }
+    int32_t slot = find_slot(object, type);
+    if (slot >= 0) {
+        callback = _callbacks[slot]._callback;
+        erase(slot);
     }
     return callback;
 }
@@ -147,16 +167,9 @@ void* M2MCallbackStorage::get_callback(const M2MBase &object, M2MCallbackAssocia
 void* M2MCallbackStorage::do_get_callback(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type) const
 {
     void* callback = NULL;
-    if (!_callbacks.empty()) {
-        M2MCallbackAssociationList::const_iterator it = _callbacks.begin();
-
-        for ( ; it != _callbacks.end(); it++ ) {
-
-            if ((it->_object == &object) && (it->_type == type)) {
-                callback = it->_callback;
-                break;
-            }
-        }
+    int32_t slot = find_slot(object, type);
+    if (slot >= 0) {
+        callback = _callbacks[slot]._callback;
     }
     return callback;
 }
@@ -175,16 +188,9 @@ M2MCallbackAssociation* M2MCallbackStorage::get_association_item(const M2MBase &
 M2MCallbackAssociation* M2MCallbackStorage::do_get_association_item(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type) const
 {
     M2MCallbackAssociation* callback_association = NULL;
-    if (!_callbacks.empty()) {
-        M2MCallbackAssociationList::const_iterator it = _callbacks.begin();
-
-        for ( ; it != _callbacks.end(); it++ ) {
-
-            if ((it->_object == &object) && (it->_type == type)) {
-                callback_association = (M2MCallbackAssociation*)it;
-                break;
-            }
-        }
+    int32_t slot = find_slot(object, type);
+    if (slot >= 0) {
+        callback_association = &_callbacks[slot];
     }
     return callback_association;
 }
@@ -202,17 +208,97 @@ bool M2MCallbackStorage::does_callback_exist(const M2MBase &object, void *callba
 {
     bool match_found = false;
 
-    if (!_callbacks.empty()) {
-        M2MCallbackAssociationList::const_iterator it = _callbacks.begin();
-
-        for ( ; it != _callbacks.end(); it++ ) {
-
-            if ((it->_object == &object) && (it->_callback == callback) && (it->_type == type)) {
+    if (_callbacks_size) {
+        uint32_t slot = home_slot(&object, type);
+        while (_callbacks[slot]._object) {
+            if ((_callbacks[slot]._object == &object) && (_callbacks[slot]._callback == callback) &&
+                (_callbacks[slot]._type == type)) {
                 match_found = true;
                 break;
             }
+            slot = (slot + 1) & (_callbacks_size - 1);
         }
     }
 
     return match_found;
 }
+
+uint32_t M2MCallbackStorage::home_slot(const M2MBase *object, M2MCallbackAssociation::M2MCallbackType type) const
+{
+    // Objects are at least word aligned, so the lowest bits of the address carry no information
+    uint32_t key = (uint32_t)((uintptr_t)object >> 2) ^ ((uint32_t)type << 24);
+    return ((key * 2654435761u) >> 8) & (_callbacks_size - 1);
+}
+
+int32_t M2MCallbackStorage::find_slot(const M2MBase &object, M2MCallbackAssociation::M2MCallbackType type) const
+{
+    if (!_callbacks_size) {
+        return -1;
+    }
+
+    uint32_t slot = home_slot(&object, type);
+    while (_callbacks[slot]._object) {
+        if ((_callbacks[slot]._object == &object) && (_callbacks[slot]._type == type)) {
+            return slot;
+        }
+        slot = (slot + 1) & (_callbacks_size - 1);
+    }
+    return -1;
+}
+
+void M2MCallbackStorage::erase(uint32_t slot)
+{
+    const uint32_t mask = _callbacks_size - 1;
+    uint32_t hole = slot;
+    uint32_t next = slot;
+
+    // Backward shift deletion, move up entries whose probe sequence passes the hole
+    for (;;) {
+        next = (next + 1) & mask;
+        if (!_callbacks[next]._object) {
+            break;
+        }
+        uint32_t home = home_slot(_callbacks[next]._object, _callbacks[next]._type);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            _callbacks[hole] = _callbacks[next];
+            hole = next;
+        }
+    }
+    _callbacks[hole]._object = NULL;
+    _callbacks_count--;
+}
+
+bool M2MCallbackStorage::grow()
+{
+    uint32_t new_size = _callbacks_size ? _callbacks_size * 2 : M2M_CALLBACK_STORAGE_MIN_SIZE;
+
+    M2MCallbackAssociation *entries = (M2MCallbackAssociation*)calloc(new_size, sizeof(M2MCallbackAssociation));
+    if (!entries) {
+        return false;
+    }
+
+    M2MCallbackAssociation *old_entries = _callbacks;
+    uint32_t old_size = _callbacks_size;
+    _callbacks = entries;
+    _callbacks_size = new_size;
+
+    // Start from the beginning of a probe cluster so that entries with the same key keep their order
+    uint32_t start = 0;
+    if (old_size) {
+        while (old_entries[start]._object && start < old_size - 1) {
+            start++;
+        }
+    }
+    for (uint32_t i = 0; i < old_size; i++) {
+        const M2MCallbackAssociation &entry = old_entries[(start + i) & (old_size - 1)];
+        if (entry._object) {
+            uint32_t slot = home_slot(entry._object, entry._type);
+            while (_callbacks[slot]._object) {
+                slot = (slot + 1) & (_callbacks_size - 1);
+            }
+            _callbacks[slot] = entry;
+        }
+    }
+    free(old_entries);
+    return true;
+}
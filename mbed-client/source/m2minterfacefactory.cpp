@@ -126,6 +126,20 @@ M2MObject* M2MInterfaceFactory::create_object(const String &name)
     return object;
 }
 
+M2MObject* M2MInterfaceFactory::create_object(const m2m_static_object_s &definition)
+{
+    if (!definition.params || definition.params->base_type != M2MBase::Object ||
+        definition.params->identifier_int_type) {
+        return NULL;
+    }
+    tr_debug("M2MInterfaceFactory::create_object : Name : %s, instances %d",
+             definition.params->identifier.name, definition.instance_count);
+
+    M2MObject *object = new M2MObject(definition.params);
+    object->add_static_object_instances(definition.instances, definition.instance_count);
+    return object;
+}
+
 #ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
 M2MEndpoint* M2MInterfaceFactory::create_endpoint(const String &name)
 {
@@ -1347,3 +1347,8 @@ bool M2MInterfaceImpl::set_uri_query_parameters(const char *uri_query_params)
 {
     return _nsdl_interface.set_uri_query_parameters(uri_query_params);
 }
+
+uint16_t M2MInterfaceImpl::get_memory_usage(M2MBase::memory_usage_s *usage, uint16_t count)
+{
+    return _nsdl_interface.get_memory_usage(usage, count);
+}
@@ -35,6 +35,7 @@
 #include "include/m2mnsdlobserver.h"
 #include "include/m2mtlvdeserializer.h"
 #include "include/m2mtlvserializer.h"
+#include "include/m2msenmlserializer.h"
 #include "include/m2mnsdlinterface.h"
 #include "include/m2mreporthandler.h"
 #include "mbed-client/m2mstring.h"
@@ -154,7 +155,11 @@ M2MNsdlInterface::M2MNsdlInterface(M2MNsdlObserver &observer, M2MConnectionHandl
   _server(NULL),
   _nsdl_execution_timer(*this),
   _registration_timer(*this),
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+  _composite_timer(*this),
+#endif
   _connection_handler(connection_handler),
+  _report_queue(connection_handler),
   _counter_for_nsdl(0),
   _next_coap_ping_send_time(0),
   _server_address(NULL),
@@ -167,6 +172,9 @@ M2MNsdlInterface::M2MNsdlInterface(M2MNsdlObserver &observer, M2MConnectionHandl
   _notification_send_ongoing(false),
   _registered(false),
   _bootstrap_finish_ack_received(false)
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+  ,_composite_timer_running(false)
+#endif
 {
     tr_debug("M2MNsdlInterface::M2MNsdlInterface()");
 
@@ -386,6 +394,10 @@ bool M2MNsdlInterface::create_nsdl_list_structure(const M2MBaseList &list)
 bool M2MNsdlInterface::remove_nsdl_resource(M2MBase *base)
 {
     sn_nsdl_dynamic_resource_parameters_s* resource = base->get_nsdl_resource();
+    _base_index.remove(base);
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+    remove_composite_notification(base);
+#endif
     return sn_nsdl_pop_resource(_nsdl_handle, resource);
 }
 
@@ -780,6 +792,9 @@ uint8_t M2MNsdlInterface::received_from_server_callback(struct nsdl_s *nsdl_hand
                 M2MBase *base = find_resource("", coap_header->msg_id);
                 if (base) {
                     base->send_notification_delivery_status(*base, NOTIFICATION_STATUS_SEND_FAILED);
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+                    complete_composite_notification(base, NOTIFICATION_STATUS_SEND_FAILED);
+#endif
                 }
 
                 _observer.registration_error(M2MInterface::NetworkError, true);
@@ -1046,6 +1061,14 @@ void M2MNsdlInterface::timer_expired(M2MTimerObserver::Type type)
             send_update_registration();
         }
     }
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+    else if (M2MTimerObserver::CompositeNotification == type) {
+        claim_mutex();
+        _composite_timer_running = false;
+        send_composite_notification();
+        release_mutex();
+    }
+#endif
 }
 
 bool M2MNsdlInterface::observation_to_be_sent(M2MBase *object,
@@ -1058,6 +1081,15 @@ bool M2MNsdlInterface::observation_to_be_sent(M2MBase *object,
     if (object && _nsdl_execution_timer_running && _registered) {
         tr_debug("M2MNsdlInterface::observation_to_be_sent() uri %s", object->uri_path());
 
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+        if (object->base_type() == M2MBase::Resource) {
+            object->report_handler()->set_notification_in_queue(false);
+            queue_composite_notification(static_cast<M2MResource*> (object));
+            release_mutex();
+            return true;
+        }
+#endif
+
         if (!_notification_send_ongoing) {
             _notification_send_ongoing = true;
             object->report_handler()->set_notification_in_queue(false);
@@ -1264,6 +1296,15 @@ bool M2MNsdlInterface::create_nsdl_object_structure(M2MObject *object)
     }
     if(object && object->operation() != M2MBase::NOT_ALLOWED) {
         success = create_nsdl_resource(object);
+    } else if (object) {
+        // Not published, but still needs to be found when creating instances with POST.
+        // Observation handler is needed for getting the object out from the index on deletion.
+        claim_mutex();
+        if (object->observation_handler() == NULL) {
+            object->set_observation_handler(this);
+        }
+        _base_index.add_path(object);
+        release_mutex();
     }
 
     return success;
@@ -1331,6 +1372,19 @@ bool M2MNsdlInterface::create_nsdl_resource(M2MBase *base)
             base->set_observation_handler(this);
         }
 
+        // Index first, a resource in GRS must always be found by its path
+#ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
+        // Endpoints are not resolved by path
+        const bool indexed = (base->base_type() != M2MBase::ObjectDirectory);
+#else
+        const bool indexed = true;
+#endif
+        if (indexed && !_base_index.add_path(base)) {
+            tr_error("M2MNsdlInterface::create_nsdl_resource - failed to index %s", base->uri_path());
+            release_mutex();
+            return false;
+        }
+
         result = sn_nsdl_put_resource(_nsdl_handle, nsdl_resource);
 
         // Put under observation if auto-obs feature is set.
@@ -1374,6 +1428,8 @@ bool M2MNsdlInterface::create_nsdl_resource(M2MBase *base)
         if (result == 0 ||
             result == SN_GRS_RESOURCE_ALREADY_EXISTS){
             success = true;
+        } else if (indexed) {
+            _base_index.remove(base);
         }
     }
     release_mutex();
@@ -1413,189 +1469,39 @@ uint64_t M2MNsdlInterface::registration_time() const
 M2MBase* M2MNsdlInterface::find_resource(const String &object_name,
                                          const uint16_t msg_id) const
 {
-    tr_debug("M2MNsdlInterface::find_resource(object level) - from %p name (%s) ", this, object_name.c_str());
-    M2MObject *current = NULL;
+    tr_debug("M2MNsdlInterface::find_resource - from %p name (%s) msgid (%d)", this, object_name.c_str(), msg_id);
     M2MBase *found = NULL;
-    if(!_base_list.empty()) {
-        M2MBaseList::const_iterator it;
-        it = _base_list.begin();
-        for ( ; it != _base_list.end(); it++ ) {
-            if ((*it)->base_type() == M2MBase::Object) {
-                current = (M2MObject*)*it;
-                if (!msg_id) {
-                    tr_debug("M2MNsdlInterface::find_resource(object level) - path (%s)",
-                             (char*)current->uri_path());
-                    if (strcmp((char*)current->uri_path(), object_name.c_str()) == 0) {
-                        found = current;
-                        tr_debug("M2MNsdlInterface::find_resource(%s) found", object_name.c_str());
-                        break;
-                    }
-                } else {
-                    uint16_t stored_msg_id = current->get_notification_msgid();
-                    tr_debug("M2MNsdlInterface::find_resource(object level) - stored msgid (%d)", stored_msg_id);
-                    if (stored_msg_id == msg_id) {
-                        found = current;
-                        tr_debug("M2MNsdlInterface::find_resource - msg id found");
-                        break;
-                    }
-                }
-                found = find_resource(current, object_name, msg_id);
-                if(found != NULL) {
-                    break;
-                }
-            }
-#ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
-            else if ((*it)->base_type() == M2MBase::ObjectDirectory) {
-                M2MEndpoint *ep = (M2MEndpoint*)*it;
-                if(!strcmp((char*)(*it)->uri_path(), object_name.c_str())) {
-                    found = NULL;
-                    break;
-                } else {
-                    found = find_resource(ep, object_name, msg_id);
-                }
-                if(found != NULL) {
-                    break;
-                }
-            }
-#endif
-        }
+    if (!msg_id) {
+        found = _base_index.find_by_path(object_name.c_str());
+    } else {
+        found = _base_index.find_by_msgid(msg_id);
     }
     return found;
 }
 
-#ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
-M2MBase* M2MNsdlInterface::find_resource(const M2MEndpoint *endpoint,
-                                         const String &object_name,
-                                         const uint16_t msg_id) const
+void M2MNsdlInterface::remove_object_from_index(M2MObject *object)
 {
-    tr_debug("M2MNsdlInterface::find_resource(endpoint level) - name (%s)", object_name.c_str());
-    M2MBase *object = NULL;
-    if(endpoint) {
-        const M2MObjectList &list = endpoint->objects();
-        if(!list.empty()) {
-            M2MObjectList::const_iterator it;
-            it = list.begin();
-            for ( ; it != list.end(); it++ ) {
-                if (!msg_id) {
-                    if (!strcmp((char*)(*it)->uri_path(), object_name.c_str())) {
-                        tr_debug("M2MNsdlInterface::find_resource(endpoint level) - object %p object name (%s)",
-                            object, object_name.c_str());
-                        object = (*it);
-                        break;
-                    }
-                } else {
-                    uint16_t stored_msg_id = (*it)->get_notification_msgid();
-                    tr_debug("M2MNsdlInterface::find_resource(endpoint level) - stored msgid (%d)", stored_msg_id);
-                    if (stored_msg_id == msg_id) {
-                        object = (*it);
-                        break;
-                    }
-                }
-                object = find_resource((*it),object_name, msg_id);
-                if(object != NULL){
-                    break;
+    const M2MObjectInstanceList &instance_list = object->instances();
+    M2MObjectInstanceList::const_iterator inst = instance_list.begin();
+    for ( ; inst != instance_list.end(); inst++ ) {
+        const M2MResourceList &res_list = (*inst)->resources();
+        M2MResourceList::const_iterator res = res_list.begin();
+        for ( ; res != res_list.end(); res++ ) {
+            if ((*res)->supports_multiple_instances()) {
+                const M2MResourceInstanceList &res_inst_list = (*res)->resource_instances();
+                M2MResourceInstanceList::const_iterator res_inst = res_inst_list.begin();
+                for ( ; res_inst != res_inst_list.end(); res_inst++ ) {
+                    _base_index.remove(*res_inst);
                 }
             }
-        }
-    }
-    return object;
-}
+            _base_index.remove(*res);
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+            remove_composite_notification(*res);
 #endif
-
-M2MBase* M2MNsdlInterface::find_resource(const M2MObject *object,
-                                         const String &object_instance,
-                                         const uint16_t msg_id) const
-{
-    M2MBase *instance = NULL;
-    if(object) {
-        const M2MObjectInstanceList &list = object->instances();
-        if(!list.empty()) {
-            M2MObjectInstanceList::const_iterator it;
-            it = list.begin();
-            for ( ; it != list.end(); it++ ) {
-                if (!msg_id) {
-                    if(!strcmp((char*)(*it)->uri_path(), object_instance.c_str())){
-                        instance = (*it);
-                        tr_debug("M2MNsdlInterface::find_resource(object instance level) - found (%s)",
-                                 (char*)(*it)->uri_path());
-                        break;
-                    }
-                } else {
-                    uint16_t stored_msg_id = (*it)->get_notification_msgid();
-                    if (stored_msg_id == msg_id) {
-                        instance = (*it);
-                        tr_debug("M2MNsdlInterface::find_resource(object instance level) - found msgid (%d)", stored_msg_id);
-                        break;
-                    }
-                }
-                instance = find_resource((*it),object_instance, msg_id);
-                if(instance != NULL){
-                    break;
-                }
-            }
-        }
-    }
-    return instance;
-}
-
-M2MBase* M2MNsdlInterface::find_resource(const M2MObjectInstance *object_instance,
-                                         const String &resource_instance,
-                                         const uint16_t msg_id) const
-{
-    M2MBase *instance = NULL;
-    if(object_instance) {
-        const M2MResourceList &list = object_instance->resources();
-        if(!list.empty()) {
-            M2MResourceList::const_iterator it;
-            it = list.begin();
-            for ( ; it != list.end(); it++ ) {
-                if (!msg_id) {
-                    if(!strcmp((char*)(*it)->uri_path(), resource_instance.c_str())) {
-                        instance = *it;
-                        break;
-                    }
-                    else if((*it)->supports_multiple_instances()) {
-                        instance = find_resource((*it), (*it)->uri_path(),
-                                                 resource_instance);
-                        if(instance != NULL){
-                            break;
-                        }
-                    }
-                } else {
-                    uint16_t stored_msg_id = (*it)->get_notification_msgid();
-                    if (stored_msg_id == msg_id) {
-                        instance = *it;
-                        tr_debug("M2MNsdlInterface::find_resource(resource level) - found msgid (%d)", stored_msg_id);
-                        break;
-                    }
-                }
-            }
-        }
-    }
-    return instance;
-}
-
-M2MBase* M2MNsdlInterface::find_resource(const M2MResource *resource,
-                                         const String &object_name,
-                                         const String &resource_instance) const
-{
-    M2MBase *res = NULL;
-    if(resource) {
-        if(resource->supports_multiple_instances()) {
-            const M2MResourceInstanceList &list = resource->resource_instances();
-            if(!list.empty()) {
-                M2MResourceInstanceList::const_iterator it;
-                it = list.begin();
-                for ( ; it != list.end(); it++ ) {
-                    if(!strcmp((char*)(*it)->uri_path(), resource_instance.c_str())){
-                        res = (*it);
-                        break;
-                    }
-                }
-            }
         }
+        _base_index.remove(*inst);
     }
-    return res;
+    _base_index.remove(object);
 }
 
 bool M2MNsdlInterface::object_present(M2MBase* base) const
@@ -1650,6 +1556,9 @@ bool M2MNsdlInterface::remove_object_from_list(M2MBase* object)
     int index;
     if(object && (-1 != (index = object_index(object)))) {
         tr_debug("  object found at index %d", index);
+        if (object->base_type() == M2MBase::Object) {
+            remove_object_from_index(static_cast<M2MObject*>(object));
+        }
         _base_list.erase(index);
         success = true;
     }
@@ -1743,10 +1652,16 @@ void M2MNsdlInterface::send_object_observation(M2MObject *object,
         uint32_t length = 0;
         uint8_t token[MAX_TOKEN_SIZE];
         uint8_t token_length = 0;
+        M2MSenMLSerializer::Format senml_format;
+        const bool is_senml = M2MSenMLSerializer::is_senml(object->coap_content_type(), senml_format);
 
         // Send whole object structure
         if (send_object) {
-            value = M2MTLVSerializer::serialize(object->instances(), length);
+            if (is_senml) {
+                value = M2MSenMLSerializer::serialize(*object, object->instances(), senml_format, length);
+            } else {
+                value = M2MTLVSerializer::serialize(object->instances(), length);
+            }
         }
         // Send only changed object instances
         else {
@@ -1760,7 +1675,11 @@ void M2MNsdlInterface::send_object_observation(M2MObject *object,
                 }
             }
             if (!list.empty()) {
-                value = M2MTLVSerializer::serialize(list, length);
+                if (is_senml) {
+                    value = M2MSenMLSerializer::serialize(*object, list, senml_format, length);
+                } else {
+                    value = M2MTLVSerializer::serialize(list, length);
+                }
                 list.clear();
             }
         }
@@ -1788,7 +1707,12 @@ void M2MNsdlInterface::send_object_instance_observation(M2MObjectInstance *objec
         uint8_t token[MAX_TOKEN_SIZE];
         uint8_t token_length = 0;
 
-        value = M2MTLVSerializer::serialize(object_instance->resources(), length);
+        M2MSenMLSerializer::Format senml_format;
+        if (M2MSenMLSerializer::is_senml(object_instance->coap_content_type(), senml_format)) {
+            value = M2MSenMLSerializer::serialize(*object_instance, senml_format, length);
+        } else {
+            value = M2MTLVSerializer::serialize(object_instance->resources(), length);
+        }
 
         object_instance->get_observation_token((uint8_t*)&token,token_length);
 
@@ -1817,14 +1741,19 @@ void M2MNsdlInterface::send_resource_observation(M2MResource *resource,
 
         resource->get_observation_token((uint8_t*)token,token_length);
         uint16_t content_type = resource->coap_content_type();
-        if (M2MResourceBase::OPAQUE == resource->resource_instance_type()) {
-            content_type = COAP_CONTENT_OMA_OPAQUE_TYPE;
-        }
-
-        if (resource->resource_instance_count() > 0 || content_type == COAP_CONTENT_OMA_TLV_TYPE) {
-            value = M2MTLVSerializer::serialize(resource, length);
+        M2MSenMLSerializer::Format senml_format;
+        if (M2MSenMLSerializer::is_senml(content_type, senml_format)) {
+            value = M2MSenMLSerializer::serialize(*resource, senml_format, length);
         } else {
-            resource->get_value(value,length);
+            if (M2MResourceBase::OPAQUE == resource->resource_instance_type()) {
+                content_type = COAP_CONTENT_OMA_OPAQUE_TYPE;
+            }
+
+            if (resource->resource_instance_count() > 0 || content_type == COAP_CONTENT_OMA_TLV_TYPE) {
+                value = M2MTLVSerializer::serialize(resource, length);
+            } else {
+                resource->get_value(value,length);
+            }
         }
 
         resource->report_handler()->set_blockwise_notify(is_blockwise_needed(length));
@@ -1838,6 +1767,187 @@ void M2MNsdlInterface::send_resource_observation(M2MResource *resource,
         memory_free(value);
     }
 }
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+void M2MNsdlInterface::queue_composite_notification(M2MResource *resource)
+{
+    M2MResourceList::const_iterator it = _composite_pending.begin();
+    for (; it != _composite_pending.end(); it++) {
+        if (*it == resource) {
+            // Value is read when the notification is sent
+            return;
+        }
+    }
+    _composite_pending.push_back(resource);
+
+    if (!_composite_timer_running && _composite_in_flight.empty()) {
+        _composite_timer_running = true;
+        _composite_timer.start_timer(MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL,
+                                     M2MTimerObserver::CompositeNotification);
+    }
+}
+
+void M2MNsdlInterface::send_composite_notification()
+{
+    if (!_composite_in_flight.empty() || !_nsdl_execution_timer_running || !_registered) {
+        // Sent once the previous composite notification is delivered or after registration
+        return;
+    }
+
+    // Observations may have been cancelled during the flush window
+    for (int i = _composite_pending.size() - 1; i >= 0; i--) {
+        if (!_composite_pending[i]->is_under_observation()) {
+            _composite_pending[i]->report_handler()->set_notification_send_in_progress(false);
+            _composite_pending.erase(i);
+        }
+    }
+    if (_composite_pending.empty()) {
+        return;
+    }
+    if (_notification_send_ongoing) {
+        // Carrier would not get a message id, retry when the ongoing one is delivered
+        _composite_timer_running = true;
+        _composite_timer.start_timer(MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL,
+                                     M2MTimerObserver::CompositeNotification);
+        return;
+    }
+
+    M2MResource *carrier = _composite_pending[0];
+    uint16_t content_type = carrier->coap_content_type();
+    M2MSenMLSerializer::Format senml_format = M2MSenMLSerializer::CBOR;
+    bool use_tlv = false;
+    if (content_type == COAP_CONTENT_OMA_TLV_TYPE || content_type == COAP_CONTENT_OMA_TLV_TYPE_OLD) {
+        use_tlv = true;
+        const M2MObjectInstance *parent = &carrier->get_parent_object_instance();
+        for (int i = 1; i < _composite_pending.size() && use_tlv; i++) {
+            use_tlv = (&_composite_pending[i]->get_parent_object_instance() == parent);
+        }
+    }
+    if (!use_tlv && !M2MSenMLSerializer::is_senml(content_type, senml_format)) {
+        content_type = COAP_CONTENT_SENML_CBOR_TYPE;
+    }
+
+    // Take as many pending resources as fit in the maximum payload
+    M2MResourceList batch;
+    uint8_t *value = NULL;
+    uint32_t length = 0;
+    int count = _composite_pending.size();
+    while (count > 0) {
+        batch.clear();
+        for (int i = 0; i < count; i++) {
+            batch.push_back(_composite_pending[i]);
+        }
+        if (use_tlv) {
+            value = M2MTLVSerializer::serialize(batch, length);
+        } else {
+            value = M2MSenMLSerializer::serialize(batch, senml_format, length);
+        }
+        if (!value || length <= MBED_CLIENT_COMPOSITE_NOTIFICATION_MAX_PAYLOAD || count == 1) {
+            break;
+        }
+        memory_free(value);
+        value = NULL;
+        count /= 2;
+    }
+    if (!value) {
+        // Out of memory, keep the resources pending and retry after the window
+        tr_error("M2MNsdlInterface::send_composite_notification - failed to serialize %d resources", count);
+        _composite_timer_running = true;
+        _composite_timer.start_timer(MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL,
+                                     M2MTimerObserver::CompositeNotification);
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        _composite_pending.erase(0);
+    }
+
+    tr_info("M2MNsdlInterface::send_composite_notification - %d resources, %" PRIu32 " bytes, carrier %s",
+            count, length, carrier->uri_path());
+
+    uint8_t token[MAX_TOKEN_SIZE];
+    uint8_t token_length = 0;
+    carrier->get_observation_token((uint8_t*)token, token_length);
+    carrier->report_handler()->set_blockwise_notify(is_blockwise_needed(length));
+
+    clear_sent_blockwise_messages();
+    _notification_send_ongoing = true;
+    int32_t msgid = sn_nsdl_send_observation_notification(_nsdl_handle, token, token_length, value, length,
+                                                          sn_coap_observe_e(carrier->observation_number()),
+                                                          COAP_MSG_TYPE_CONFIRMABLE,
+                                                          sn_coap_content_format_e(content_type), -1);
+    execute_notification_delivery_status_cb(carrier, msgid);
+    memory_free(value);
+
+    for (int i = 1; i < batch.size(); i++) {
+        M2MResource *resource = batch[i];
+        if (msgid > 0) {
+            // Only the carrier is indexed by the message id, the rest are found through it
+            resource->send_notification_delivery_status(*resource, NOTIFICATION_STATUS_SENT);
+        } else {
+            resource->report_handler()->set_notification_send_in_progress(false);
+            resource->send_notification_delivery_status(*resource, NOTIFICATION_STATUS_BUILD_ERROR);
+        }
+    }
+    if (msgid > 0) {
+        _composite_in_flight = batch;
+    } else {
+        carrier->report_handler()->set_notification_send_in_progress(false);
+    }
+}
+
+bool M2MNsdlInterface::complete_composite_notification(M2MBase *base, NotificationDeliveryStatus status)
+{
+    if (_composite_in_flight.empty() || _composite_in_flight[0] != base) {
+        return false;
+    }
+
+    for (int i = 1; i < _composite_in_flight.size(); i++) {
+        M2MResource *resource = _composite_in_flight[i];
+        resource->report_handler()->set_notification_send_in_progress(false);
+        resource->send_notification_delivery_status(*resource, status);
+        if (status == NOTIFICATION_STATUS_DELIVERED) {
+            resource->notification_sent();
+        }
+    }
+    _composite_in_flight.clear();
+    return true;
+}
+
+void M2MNsdlInterface::clear_composite_notifications()
+{
+    _composite_timer.stop_timer();
+    _composite_timer_running = false;
+
+    // Carrier is handled like any notification in flight, the rest have to be sent again
+    if (!_composite_in_flight.empty()) {
+        complete_composite_notification(_composite_in_flight[0], NOTIFICATION_STATUS_SEND_FAILED);
+    }
+    for (int i = 0; i < _composite_pending.size(); i++) {
+        _composite_pending[i]->report_handler()->set_notification_send_in_progress(false);
+        _composite_pending[i]->report_handler()->set_notification_in_queue(true);
+    }
+    _composite_pending.clear();
+}
+
+void M2MNsdlInterface::remove_composite_notification(M2MBase *base)
+{
+    for (int i = _composite_pending.size() - 1; i >= 0; i--) {
+        if (_composite_pending[i] == base) {
+            _composite_pending.erase(i);
+        }
+    }
+    for (int i = _composite_in_flight.size() - 1; i >= 0; i--) {
+        if (_composite_in_flight[i] == base) {
+            if (i == 0) {
+                // Delivery of the carrier can not be matched any more
+                complete_composite_notification(base, NOTIFICATION_STATUS_SEND_FAILED);
+                break;
+            }
+            _composite_in_flight.erase(i);
+        }
+    }
+}
+#endif
+
 nsdl_s * M2MNsdlInterface::get_nsdl_handle() const
 {
     return _nsdl_handle;
@@ -2370,6 +2480,26 @@ M2MTimer &M2MNsdlInterface::get_nsdl_execution_timer()
     return _nsdl_execution_timer;
 }
 
+const M2MReportTimerWheel &M2MNsdlInterface::get_report_timer_wheel() const
+{
+    return _report_timer_wheel;
+}
+
+const M2MReportQueue &M2MNsdlInterface::get_report_queue() const
+{
+    return _report_queue;
+}
+
+M2MReportQueue *M2MNsdlInterface::report_queue()
+{
+    return &_report_queue;
+}
+
+M2MReportTimerWheel *M2MNsdlInterface::report_timer_wheel()
+{
+    return &_report_timer_wheel;
+}
+
 bool M2MNsdlInterface::is_unregister_ongoing() const
 {
     return _nsdl_handle->unregister_token == 0 ? false : true;
@@ -2461,6 +2591,7 @@ void M2MNsdlInterface::execute_notification_delivery_status_cb(M2MBase* object,
 {
     if (msgid > 0) {
         object->send_notification_delivery_status(*object, NOTIFICATION_STATUS_SENT);
+        _base_index.set_notification_msgid(object, msgid);
         object->set_notification_msgid(msgid);
     } else {
         object->send_notification_delivery_status(*object, NOTIFICATION_STATUS_BUILD_ERROR);
@@ -2583,6 +2714,38 @@ bool M2MNsdlInterface::set_uri_query_parameters(const char *uri_query_params)
     return true;
 }
 
+uint16_t M2MNsdlInterface::get_memory_usage(M2MBase::memory_usage_s *usage, uint16_t count)
+{
+    claim_mutex();
+    uint16_t objects = 0;
+    M2MBaseList::const_iterator it = _base_list.begin();
+    for (; it != _base_list.end(); it++) {
+#ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
+        // Objects of an endpoint are reported as objects of their own
+        if ((*it)->base_type() == M2MBase::ObjectDirectory) {
+            const M2MObjectList &list = ((M2MEndpoint*)(*it))->objects();
+            M2MObjectList::const_iterator obj = list.begin();
+            for (; obj != list.end(); obj++, objects++) {
+                if (usage && objects < count) {
+                    memset(&usage[objects], 0, sizeof(M2MBase::memory_usage_s));
+                    usage[objects].object_id = (*obj)->name_id();
+                    (*obj)->get_memory_usage(usage[objects]);
+                }
+            }
+            continue;
+        }
+#endif
+        if (usage && objects < count) {
+            memset(&usage[objects], 0, sizeof(M2MBase::memory_usage_s));
+            usage[objects].object_id = (*it)->name_id();
+            (*it)->get_memory_usage(usage[objects]);
+        }
+        objects++;
+    }
+    release_mutex();
+    return objects;
+}
+
 void M2MNsdlInterface::clear_sent_blockwise_messages()
 {
     sn_nsdl_clear_coap_sent_blockwise_messages(_nsdl_handle);
@@ -2628,9 +2791,18 @@ void M2MNsdlInterface::calculate_new_coap_ping_send_time()
 
 void M2MNsdlInterface::send_next_notification(bool clear_token)
 {
-    tr_debug("M2MNsdlInterface::send_next_notification");
+    tr_debug("M2MNsdlInterface::send_next_notification - queue depth %" PRIu32 ", drained %" PRIu32,
+             _report_queue.depth(), _report_queue.drained());
     claim_mutex();
-    if (!_base_list.empty()) {
+    if (!clear_token) {
+        // Pending reporters are kept in a ready queue, so there is no need to walk the tree
+        M2MReportHandler *reporter = _report_queue.first();
+        if (reporter) {
+            reporter->schedule_report(true);
+            release_mutex();
+            return;
+        }
+    } else if (!_base_list.empty()) {
         M2MBaseList::const_iterator base_iterator;
         base_iterator = _base_list.begin();
         for ( ; base_iterator != _base_list.end(); base_iterator++ ) {
@@ -2758,6 +2930,13 @@ struct M2MNsdlInterface::nsdl_coap_data_s* M2MNsdlInterface::create_coap_event_d
 
         if (nsdl_coap_data->address.addr_ptr) {
             memcpy(nsdl_coap_data->address.addr_ptr, address->addr_ptr, address->addr_len);
+
+            // Token and options may still refer to the received packet which is gone when the event runs.
+            if (sn_coap_parser_detach_from_packet(nsdl_handle->grs->coap, received_coap_header) != 0) {
+                memory_free(nsdl_coap_data->address.addr_ptr);
+                memory_free(nsdl_coap_data);
+                return NULL;
+            }
             nsdl_coap_data->received_coap_header = received_coap_header;
             nsdl_coap_data->received_coap_header->msg_type = COAP_MSG_TYPE_CONFIRMABLE;
             nsdl_coap_data->received_coap_header->msg_code = (sn_coap_msg_code_e)coap_msg_code;
@@ -2794,6 +2973,11 @@ struct M2MNsdlInterface::nsdl_coap_data_s* M2MNsdlInterface::create_coap_event_d
 void M2MNsdlInterface::set_registration_status(bool registered)
 {
     _registered = registered;
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+    claim_mutex();
+    clear_composite_notifications();
+    release_mutex();
+#endif
 }
 
 void M2MNsdlInterface::handle_register_response(const sn_coap_hdr_s *coap_header)
@@ -3111,6 +3295,11 @@ void M2MNsdlInterface::handle_empty_ack(const sn_coap_hdr_s *coap_header, bool i
             base->set_under_observation(false, this);
             _notification_send_ongoing = false;
             base->send_notification_delivery_status(*base, NOTIFICATION_STATUS_UNSUBSCRIBED);
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+            if (complete_composite_notification(base, NOTIFICATION_STATUS_UNSUBSCRIBED) && !_composite_timer_running) {
+                send_composite_notification();
+            }
+#endif
             _notification_handler->send_notification(this);
         }
     } else if (is_bootstrap_msg) {
@@ -3158,6 +3347,12 @@ void M2MNsdlInterface::handle_notification_delivered(M2MBase *base)
     base->report_handler()->set_notification_send_in_progress(false);
     _notification_send_ongoing = false;
     base->send_notification_delivery_status(*base, NOTIFICATION_STATUS_DELIVERED);
+#if MBED_CLIENT_COMPOSITE_NOTIFICATION_INTERVAL > 0
+    if (complete_composite_notification(base, NOTIFICATION_STATUS_DELIVERED) && !_composite_timer_running) {
+        // Rest of the pending notifications did not fit in, they have already waited one window
+        send_composite_notification();
+    }
+#endif
     _notification_handler->send_notification(this);
 
     // Supported only in Resource level
@@ -26,6 +26,7 @@
 #include "mbed-client/m2mconstants.h"
 #include "include/m2mtlvserializer.h"
 #include "include/m2mtlvdeserializer.h"
+#include "include/m2msenmlserializer.h"
 #include "include/m2mreporthandler.h"
 #include "mbed-trace/mbed_trace.h"
 #include "mbed-client/m2mstringbuffer.h"
@@ -49,6 +50,7 @@ M2MObject::M2MObject(const String &object_name, char *path, bool external_blockw
 #ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
     ,_endpoint(NULL)
 #endif
+    ,_transaction_depth(0)
 {
     M2MBase::set_base_type(M2MBase::Object);
     M2MBase::set_operation(M2MBase::GET_ALLOWED);
@@ -63,6 +65,7 @@ M2MObject::M2MObject(const M2MBase::lwm2m_parameters_s* static_res)
 #ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
     ,_endpoint(NULL)
 #endif
+    ,_transaction_depth(0)
 {
     M2MBase::set_operation(M2MBase::GET_ALLOWED);
     if(M2MBase::name_id() != -1) {
@@ -134,6 +137,19 @@ M2MObjectInstance* M2MObject::create_object_instance(const lwm2m_parameters_s* s
     return instance;
 }
 
+void M2MObject::add_static_object_instances(const m2m_static_object_instance_s *instances, uint16_t count)
+{
+    _instance_list.reserve(_instance_list.size() + count);
+    for (uint16_t i = 0; i < count; i++) {
+        const m2m_static_object_instance_s &definition = instances[i];
+        M2MObjectInstance *instance = new M2MObjectInstance(*this, definition.params);
+        instance->set_instance_id(definition.instance_id);
+        instance->add_static_resources(definition.resources, definition.resource_count);
+        _instance_list.push_back(instance);
+    }
+    set_changed();
+}
+
 bool M2MObject::remove_object_instance(uint16_t inst_id)
 {
     tr_debug("M2MObject::remove_object_instance(inst_id %d)", inst_id);
@@ -187,6 +203,16 @@ uint16_t M2MObject::instance_count() const
     return (uint16_t)_instance_list.size();
 }
 
+void M2MObject::get_memory_usage(memory_usage_s &usage) const
+{
+    add_memory_usage(usage, sizeof(M2MObject) + _instance_list.capacity() * sizeof(M2MObjectInstance*));
+
+    M2MObjectInstanceList::const_iterator it = _instance_list.begin();
+    for (; it != _instance_list.end(); it++) {
+        (*it)->get_memory_usage(usage);
+    }
+}
+
 M2MObservationHandler* M2MObject::observation_handler() const
 {
     // XXX: need to check the flag too
@@ -240,6 +266,7 @@ sn_coap_hdr_s* M2MObject::handle_get_request(nsdl_s *nsdl,
             if(coap_response) {
                 bool content_type_present = false;
                 bool is_content_type_supported = true;
+                M2MSenMLSerializer::Format senml_format;
 
                 if (received_coap_header->options_list_ptr &&
                         received_coap_header->options_list_ptr->accept != COAP_CT_NONE) {
@@ -251,7 +278,8 @@ sn_coap_hdr_s* M2MObject::handle_get_request(nsdl_s *nsdl,
                 // Check if preferred content type is supported
                 if (content_type_present) {
                     if (coap_response->content_format != COAP_CONTENT_OMA_TLV_TYPE_OLD &&
-                        coap_response->content_format != COAP_CONTENT_OMA_TLV_TYPE) {
+                        coap_response->content_format != COAP_CONTENT_OMA_TLV_TYPE &&
+                        !M2MSenMLSerializer::is_senml(coap_response->content_format, senml_format)) {
                         is_content_type_supported = false;
                     }
                 }
@@ -259,7 +287,8 @@ sn_coap_hdr_s* M2MObject::handle_get_request(nsdl_s *nsdl,
                 if (is_content_type_supported) {
                     if(!content_type_present &&
                        (M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE ||
-                        M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE_OLD)) {
+                        M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE_OLD ||
+                        M2MSenMLSerializer::is_senml(M2MBase::coap_content_type(), senml_format))) {
                         coap_response->content_format = sn_coap_content_format_e(M2MBase::coap_content_type());
                     }
 
@@ -268,6 +297,9 @@ sn_coap_hdr_s* M2MObject::handle_get_request(nsdl_s *nsdl,
                        COAP_CONTENT_OMA_TLV_TYPE_OLD == coap_response->content_format) {
                         set_coap_content_type(coap_response->content_format);
                         data = M2MTLVSerializer::serialize(_instance_list, data_length);
+                    } else if (M2MSenMLSerializer::is_senml(coap_response->content_format, senml_format)) {
+                        set_coap_content_type(coap_response->content_format);
+                        data = M2MSenMLSerializer::serialize(*this, _instance_list, senml_format, data_length);
                     }
 
                     coap_response->payload_len = data_length;
@@ -506,6 +538,9 @@ sn_coap_hdr_s* M2MObject::handle_post_request(nsdl_s *nsdl,
                                 case M2MTLVDeserializer::OutOfMemory:
                                     msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
                                     break;
+                                case M2MTLVDeserializer::Incomplete:
+                                    msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE;
+                                    break;
                             }
 
                         } else {
@@ -544,6 +579,32 @@ void M2MObject::notification_update(uint16_t obj_instance_id)
     }
 }
 
+void M2MObject::begin_transaction()
+{
+    _transaction_depth++;
+}
+
+void M2MObject::commit_transaction()
+{
+    if (!_transaction_depth || --_transaction_depth) {
+        return;
+    }
+
+    tr_debug("M2MObject::commit_transaction()");
+    M2MObjectInstanceList::const_iterator it = _instance_list.begin();
+    for (; it != _instance_list.end(); it++) {
+        // Instances still in their own transaction are reported on its commit
+        if (!(*it)->is_in_transaction()) {
+            (*it)->report_pending_changes();
+        }
+    }
+}
+
+bool M2MObject::is_in_transaction() const
+{
+    return _transaction_depth != 0;
+}
+
 #ifdef MBED_CLOUD_CLIENT_EDGE_EXTENSION
 void M2MObject::set_endpoint(M2MEndpoint *endpoint)
 {
@@ -23,6 +23,9 @@
 #include "mbed-client/m2mstringbuffer.h"
 #include "include/m2mtlvserializer.h"
 #include "include/m2mtlvdeserializer.h"
+#include "include/m2msenmlserializer.h"
+#include "include/m2msenmldeserializer.h"
+#include "include/m2mtlvstreamdeserializer.h"
 #include "include/m2mreporthandler.h"
 #include "mbed-trace/mbed_trace.h"
 #include "include/m2mcallbackstorage.h"
@@ -43,7 +46,11 @@ M2MObjectInstance::M2MObjectInstance(M2MObject& parent,
           path,
           external_blockwise_store,
           false),
-  _parent(parent)
+  _parent(parent),
+  _transaction_depth(0)
+#ifndef DISABLE_BLOCK_MESSAGE
+ ,_tlv_stream(NULL)
+#endif
 {
     M2MBase::set_base_type(M2MBase::ObjectInstance);
     M2MBase::set_coap_content_type(COAP_CONTENT_OMA_TLV_TYPE_OLD);
@@ -51,7 +58,10 @@ M2MObjectInstance::M2MObjectInstance(M2MObject& parent,
 }
 
 M2MObjectInstance::M2MObjectInstance(M2MObject& parent, const lwm2m_parameters_s* static_res)
-: M2MBase(static_res), _parent(parent)
+: M2MBase(static_res), _parent(parent), _transaction_depth(0)
+#ifndef DISABLE_BLOCK_MESSAGE
+ ,_tlv_stream(NULL)
+#endif
 {
     M2MBase::set_coap_content_type(COAP_CONTENT_OMA_TLV_TYPE_OLD);
     M2MBase::set_operation(M2MBase::GET_ALLOWED);
@@ -59,6 +69,9 @@ M2MObjectInstance::M2MObjectInstance(M2MObject& parent, const lwm2m_parameters_s
 
 M2MObjectInstance::~M2MObjectInstance()
 {
+#ifndef DISABLE_BLOCK_MESSAGE
+    delete _tlv_stream;
+#endif
     if(!_resource_list.empty()) {
         M2MResource* res = NULL;
         M2MResourceList::const_iterator it;
@@ -376,6 +389,16 @@ uint16_t M2MObjectInstance::resource_count() const
     return count;
 }
 
+void M2MObjectInstance::get_memory_usage(memory_usage_s &usage) const
+{
+    add_memory_usage(usage, sizeof(M2MObjectInstance) + _resource_list.capacity() * sizeof(M2MResource*));
+
+    M2MResourceList::const_iterator it = _resource_list.begin();
+    for (; it != _resource_list.end(); it++) {
+        (*it)->get_memory_usage(usage);
+    }
+}
+
 uint16_t M2MObjectInstance::resource_count(const String& resource) const
 {
 
@@ -455,6 +478,7 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
             if (coap_response) {
                 bool content_type_present = false;
                 bool is_content_type_supported = true;
+                M2MSenMLSerializer::Format senml_format;
 
                 if (received_coap_header->options_list_ptr &&
                         received_coap_header->options_list_ptr->accept != COAP_CT_NONE) {
@@ -466,7 +490,8 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
                 // Check if preferred content type is supported
                 if (content_type_present) {
                     if (coap_response->content_format != COAP_CONTENT_OMA_TLV_TYPE_OLD &&
-                        coap_response->content_format != COAP_CONTENT_OMA_TLV_TYPE) {
+                        coap_response->content_format != COAP_CONTENT_OMA_TLV_TYPE &&
+                        !M2MSenMLSerializer::is_senml(coap_response->content_format, senml_format)) {
                         is_content_type_supported = false;
                     }
                 }
@@ -474,7 +499,8 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
                 if (is_content_type_supported) {
                     if (!content_type_present &&
                        (M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE ||
-                        M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE_OLD)) {
+                        M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE_OLD ||
+                        M2MSenMLSerializer::is_senml(M2MBase::coap_content_type(), senml_format))) {
                         coap_response->content_format = sn_coap_content_format_e(M2MBase::coap_content_type());
                     }
 
@@ -483,6 +509,9 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
                         COAP_CONTENT_OMA_TLV_TYPE_OLD == coap_response->content_format) {
                         set_coap_content_type(coap_response->content_format);
                         data = M2MTLVSerializer::serialize(_resource_list, data_length);
+                    } else if (M2MSenMLSerializer::is_senml(coap_response->content_format, senml_format)) {
+                        set_coap_content_type(coap_response->content_format);
+                        data = M2MSenMLSerializer::serialize(*this, senml_format, data_length);
                     }
 
                     coap_response->payload_len = data_length;
@@ -557,6 +586,79 @@ sn_coap_hdr_s* M2MObjectInstance::handle_get_request(nsdl_s *nsdl,
     return coap_response;
 }
 
+#ifndef DISABLE_BLOCK_MESSAGE
+/**
+ * Passes a block of a TLV payload to the streaming deserialiser, if the object instance
+ * stores blocks externally and the CoAP library does not reassemble the payload.
+ * A repeat of the previous block is answered again without parsing it twice, a block
+ * out of sequence aborts the payload. Block 0 always starts a new payload.
+ * @param last_block Set to false while more blocks are expected.
+ * @param first_id Set to the identifier of the first record once the last block is received.
+ * @return false if the payload is not received in blocks.
+ */
+static bool deserialize_tlv_block(M2MObjectInstance &object_instance,
+                                  M2MTLVStreamDeserializer *&stream,
+                                  const sn_coap_hdr_s *received_coap_header,
+                                  M2MTLVDeserializer::Operation operation,
+                                  M2MTLVDeserializer::Error &error,
+                                  bool &last_block,
+                                  uint16_t &first_id)
+{
+    if (!received_coap_header->options_list_ptr ||
+        received_coap_header->options_list_ptr->block1 == -1 ||
+        !object_instance.get_nsdl_resource()->static_resource_parameters->external_memory_block) {
+        return false;
+    }
+
+    const int32_t block1 = received_coap_header->options_list_ptr->block1;
+    const uint32_t block_number = block1 >> 4;
+    last_block = !(block1 & 0x08);
+
+    // Block 0 always starts a new payload. Any other repeat of the previous block, sent with
+    // a new message id as mbed-coap drops the duplicates, is either the last block of the
+    // finished payload or a block still followed by more.
+    if (stream && block_number != 0 && block_number + 1 == stream->next_block() &&
+        stream->finished() == last_block) {
+        // Finished stream is kept so that the last block can be answered again
+        tr_debug("M2MObjectInstance - block %d received again", (int)block_number);
+        if (last_block) {
+            error = stream->finish();
+            first_id = stream->first_id();
+        }
+        return true;
+    }
+
+    if (0 == block_number) {
+        delete stream;
+        stream = new M2MTLVStreamDeserializer(object_instance, operation);
+        if (!stream) {
+            last_block = true;
+            error = M2MTLVDeserializer::OutOfMemory;
+            return true;
+        }
+    } else if (!stream || stream->finished() || block_number != stream->next_block()) {
+        tr_error("M2MObjectInstance - block %d received out of sequence", (int)block_number);
+        delete stream;
+        stream = NULL;
+        last_block = true;
+        error = M2MTLVDeserializer::Incomplete;
+        return true;
+    }
+    stream->set_next_block(block_number + 1);
+
+    // Values of one block are reported together, errors with the last block
+    object_instance.begin_transaction();
+    error = stream->push(received_coap_header->payload_ptr, received_coap_header->payload_len);
+    object_instance.commit_transaction();
+
+    if (last_block) {
+        error = stream->finish();
+        first_id = stream->first_id();
+    }
+    return true;
+}
+#endif
+
 sn_coap_hdr_s* M2MObjectInstance::handle_put_request(nsdl_s *nsdl,
                                                      sn_coap_hdr_s *received_coap_header,
                                                      M2MObservationHandler *observation_handler,
@@ -594,42 +696,70 @@ sn_coap_hdr_s* M2MObjectInstance::handle_put_request(nsdl_s *nsdl,
                 free(query);
             }
         } else if ((operation() & SN_GRS_PUT_ALLOWED) != 0) {
+            M2MSenMLSerializer::Format senml_format;
             if(!content_type_present &&
                (M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE ||
-                M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE_OLD)) {
+                M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE_OLD ||
+                M2MSenMLSerializer::is_senml(M2MBase::coap_content_type(), senml_format))) {
                 coap_content_type = M2MBase::coap_content_type();
             }
 
             tr_debug("M2MObjectInstance::handle_put_request() - Request Content-type: %d", coap_content_type);
 
+            const bool is_senml = M2MSenMLSerializer::is_senml(coap_content_type, senml_format);
             if(COAP_CONTENT_OMA_TLV_TYPE == coap_content_type ||
-               COAP_CONTENT_OMA_TLV_TYPE_OLD == coap_content_type ) {
+               COAP_CONTENT_OMA_TLV_TYPE_OLD == coap_content_type ||
+               is_senml) {
                 set_coap_content_type(coap_content_type);
                 M2MTLVDeserializer::Error error = M2MTLVDeserializer::None;
                 if(received_coap_header->payload_ptr) {
-                    error = M2MTLVDeserializer::deserialize_resources(
-                                received_coap_header->payload_ptr,
-                                received_coap_header->payload_len, *this,
-                                M2MTLVDeserializer::Put);
-                    switch(error) {
-                        case M2MTLVDeserializer::None:
-                            if(observation_handler) {
-                                observation_handler->value_updated(this);
-                            }
-                            msg_code = COAP_MSG_CODE_RESPONSE_CHANGED;
-                            break;
-                        case M2MTLVDeserializer::NotFound:
-                            msg_code = COAP_MSG_CODE_RESPONSE_NOT_FOUND;
-                            break;
-                        case M2MTLVDeserializer::NotAllowed:
-                            msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
-                            break;
-                        case M2MTLVDeserializer::NotValid:
-                            msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
-                            break;
-                        case M2MTLVDeserializer::OutOfMemory:
-                            msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
-                            break;
+                    bool last_block = true;
+                    uint16_t first_id = 0;
+                    if (is_senml) {
+                        error = M2MSenMLDeserializer::deserialize_resources(
+                                    received_coap_header->payload_ptr,
+                                    received_coap_header->payload_len,
+                                    senml_format, *this);
+                    }
+#ifndef DISABLE_BLOCK_MESSAGE
+                    else if (deserialize_tlv_block(*this, _tlv_stream, received_coap_header,
+                                                   M2MTLVDeserializer::Put, error, last_block, first_id)) {
+                        if (!last_block && coap_response) {
+                            // Response is sent once the last block is received
+                            coap_response->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
+                        }
+                    }
+#endif
+                    else {
+                        error = M2MTLVDeserializer::deserialize_resources(
+                                    received_coap_header->payload_ptr,
+                                    received_coap_header->payload_len, *this,
+                                    M2MTLVDeserializer::Put);
+                    }
+                    if (last_block) {
+                        switch(error) {
+                            case M2MTLVDeserializer::None:
+                                if(observation_handler) {
+                                    observation_handler->value_updated(this);
+                                }
+                                msg_code = COAP_MSG_CODE_RESPONSE_CHANGED;
+                                break;
+                            case M2MTLVDeserializer::NotFound:
+                                msg_code = COAP_MSG_CODE_RESPONSE_NOT_FOUND;
+                                break;
+                            case M2MTLVDeserializer::NotAllowed:
+                                msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
+                                break;
+                            case M2MTLVDeserializer::NotValid:
+                                msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+                                break;
+                            case M2MTLVDeserializer::OutOfMemory:
+                                msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
+                                break;
+                            case M2MTLVDeserializer::Incomplete:
+                                msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE;
+                                break;
+                        }
                     }
                 }
             } else {
@@ -683,49 +813,67 @@ sn_coap_hdr_s* M2MObjectInstance::handle_post_request(nsdl_s *nsdl,
                COAP_CONTENT_OMA_TLV_TYPE_OLD == coap_content_type) {
                 set_coap_content_type(coap_content_type);
                 M2MTLVDeserializer::Error error = M2MTLVDeserializer::None;
-                error = M2MTLVDeserializer::deserialize_resources(
-                            received_coap_header->payload_ptr,
-                            received_coap_header->payload_len, *this,
-                            M2MTLVDeserializer::Post);
-
-                uint16_t instance_id = M2MTLVDeserializer::instance_id(received_coap_header->payload_ptr);
-                switch(error) {
-                    case M2MTLVDeserializer::None:
-                        if(observation_handler) {
-                            execute_value_updated = true;
-                        }
-                        coap_response->options_list_ptr = sn_nsdl_alloc_options_list(nsdl, coap_response);
-
-                        if (coap_response->options_list_ptr) {
+                bool last_block = true;
+                uint16_t instance_id = 0;
+#ifndef DISABLE_BLOCK_MESSAGE
+                if (deserialize_tlv_block(*this, _tlv_stream, received_coap_header,
+                                          M2MTLVDeserializer::Post, error, last_block, instance_id)) {
+                    if (!last_block && coap_response) {
+                        // Response is sent once the last block is received
+                        coap_response->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
+                    }
+                } else
+#endif
+                {
+                    error = M2MTLVDeserializer::deserialize_resources(
+                                received_coap_header->payload_ptr,
+                                received_coap_header->payload_len, *this,
+                                M2MTLVDeserializer::Post);
 
-                            StringBuffer<MAX_PATH_SIZE_3> obj_name;
-                            if(!build_path(obj_name, _parent.name(), M2MBase::instance_id(), instance_id)) {
-                                msg_code = COAP_MSG_CODE_RESPONSE_INTERNAL_SERVER_ERROR;
-                                break;
+                    instance_id = M2MTLVDeserializer::instance_id(received_coap_header->payload_ptr);
+                }
+                if (last_block) {
+                    switch(error) {
+                        case M2MTLVDeserializer::None:
+                            if(observation_handler) {
+                                execute_value_updated = true;
                             }
+                            coap_response->options_list_ptr = sn_nsdl_alloc_options_list(nsdl, coap_response);
 
-                            coap_response->options_list_ptr->location_path_len = obj_name.get_size();
-                            coap_response->options_list_ptr->location_path_ptr =
-                              alloc_string_copy((uint8_t*)obj_name.c_str(),
-                                                coap_response->options_list_ptr->location_path_len);
-                            // todo: handle allocation error
-                        }
-                        msg_code = COAP_MSG_CODE_RESPONSE_CREATED;
-                        break;
-                    case M2MTLVDeserializer::NotAllowed:
-                        msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
-                        break;
-                    case M2MTLVDeserializer::NotValid:
-                        msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
-                        break;
-                    case M2MTLVDeserializer::NotFound:
-                        msg_code = COAP_MSG_CODE_RESPONSE_NOT_FOUND;
-                        break;
-                    case M2MTLVDeserializer::OutOfMemory:
-                        msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
-                        break;
-                    default:
-                        break;
+                            if (coap_response->options_list_ptr) {
+
+                                StringBuffer<MAX_PATH_SIZE_3> obj_name;
+                                if(!build_path(obj_name, _parent.name(), M2MBase::instance_id(), instance_id)) {
+                                    msg_code = COAP_MSG_CODE_RESPONSE_INTERNAL_SERVER_ERROR;
+                                    break;
+                                }
+
+                                coap_response->options_list_ptr->location_path_len = obj_name.get_size();
+                                coap_response->options_list_ptr->location_path_ptr =
+                                  alloc_string_copy((uint8_t*)obj_name.c_str(),
+                                                    coap_response->options_list_ptr->location_path_len);
+                                // todo: handle allocation error
+                            }
+                            msg_code = COAP_MSG_CODE_RESPONSE_CREATED;
+                            break;
+                        case M2MTLVDeserializer::NotAllowed:
+                            msg_code = COAP_MSG_CODE_RESPONSE_METHOD_NOT_ALLOWED;
+                            break;
+                        case M2MTLVDeserializer::NotValid:
+                            msg_code = COAP_MSG_CODE_RESPONSE_BAD_REQUEST;
+                            break;
+                        case M2MTLVDeserializer::NotFound:
+                            msg_code = COAP_MSG_CODE_RESPONSE_NOT_FOUND;
+                            break;
+                        case M2MTLVDeserializer::OutOfMemory:
+                            msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
+                            break;
+                        case M2MTLVDeserializer::Incomplete:
+                            msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE;
+                            break;
+                        default:
+                            break;
+                    }
                 }
             } else {
                 msg_code =COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT;
@@ -761,6 +909,60 @@ void M2MObjectInstance::notification_update(M2MBase::Observation observation_lev
     }
 }
 
+void M2MObjectInstance::add_static_resources(const lwm2m_parameters_s *resources, uint16_t count)
+{
+    _resource_list.reserve(_resource_list.size() + count);
+    for (uint16_t i = 0; i < count; i++) {
+        M2MResource *res = new M2MResource(*this, &resources[i], (M2MBase::DataType)resources[i].data_type);
+        if (res->supports_multiple_instances()) {
+            res->set_coap_content_type(COAP_CONTENT_OMA_TLV_TYPE_OLD);
+        }
+        _resource_list.push_back(res);
+    }
+}
+
+void M2MObjectInstance::begin_transaction()
+{
+    _transaction_depth++;
+}
+
+void M2MObjectInstance::commit_transaction()
+{
+    if (!_transaction_depth || --_transaction_depth) {
+        return;
+    }
+    if (!_parent.is_in_transaction()) {
+        report_pending_changes();
+    }
+}
+
+bool M2MObjectInstance::is_in_transaction() const
+{
+    return _transaction_depth || _parent.is_in_transaction();
+}
+
+void M2MObjectInstance::report_pending_changes()
+{
+    bool changed = false;
+    M2MResourceList::const_iterator it = _resource_list.begin();
+    for (; it != _resource_list.end(); it++) {
+        M2MResource *res = *it;
+        if (res->supports_multiple_instances()) {
+            M2MResourceInstanceList::const_iterator inst = res->resource_instances().begin();
+            for (; inst != res->resource_instances().end(); inst++) {
+                changed |= (*inst)->report_pending_change();
+            }
+        }
+        changed |= res->report_pending_change();
+    }
+
+    if (changed) {
+        tr_debug("M2MObjectInstance::report_pending_changes() - instance %d changed", instance_id());
+        int observation_level = (int)M2MBase::observation_level() | (int)_parent.observation_level();
+        notification_update((M2MBase::Observation)observation_level);
+    }
+}
+
 M2MBase *M2MObjectInstance::get_parent() const
 {
     return (M2MBase *) &get_parent_object();
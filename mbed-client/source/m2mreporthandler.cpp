@@ -19,8 +19,9 @@
 #include <inttypes.h>
 
 #include "mbed-client/m2mreportobserver.h"
+#include "mbed-client/m2mobservationhandler.h"
+#include "mbed-client/m2mconnectionhandler.h"
 #include "mbed-client/m2mconstants.h"
-#include "mbed-client/m2mtimer.h"
 #include "include/m2mreporthandler.h"
 #include "mbed-trace/mbed_trace.h"
 #include <string.h>
@@ -53,7 +54,10 @@ M2MReportHandler::M2MReportHandler(M2MReportObserver &observer)
   _notification_send_in_progress(false),
   _notification_in_queue(false),
   _blockwise_notify(false),
-  _pmin_quiet_period(false)
+  _pmin_quiet_period(false),
+  _ready_queue(NULL),
+  _ready_prev(NULL),
+  _ready_next(NULL)
 {
     tr_debug("M2MReportHandler::M2MReportHandler()");
 }
@@ -61,6 +65,8 @@ M2MReportHandler::M2MReportHandler(M2MReportObserver &observer)
 M2MReportHandler::~M2MReportHandler()
 {
     tr_debug("M2MReportHandler::~M2MReportHandler()");
+    _is_under_observation = false;
+    update_ready_queue();
     free(_token);
 }
 
@@ -77,6 +83,7 @@ void M2MReportHandler::set_under_observation(bool observed)
     else {
         set_default_values();
     }
+    update_ready_queue();
 }
 
 void M2MReportHandler::set_value(float value)
@@ -370,26 +377,29 @@ void M2MReportHandler::report(bool in_queue)
 void M2MReportHandler::handle_timers()
 {
     tr_debug("M2MReportHandler::handle_timers()");
-    uint64_t time_interval = 0;
+    // pmin and pmax are in seconds, which is the resolution of the timer wheel.
+    // Without a handler the timers are started once the object is observed through one.
+    M2MObservationHandler *handler = _observer.observation_handler();
+    M2MReportTimerWheel *wheel = handler ? handler->report_timer_wheel() : NULL;
     if ((_attribute_state & M2MReportHandler::Pmin) == M2MReportHandler::Pmin) {
         if (_pmin == _pmax) {
             _pmin_exceeded = true;
         } else {
             _pmin_exceeded = false;
-            time_interval = (uint64_t) ((uint64_t)_pmin * 1000);
-            tr_debug("M2MReportHandler::handle_timers() - Start PMIN interval: %d", (int)time_interval);
-            _pmin_timer.start_timer(time_interval,
-                                     M2MTimerObserver::PMinTimer,
-                                     true);
+            tr_debug("M2MReportHandler::handle_timers() - Start PMIN interval: %" PRId32, _pmin);
+            if (wheel) {
+                _pmin_timer.start_timer(*wheel,
+                                        _pmin > 0 ? (uint32_t)_pmin : 0,
+                                        M2MTimerObserver::PMinTimer);
+            }
         }
     }
     if ((_attribute_state & M2MReportHandler::Pmax) == M2MReportHandler::Pmax) {
-        if (_pmax > 0) {
-            time_interval = (uint64_t) ((uint64_t)_pmax * 1000);
-            tr_debug("M2MReportHandler::handle_timers() - Start PMAX interval: %d", (int)time_interval);
-            _pmax_timer.start_timer(time_interval,
-                                     M2MTimerObserver::PMaxTimer,
-                                     true);
+        if (_pmax > 0 && wheel) {
+            tr_debug("M2MReportHandler::handle_timers() - Start PMAX interval: %" PRId32, _pmax);
+            _pmax_timer.start_timer(*wheel,
+                                    (uint32_t)_pmax,
+                                    M2MTimerObserver::PMaxTimer);
         }
     }
 }
@@ -440,6 +450,7 @@ void M2MReportHandler::set_default_values()
     _notification_in_queue = false;
     _notification_send_in_progress = false;
     _pmin_quiet_period = false;
+    update_ready_queue();
 }
 
 bool M2MReportHandler::check_threshold_values() const
@@ -536,6 +547,16 @@ void M2MReportHandler::get_observation_token(uint8_t *token, uint8_t &token_leng
     token_length = _token_length;
 }
 
+void M2MReportHandler::get_memory_usage(M2MBase::memory_usage_s &usage) const
+{
+    usage.report_handlers += sizeof(M2MReportHandler) +
+                             _changed_instance_ids.capacity() * sizeof(uint16_t);
+    if (_token) {
+        // Copy is zero terminated, see alloc_string_copy()
+        usage.tokens += _token_length + 1;
+    }
+}
+
 uint16_t M2MReportHandler::observation_number() const
 {
     return _observation_number;
@@ -576,6 +597,7 @@ uint8_t* M2MReportHandler::alloc_string_copy(const uint8_t* source, uint32_t siz
 void M2MReportHandler::set_notification_in_queue(bool to_queue)
 {
     _notification_in_queue = to_queue;
+    update_ready_queue();
 }
 
 bool M2MReportHandler::notification_in_queue() const
@@ -586,6 +608,7 @@ bool M2MReportHandler::notification_in_queue() const
 void M2MReportHandler::set_notification_send_in_progress(bool progress)
 {
     _notification_send_in_progress = progress;
+    update_ready_queue();
 }
 
 bool M2MReportHandler::notification_send_in_progress() const
@@ -602,3 +625,94 @@ bool M2MReportHandler::blockwise_notify() const
 {
     return _blockwise_notify;
 }
+
+void M2MReportHandler::update_ready_queue()
+{
+    bool pending = _is_under_observation && (_notification_in_queue || _notification_send_in_progress);
+    M2MReportQueue *queue = _ready_queue;
+    if (!queue && pending) {
+        M2MObservationHandler *handler = _observer.observation_handler();
+        if (handler) {
+            queue = handler->report_queue();
+        }
+    }
+    if (queue) {
+        queue->update(*this, pending);
+    }
+}
+
+M2MReportQueue::M2MReportQueue(M2MConnectionHandler &connection_handler)
+: _connection_handler(connection_handler),
+  _head(NULL),
+  _tail(NULL),
+  _depth(0),
+  _drained(0)
+{
+}
+
+M2MReportQueue::~M2MReportQueue()
+{
+    // Handlers may outlive the queue, detach them so that updating them later is safe
+    M2MReportHandler *handler = _head;
+    while (handler) {
+        M2MReportHandler *next = handler->_ready_next;
+        handler->_ready_queue = NULL;
+        handler->_ready_prev = NULL;
+        handler->_ready_next = NULL;
+        handler = next;
+    }
+}
+
+M2MReportHandler *M2MReportQueue::first() const
+{
+    return _head;
+}
+
+uint32_t M2MReportQueue::depth() const
+{
+    return _depth;
+}
+
+uint32_t M2MReportQueue::drained() const
+{
+    return _drained;
+}
+
+void M2MReportQueue::update(M2MReportHandler &handler, bool pending)
+{
+    _connection_handler.claim_mutex();
+    if (pending == (handler._ready_queue != NULL)) {
+        _connection_handler.release_mutex();
+        return;
+    }
+
+    if (pending) {
+        handler._ready_queue = this;
+        handler._ready_prev = _tail;
+        handler._ready_next = NULL;
+        if (_tail) {
+            _tail->_ready_next = &handler;
+        } else {
+            _head = &handler;
+        }
+        _tail = &handler;
+        _depth++;
+    } else {
+        if (handler._ready_prev) {
+            handler._ready_prev->_ready_next = handler._ready_next;
+        } else {
+            _head = handler._ready_next;
+        }
+        if (handler._ready_next) {
+            handler._ready_next->_ready_prev = handler._ready_prev;
+        } else {
+            _tail = handler._ready_prev;
+        }
+        handler._ready_queue = NULL;
+        handler._ready_prev = NULL;
+        handler._ready_next = NULL;
+        _depth--;
+        _drained++;
+    }
+    _connection_handler.release_mutex();
+}
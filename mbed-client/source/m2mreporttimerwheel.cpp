@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// fixup the compilation on ARMCC for PRIu32
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+
+#include "include/m2mreporttimerwheel.h"
+#include "mbed-trace/mbed_trace.h"
+#include "eventOS_event_timer.h"
+
+#include <string.h>
+
+#define TRACE_GROUP "mClt"
+
+#define M2M_REPORT_TIMER_WHEEL_TICK_MS 1000
+
+M2MReportTimer::M2MReportTimer(M2MTimerObserver &observer)
+: _observer(observer),
+  _wheel(NULL),
+  _prev(NULL),
+  _next(NULL),
+  _deadline(0),
+  _type(M2MTimerObserver::Notdefined)
+{
+}
+
+M2MReportTimer::~M2MReportTimer()
+{
+    stop_timer();
+}
+
+void M2MReportTimer::start_timer(M2MReportTimerWheel &wheel, uint32_t interval, M2MTimerObserver::Type type)
+{
+    stop_timer();
+
+    _type = type;
+    wheel.add(*this, interval);
+}
+
+void M2MReportTimer::stop_timer()
+{
+    if (_wheel) {
+        _wheel->remove(*this);
+    }
+}
+
+M2MReportTimerWheel::M2MReportTimerWheel()
+: _tick_timer(*this),
+  _expire_next(NULL),
+  _tick(0),
+  _epoch(0),
+  _armed_deadline(0),
+  _running_timers(0),
+  _expired_on_last_tick(0),
+  _armed(false),
+  _in_tick(false)
+{
+    memset(_slots, 0, sizeof(_slots));
+}
+
+M2MReportTimerWheel::~M2MReportTimerWheel()
+{
+    // Timers may outlive the wheel, detach them so that stopping them later is safe
+    for (int i = 0; i < M2M_REPORT_TIMER_WHEEL_SLOTS; i++) {
+        M2MReportTimer *timer = _slots[i];
+        while (timer) {
+            M2MReportTimer *next = timer->_next;
+            timer->_wheel = NULL;
+            timer->_prev = NULL;
+            timer->_next = NULL;
+            timer = next;
+        }
+    }
+}
+
+uint32_t M2MReportTimerWheel::expired_on_last_tick() const
+{
+    return _expired_on_last_tick;
+}
+
+uint32_t M2MReportTimerWheel::running_timers() const
+{
+    return _running_timers;
+}
+
+void M2MReportTimerWheel::add(M2MReportTimer &timer, uint32_t interval)
+{
+    // Seconds are counted from now if the wheel is idle and from the expiry if the timer
+    // is restarted from one, otherwise the current second has partly passed already.
+    if (!_running_timers && !_in_tick) {
+        _epoch = eventOS_event_timer_ticks();
+    } else if (!_in_tick) {
+        advance();
+        interval++;
+    }
+    if (!interval) {
+        interval = 1;
+    }
+
+    timer._deadline = _tick + interval;
+    timer._wheel = this;
+
+    // Add to the head so that a timer restarted while expiring its own slot is not visited again
+    M2MReportTimer *&slot = _slots[timer._deadline & (M2M_REPORT_TIMER_WHEEL_SLOTS - 1)];
+    timer._prev = NULL;
+    timer._next = slot;
+    if (slot) {
+        slot->_prev = &timer;
+    }
+    slot = &timer;
+    _running_timers++;
+
+    // Expiry arms the timer once all the due timers are handled
+    if (!_in_tick && (!_armed || (int32_t)(timer._deadline - _armed_deadline) < 0)) {
+        arm(timer._deadline);
+    }
+}
+
+void M2MReportTimerWheel::remove(M2MReportTimer &timer)
+{
+    if (_expire_next == &timer) {
+        _expire_next = timer._next;
+    }
+    if (timer._prev) {
+        timer._prev->_next = timer._next;
+    } else {
+        _slots[timer._deadline & (M2M_REPORT_TIMER_WHEEL_SLOTS - 1)] = timer._next;
+    }
+    if (timer._next) {
+        timer._next->_prev = timer._prev;
+    }
+    timer._wheel = NULL;
+    timer._prev = NULL;
+    timer._next = NULL;
+    _running_timers--;
+
+    if (!_in_tick && _armed && timer._deadline == _armed_deadline) {
+        rearm();
+    }
+}
+
+void M2MReportTimerWheel::advance()
+{
+    const uint32_t seconds = eventOS_event_timer_ticks_to_ms(eventOS_event_timer_ticks() - _epoch) /
+                             M2M_REPORT_TIMER_WHEEL_TICK_MS;
+    _tick += seconds;
+    _epoch += eventOS_event_timer_ms_to_ticks(seconds * M2M_REPORT_TIMER_WHEEL_TICK_MS);
+}
+
+bool M2MReportTimerWheel::earliest_deadline(uint32_t &deadline) const
+{
+    // Slots are visited in time order, a timer due within this round of the wheel ends
+    // the search. Otherwise all the timers are further away and the closest one is taken.
+    bool found = false;
+    for (uint32_t tick = _tick + 1; tick != _tick + 1 + M2M_REPORT_TIMER_WHEEL_SLOTS; tick++) {
+        for (M2MReportTimer *timer = _slots[tick & (M2M_REPORT_TIMER_WHEEL_SLOTS - 1)]; timer; timer = timer->_next) {
+            if (timer->_deadline == tick) {
+                deadline = tick;
+                return true;
+            }
+            if (!found || (int32_t)(timer->_deadline - deadline) < 0) {
+                deadline = timer->_deadline;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+void M2MReportTimerWheel::arm(uint32_t deadline)
+{
+    // Deadline is counted from the start of the current tick
+    const int32_t seconds = (int32_t)(deadline - _tick);
+    const uint32_t elapsed = eventOS_event_timer_ticks_to_ms(eventOS_event_timer_ticks() - _epoch);
+    uint64_t wait = 0;
+    if (seconds > 0 && (uint64_t)seconds * M2M_REPORT_TIMER_WHEEL_TICK_MS > elapsed) {
+        wait = (uint64_t)seconds * M2M_REPORT_TIMER_WHEEL_TICK_MS - elapsed;
+    }
+    if (wait > M2M_REPORT_TIMER_WHEEL_MAX_WAIT_MS) {
+        // Expires early and is aimed again
+        wait = M2M_REPORT_TIMER_WHEEL_MAX_WAIT_MS;
+    }
+    _armed = true;
+    _armed_deadline = deadline;
+    _tick_timer.start_timer(wait, M2MTimerObserver::ReportTimerWheel, true);
+}
+
+void M2MReportTimerWheel::rearm()
+{
+    uint32_t deadline;
+    if (earliest_deadline(deadline)) {
+        arm(deadline);
+    } else {
+        _armed = false;
+        _tick_timer.stop_timer();
+    }
+}
+
+void M2MReportTimerWheel::timer_expired(M2MTimerObserver::Type /*type*/)
+{
+    const uint32_t last_tick = _tick;
+    advance();
+    _armed = false;
+    _in_tick = true;
+    _expired_on_last_tick = 0;
+
+    // Visit the slots of the seconds passed since the last expiry, each at most once.
+    // Expiry callbacks may start and stop any timer, including the next one to be checked,
+    // a timer started from a callback is due later and is not expired again.
+    uint32_t slots = _tick - last_tick;
+    if (slots > M2M_REPORT_TIMER_WHEEL_SLOTS) {
+        slots = M2M_REPORT_TIMER_WHEEL_SLOTS;
+    }
+    for (uint32_t i = 1; i <= slots; i++) {
+        M2MReportTimer *timer = _slots[(last_tick + i) & (M2M_REPORT_TIMER_WHEEL_SLOTS - 1)];
+        while (timer) {
+            _expire_next = timer->_next;
+            if ((int32_t)(timer->_deadline - _tick) <= 0) {
+                remove(*timer);
+                _expired_on_last_tick++;
+                timer->_observer.timer_expired(timer->_type);
+            }
+            timer = _expire_next;
+        }
+    }
+    _expire_next = NULL;
+    _in_tick = false;
+
+    if (_expired_on_last_tick) {
+        tr_debug("M2MReportTimerWheel::timer_expired - %" PRIu32 " timers expired", _expired_on_last_tick);
+    }
+
+    rearm();
+}
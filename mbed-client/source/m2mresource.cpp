@@ -19,6 +19,7 @@
 #include "include/m2mreporthandler.h"
 #include "include/m2mtlvserializer.h"
 #include "include/m2mtlvdeserializer.h"
+#include "include/m2msenmlserializer.h"
 #include "mbed-trace/mbed_trace.h"
 
 #include <stdlib.h>
@@ -211,6 +212,23 @@ uint16_t M2MResource::resource_instance_count() const
     return (uint16_t)_resource_instance_list.size();
 }
 
+void M2MResource::get_memory_usage(memory_usage_s &usage) const
+{
+    add_memory_usage(usage, sizeof(M2MResource) +
+                            _resource_instance_list.capacity() * sizeof(M2MResourceInstance*));
+    add_value_memory_usage(usage);
+#ifndef DISABLE_DELAYED_RESPONSE
+    if (_delayed_token) {
+        usage.tokens += _delayed_token_len;
+    }
+#endif
+
+    M2MResourceInstanceList::const_iterator it = _resource_instance_list.begin();
+    for (; it != _resource_instance_list.end(); it++) {
+        (*it)->get_memory_usage(usage);
+    }
+}
+
 #ifndef DISABLE_DELAYED_RESPONSE
 bool M2MResource::delayed_response() const
 {
@@ -321,6 +339,7 @@ sn_coap_hdr_s* M2MResource::handle_get_request(nsdl_s *nsdl,
                 if(coap_response) {
                     bool content_type_present = false;
                     bool is_content_type_supported = true;
+                    M2MSenMLSerializer::Format senml_format;
 
                     if (received_coap_header->options_list_ptr &&
                             received_coap_header->options_list_ptr->accept != COAP_CT_NONE) {
@@ -331,7 +350,8 @@ sn_coap_hdr_s* M2MResource::handle_get_request(nsdl_s *nsdl,
                     // Check if preferred content type is supported
                     if (content_type_present) {
                         if (coap_response->content_format != COAP_CONTENT_OMA_TLV_TYPE_OLD &&
-                            coap_response->content_format != COAP_CONTENT_OMA_TLV_TYPE) {
+                            coap_response->content_format != COAP_CONTENT_OMA_TLV_TYPE &&
+                            !M2MSenMLSerializer::is_senml(coap_response->content_format, senml_format)) {
                             is_content_type_supported = false;
                         }
                     }
@@ -339,7 +359,8 @@ sn_coap_hdr_s* M2MResource::handle_get_request(nsdl_s *nsdl,
                     if (is_content_type_supported) {
                         if(!content_type_present &&
                            (M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE ||
-                            M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE_OLD)) {
+                            M2MBase::coap_content_type() == COAP_CONTENT_OMA_TLV_TYPE_OLD ||
+                            M2MSenMLSerializer::is_senml(M2MBase::coap_content_type(), senml_format))) {
                             coap_response->content_format = sn_coap_content_format_e(M2MBase::coap_content_type());
                         }
 
@@ -352,6 +373,9 @@ sn_coap_hdr_s* M2MResource::handle_get_request(nsdl_s *nsdl,
                            COAP_CONTENT_OMA_TLV_TYPE_OLD == coap_response->content_format) {
                             set_coap_content_type(coap_response->content_format);
                             data = M2MTLVSerializer::serialize(this, data_length);
+                        } else if (M2MSenMLSerializer::is_senml(coap_response->content_format, senml_format)) {
+                            set_coap_content_type(coap_response->content_format);
+                            data = M2MSenMLSerializer::serialize(*this, senml_format, data_length);
                         }
 
                         coap_response->payload_len = data_length;
@@ -510,6 +534,9 @@ sn_coap_hdr_s* M2MResource::handle_put_request(nsdl_s *nsdl,
                         case M2MTLVDeserializer::OutOfMemory:
                             msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
                             break;
+                        case M2MTLVDeserializer::Incomplete:
+                            msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE;
+                            break;
                     }
                 } else {
                     msg_code =COAP_MSG_CODE_RESPONSE_UNSUPPORTED_CONTENT_FORMAT;
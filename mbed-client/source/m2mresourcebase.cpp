@@ -37,6 +37,7 @@
 #include "include/m2mreporthandler.h"
 #include "include/nsdllinker.h"
 #include "include/m2mtlvserializer.h"
+#include "include/m2msenmlserializer.h"
 #include "mbed-client/m2mblockmessage.h"
 #include "mbed-trace/mbed_trace.h"
 
@@ -70,7 +71,10 @@ M2MResourceBase::M2MResourceBase(
 #ifndef DISABLE_BLOCK_MESSAGE
  ,_block_message_data(NULL),
 #endif
-  _notification_status(M2MResourceBase::INIT)
+  _notification_status(M2MResourceBase::INIT),
+  _native_value_type(NATIVE_VALUE_NONE),
+  _native_value_rendered(false),
+  _report_pending(false)
 {
 }
 
@@ -96,7 +100,10 @@ M2MResourceBase::M2MResourceBase(
 #ifndef DISABLE_BLOCK_MESSAGE
  ,_block_message_data(NULL),
 #endif
- _notification_status(M2MResourceBase::INIT)
+ _notification_status(M2MResourceBase::INIT),
+ _native_value_type(NATIVE_VALUE_NONE),
+ _native_value_rendered(false),
+ _report_pending(false)
 {
     M2MBase::set_base_type(M2MBase::ResourceInstance);
     if( value != NULL && value_length > 0 ) {
@@ -113,7 +120,10 @@ M2MResourceBase::M2MResourceBase(
 #ifndef DISABLE_BLOCK_MESSAGE
   ,_block_message_data(NULL),
 #endif
-  _notification_status(M2MResourceBase::INIT)
+  _notification_status(M2MResourceBase::INIT),
+  _native_value_type(NATIVE_VALUE_NONE),
+  _native_value_rendered(false),
+  _report_pending(false)
 {
     // we are not there yet for this check as this is called from M2MResource(): assert(base_type() == M2MBase::ResourceInstance);
 }
@@ -210,12 +220,18 @@ void M2MResourceBase::clear_value()
     free(res->resource);
     res->resource = NULL;
     res->resource_len = 0;
+    _native_value_type = NATIVE_VALUE_NONE;
 
     report();
 }
 
 bool M2MResourceBase::set_value_float(float value)
 {
+    if (can_store_native_value()) {
+        set_native_value(NATIVE_VALUE_FLOAT, 0, value);
+        return true;
+    }
+
     bool success;
     char buffer[REGISTRY_FLOAT_STRING_MAX_LEN];
 
@@ -230,6 +246,11 @@ bool M2MResourceBase::set_value_float(float value)
 
 bool M2MResourceBase::set_value(int64_t value)
 {
+    if (can_store_native_value()) {
+        set_native_value(NATIVE_VALUE_INT, value, 0);
+        return true;
+    }
+
     bool success;
     char buffer[REGISTRY_INT64_STRING_MAX_LEN];
     uint32_t size = m2m::itoa_c(value, buffer);
@@ -291,13 +312,19 @@ void M2MResourceBase::update_value(uint8_t *value, const uint32_t value_length)
     free(res->resource);
     res->resource = value;
     res->resource_len = value_length;
+    _native_value_type = NATIVE_VALUE_NONE;
     if (changed) {
         report_value_change();
     }
 }
 
-void M2MResourceBase::report()
+void M2MResourceBase::report(bool notify_instance)
 {
+    if (get_parent_resource().get_parent_object_instance().is_in_transaction()) {
+        _report_pending = true;
+        return;
+    }
+
     M2MBase::Observation observation_level = M2MBase::observation_level();
     tr_debug("M2MResourceBase::report() - level %d", observation_level);
 
@@ -312,8 +339,9 @@ void M2MResourceBase::report()
 
     tr_debug("M2MResourceBase::report() - combined level %d", parent_observation_level);
 
-    if((M2MBase::O_Attribute & parent_observation_level) == M2MBase::O_Attribute ||
-       (M2MBase::OI_Attribute & parent_observation_level) == M2MBase::OI_Attribute) {
+    if(notify_instance &&
+       ((M2MBase::O_Attribute & parent_observation_level) == M2MBase::O_Attribute ||
+        (M2MBase::OI_Attribute & parent_observation_level) == M2MBase::OI_Attribute)) {
         tr_debug("M2MResourceBase::report() -- object/instance level");
         M2MObjectInstance& object_instance = get_parent_resource().get_parent_object_instance();
         object_instance.notification_update((M2MBase::Observation)parent_observation_level);
@@ -357,6 +385,7 @@ void M2MResourceBase::report()
 bool M2MResourceBase::has_value_changed(const uint8_t* value, const uint32_t value_len)
 {
     bool changed = false;
+    render_native_value();
     sn_nsdl_dynamic_resource_parameters_s* res = get_nsdl_resource();
 
     if(value_len != res->resource_len) {
@@ -375,8 +404,13 @@ bool M2MResourceBase::has_value_changed(const uint8_t* value, const uint32_t val
     return changed;
 }
 
-void M2MResourceBase::report_value_change()
+void M2MResourceBase::report_value_change(bool notify_instance)
 {
+    if (get_parent_resource().get_parent_object_instance().is_in_transaction()) {
+        _report_pending = true;
+        return;
+    }
+
     if (resource_instance_type() == M2MResourceBase::STRING ||
         resource_instance_type() == M2MResourceBase::OPAQUE) {
         M2MReportHandler *report_handler = M2MBase::report_handler();
@@ -384,7 +418,17 @@ void M2MResourceBase::report_value_change()
             report_handler->set_notification_trigger();
         }
     }
-    report();
+    report(notify_instance);
+}
+
+bool M2MResourceBase::report_pending_change()
+{
+    if (!_report_pending) {
+        return false;
+    }
+    _report_pending = false;
+    report_value_change(false);
+    return true;
 }
 
 void M2MResourceBase::execute(void *arguments)
@@ -450,6 +494,7 @@ void M2MResourceBase::get_value(uint8_t *&value, uint32_t &value_length)
         value = NULL;
     }
 
+    render_native_value();
     sn_nsdl_dynamic_resource_parameters_s* res = get_nsdl_resource();
     if(res->resource && res->resource_len > 0) {
         value = alloc_string_copy(res->resource, res->resource_len);
@@ -461,6 +506,12 @@ void M2MResourceBase::get_value(uint8_t *&value, uint32_t &value_length)
 
 int64_t M2MResourceBase::get_value_int() const
 {
+    if (_native_value_type == NATIVE_VALUE_INT) {
+        return _native_value._int;
+    } else if (_native_value_type == NATIVE_VALUE_FLOAT) {
+        return (int64_t)_native_value._float;
+    }
+
     int64_t value_int = 0;
 
     const char *value_string = (char *)value();
@@ -485,6 +536,7 @@ String M2MResourceBase::get_value_string() const
 {
     // XXX: do a better constructor to avoid pointless malloc
     String value;
+    render_native_value();
     if (get_nsdl_resource()->resource) {
         value.append_raw((char*)get_nsdl_resource()->resource, get_nsdl_resource()->resource_len);
     }
@@ -493,6 +545,12 @@ String M2MResourceBase::get_value_string() const
 
 float M2MResourceBase::get_value_float() const
 {
+    if (_native_value_type == NATIVE_VALUE_FLOAT) {
+        return _native_value._float;
+    } else if (_native_value_type == NATIVE_VALUE_INT) {
+        return (float)_native_value._int;
+    }
+
     float value_float = 0;
 
     const char *value_string = (char *)value();
@@ -515,11 +573,13 @@ float M2MResourceBase::get_value_float() const
 
 uint8_t* M2MResourceBase::value() const
 {
+    render_native_value();
     return get_nsdl_resource()->resource;
 }
 
 uint32_t M2MResourceBase::value_length() const
 {
+    render_native_value();
     return get_nsdl_resource()->resource_len;
 }
 
@@ -543,6 +603,7 @@ sn_coap_hdr_s* M2MResourceBase::handle_get_request(nsdl_s *nsdl,
         if ((operation() & SN_GRS_GET_ALLOWED) != 0) {
             if (coap_response) {
                 bool content_type_present = false;
+                M2MSenMLSerializer::Format senml_format;
                 if (received_coap_header->options_list_ptr &&
                     received_coap_header->options_list_ptr->accept != COAP_CT_NONE) {
                     content_type_present = true;
@@ -577,6 +638,8 @@ sn_coap_hdr_s* M2MResourceBase::handle_get_request(nsdl_s *nsdl,
                     if (coap_response->content_format == COAP_CONTENT_OMA_TLV_TYPE ||
                         coap_response->content_format == COAP_CONTENT_OMA_TLV_TYPE_OLD) {
                         coap_response->payload_ptr = M2MTLVSerializer::serialize(&get_parent_resource(), payload_len);
+                    } else if (M2MSenMLSerializer::is_senml(coap_response->content_format, senml_format)) {
+                        coap_response->payload_ptr = M2MSenMLSerializer::serialize(*this, senml_format, payload_len);
                     } else {
                         get_value(coap_response->payload_ptr,payload_len);
                     }
@@ -756,6 +819,19 @@ sn_coap_hdr_s* M2MResourceBase::handle_put_request(nsdl_s *nsdl,
 }
 
 
+void M2MResourceBase::add_value_memory_usage(memory_usage_s &usage) const
+{
+    const sn_nsdl_dynamic_resource_parameters_s *res = get_nsdl_resource();
+    if (res->resource) {
+        usage.values += res->resource_len;
+    }
+#ifndef DISABLE_BLOCK_MESSAGE
+    if (_block_message_data) {
+        usage.values += sizeof(M2MBlockMessage) + _block_message_data->block_data_len();
+    }
+#endif
+}
+
 #ifndef DISABLE_BLOCK_MESSAGE
 
 M2MBlockMessage* M2MResourceBase::block_message() const
@@ -931,5 +1007,74 @@ void M2MResourceBase::publish_value_in_registration_msg(bool publish_value)
     } else {
         pub_value = (uint8_t)publish_value;
     }
+    // nsdl reads the published value directly from the resource
+    render_native_value();
     param->dynamic_resource_params->publish_value = pub_value;
 }
+
+bool M2MResourceBase::can_store_native_value() const
+{
+    const M2MBase::lwm2m_parameters_s* param = M2MBase::get_lwm2m_parameters();
+    const M2MResourceBase::ResourceType type = convert_data_type(param->data_type);
+
+    return (type == M2MResourceBase::INTEGER ||
+            type == M2MResourceBase::FLOAT ||
+            type == M2MResourceBase::BOOLEAN ||
+            type == M2MResourceBase::TIME) &&
+           mode() == M2MBase::Dynamic &&
+           !param->read_write_callback_set &&
+           !param->dynamic_resource_params->publish_value &&
+           !M2MCallbackStorage::does_callback_exist(*this, M2MCallbackAssociation::M2MResourceBaseValueSetCallback);
+}
+
+void M2MResourceBase::set_native_value(NativeValueType type, int64_t int_value, float float_value)
+{
+    bool changed = true;
+    if (_native_value_type != NATIVE_VALUE_NONE || get_nsdl_resource()->resource) {
+        if (type == NATIVE_VALUE_INT) {
+            changed = (get_value_int() != int_value);
+        } else {
+            changed = (get_value_float() != float_value);
+        }
+    }
+
+    if (changed || _native_value_type != type) {
+        if (type == NATIVE_VALUE_INT) {
+            _native_value._int = int_value;
+        } else {
+            _native_value._float = float_value;
+        }
+        _native_value_type = type;
+        _native_value_rendered = false;
+    }
+
+    if (changed) {
+        report_value_change();
+    }
+}
+
+void M2MResourceBase::render_native_value() const
+{
+    if (_native_value_type == NATIVE_VALUE_NONE || _native_value_rendered) {
+        return;
+    }
+
+    char buffer[REGISTRY_FLOAT_STRING_MAX_LEN];
+    uint32_t size;
+    if (_native_value_type == NATIVE_VALUE_FLOAT) {
+        size = snprintf(buffer, REGISTRY_FLOAT_STRING_MAX_LEN, "%f", _native_value._float);
+    } else {
+        size = m2m::itoa_c(_native_value._int, buffer);
+    }
+
+    // Reuse the previous text buffer if the length did not change
+    sn_nsdl_dynamic_resource_parameters_s* res = get_nsdl_resource();
+    if (!res->resource || res->resource_len != size) {
+        free(res->resource);
+        res->resource = alloc_string_copy((const uint8_t*)buffer, size);
+        res->resource_len = res->resource ? size : 0;
+    } else {
+        memcpy(res->resource, buffer, size);
+    }
+    _native_value_rendered = (res->resource != NULL);
+}
@@ -137,6 +137,12 @@ M2MResource& M2MResourceInstance::get_parent_resource() const
     return _parent_resource;
 }
 
+void M2MResourceInstance::get_memory_usage(memory_usage_s &usage) const
+{
+    add_memory_usage(usage, sizeof(M2MResourceInstance));
+    add_value_memory_usage(usage);
+}
+
 M2MBase *M2MResourceInstance::get_parent() const
 {
     return (M2MBase *) &get_parent_resource();
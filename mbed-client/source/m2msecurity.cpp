@@ -140,6 +140,14 @@ M2MObjectInstance* M2MSecurity::create_object_instance(ServerType server_type)
             res->set_operation(M2MBase::NOT_ALLOWED);
         }
 
+        res = server_instance->create_dynamic_resource(SECURITY_TLS_SESSION,
+                                                        OMA_RESOURCE_TYPE,
+                                                        M2MResourceInstance::OPAQUE,
+                                                        false);
+        if (res) {
+            res->set_operation(M2MBase::NOT_ALLOWED);
+        }
+
         if (M2MSecurity::M2MServer == server_type) {
             res = server_instance->create_dynamic_resource(SECURITY_SHORT_SERVER_ID,
                                                             OMA_RESOURCE_TYPE,
@@ -325,7 +333,8 @@ int M2MSecurity::resource_value_buffer(SecurityResource resource,
             M2MSecurity::Secretkey == resource ||
             M2MSecurity::OpenCertificateChain == resource ||
             M2MSecurity::CloseCertificateChain == resource ||
-            M2MSecurity::ReadDeviceCertificateChain == resource) {
+            M2MSecurity::ReadDeviceCertificateChain == resource ||
+            M2MSecurity::TLSSession == resource) {
             return res->read_resource_value(*(M2MResourceBase *)res, data, buffer_len);
         }
     }
@@ -455,6 +464,9 @@ M2MResource* M2MSecurity::get_resource(SecurityResource res, uint16_t instance_i
             case ReadDeviceCertificateChain:
                 res_name_ptr = SECURITY_READ_CERTIFICATE_CHAIN;
                 break;
+            case TLSSession:
+                res_name_ptr = SECURITY_TLS_SESSION;
+                break;
         }
 
         if (res_name_ptr) {
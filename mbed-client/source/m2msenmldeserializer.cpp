@@ -0,0 +1,835 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "include/m2msenmldeserializer.h"
+#include "mbed-client/m2mconstants.h"
+#include "mbed-client/m2mresource.h"
+#include "mbed-client/m2mstringbuffer.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common_functions.h"
+#include "mbed-trace/mbed_trace.h"
+
+#define TRACE_GROUP "mClt"
+
+// SenML labels, RFC 8428 chapter 6
+#define SENML_LABEL_BASE_VALUE      -5
+#define SENML_LABEL_BASE_NAME       -2
+#define SENML_LABEL_NAME            0
+#define SENML_LABEL_VALUE           2
+#define SENML_LABEL_STRING_VALUE    3
+#define SENML_LABEL_BOOLEAN_VALUE   4
+#define SENML_LABEL_DATA_VALUE      8
+#define SENML_LABEL_OBJLINK_VALUE   127 // text label "vlo" only
+#define SENML_LABEL_UNKNOWN         126
+
+#define CBOR_TYPE_UNSIGNED      0
+#define CBOR_TYPE_NEGATIVE      1
+#define CBOR_TYPE_BYTES         2
+#define CBOR_TYPE_TEXT          3
+#define CBOR_TYPE_ARRAY         4
+#define CBOR_TYPE_MAP           5
+#define CBOR_TYPE_SIMPLE        7
+#define CBOR_INDEFINITE         31
+#define CBOR_BREAK              0xff
+
+#define NUMBER_STRING_MAX_LEN   40
+
+// Full name is base name + name
+#define FULL_NAME_SIZE          (M2MBase::MAX_PATH_SIZE * 2)
+
+namespace {
+
+typedef enum {
+    ValueNone,
+    ValueNumber,
+    ValueString,
+    ValueBoolean,
+    ValueData,
+    ValueObjlnk
+} ValueKind;
+
+struct senml_string_s {
+    const uint8_t   *ptr;
+    uint32_t        length;
+    bool            escaped; // JSON string with escape sequences, or base64url data
+};
+
+struct senml_number_s {
+    bool            integer;
+    int64_t         int_value;
+    double          float_value;
+};
+
+struct senml_record_s {
+    senml_string_s  name;
+    ValueKind       kind;
+    senml_number_s  number;
+    bool            boolean;
+    senml_string_s  string;
+};
+
+/*
+ * Parses one record at a time from a SenML-CBOR or SenML-JSON array.
+ * Base name and base value are kept across the records as specified in RFC 8428.
+ */
+class SenMLReader {
+public:
+    SenMLReader(const uint8_t *payload, uint32_t payload_size, M2MSenMLSerializer::Format format)
+    : _end(payload + payload_size), _ptr(payload), _format(format),
+      _remaining(0), _records(0), _indefinite(false), _started(false), _error(false), _has_base_value(false)
+    {
+        memset(&_base_name, 0, sizeof(_base_name));
+        memset(&_base_value, 0, sizeof(_base_value));
+    }
+
+    /*
+     * Returns true and fills in the record if one was read. On end of the array or
+     * on a parse error false is returned, error() tells which one.
+     */
+    bool next(senml_record_s &record)
+    {
+        memset(&record, 0, sizeof(record));
+        if (!_started) {
+            _started = true;
+            if (!begin()) {
+                _error = true;
+                return false;
+            }
+        }
+        _error = false;
+        if (!more_records()) {
+            return false;
+        }
+        if (!(_format == M2MSenMLSerializer::CBOR ? read_cbor_record(record) : read_json_record(record))) {
+            _error = true;
+            return false;
+        }
+        if (record.kind == ValueNumber && _has_base_value) {
+            add_base_value(record.number);
+        }
+        return true;
+    }
+
+    bool error() const
+    {
+        return _error;
+    }
+
+    const senml_string_s &base_name() const
+    {
+        return _base_name;
+    }
+
+private:
+
+    bool begin()
+    {
+        if (_format == M2MSenMLSerializer::JSON) {
+            return skip_json_space() && *_ptr++ == '[';
+        }
+        uint8_t major;
+        uint64_t value;
+        if (!read_cbor_head(major, value) || major != CBOR_TYPE_ARRAY) {
+            return false;
+        }
+        _remaining = value;
+        return true;
+    }
+
+    bool more_records()
+    {
+        if (_format == M2MSenMLSerializer::CBOR) {
+            if (_indefinite) {
+                if (_ptr < _end && *_ptr == CBOR_BREAK) {
+                    _ptr++;
+                    _remaining = 0;
+                    _indefinite = false;
+                    return false;
+                }
+                if (_ptr >= _end) {
+                    _error = true;
+                    return false;
+                }
+                return true;
+            }
+            if (_remaining == 0) {
+                return false;
+            }
+            _remaining--;
+            return true;
+        }
+
+        if (!skip_json_space()) {
+            _error = true;
+            return false;
+        }
+        if (*_ptr == ']') {
+            _ptr++;
+            return false;
+        }
+        if (_records++ > 0 && !expect_json(',')) {
+            _error = true;
+            return false;
+        }
+        return true;
+    }
+
+    void add_base_value(senml_number_s &number)
+    {
+        if (number.integer && _base_value.integer) {
+            number.int_value += _base_value.int_value;
+        } else {
+            double value = number.integer ? (double)number.int_value : number.float_value;
+            value += _base_value.integer ? (double)_base_value.int_value : _base_value.float_value;
+            number.integer = false;
+            number.float_value = value;
+        }
+    }
+
+    void store_field(int label, const senml_record_s &field, senml_record_s &record)
+    {
+        switch (label) {
+            case SENML_LABEL_BASE_NAME:
+                _base_name = field.string;
+                break;
+            case SENML_LABEL_BASE_VALUE:
+                _base_value = field.number;
+                _has_base_value = true;
+                break;
+            case SENML_LABEL_NAME:
+                record.name = field.string;
+                break;
+            case SENML_LABEL_VALUE:
+                record.kind = ValueNumber;
+                record.number = field.number;
+                break;
+            case SENML_LABEL_BOOLEAN_VALUE:
+                record.kind = ValueBoolean;
+                record.boolean = field.boolean;
+                break;
+            case SENML_LABEL_STRING_VALUE:
+                record.kind = ValueString;
+                record.string = field.string;
+                break;
+            case SENML_LABEL_DATA_VALUE:
+                record.kind = ValueData;
+                record.string = field.string;
+                break;
+            case SENML_LABEL_OBJLINK_VALUE:
+                record.kind = ValueObjlnk;
+                record.string = field.string;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Expected value kind of a field, ValueNone for the fields not used here
+    static ValueKind field_kind(int label)
+    {
+        switch (label) {
+            case SENML_LABEL_BASE_VALUE:
+            case SENML_LABEL_VALUE:
+                return ValueNumber;
+            case SENML_LABEL_BOOLEAN_VALUE:
+                return ValueBoolean;
+            case SENML_LABEL_DATA_VALUE:
+                return ValueData;
+            case SENML_LABEL_BASE_NAME:
+            case SENML_LABEL_NAME:
+            case SENML_LABEL_STRING_VALUE:
+            case SENML_LABEL_OBJLINK_VALUE:
+                return ValueString;
+            default:
+                return ValueNone;
+        }
+    }
+
+    static int text_label(const uint8_t *key, uint32_t length)
+    {
+        static const struct {
+            const char  *name;
+            int         label;
+        } labels[] = {
+            { "bn", SENML_LABEL_BASE_NAME },
+            { "bv", SENML_LABEL_BASE_VALUE },
+            { "n", SENML_LABEL_NAME },
+            { "v", SENML_LABEL_VALUE },
+            { "vs", SENML_LABEL_STRING_VALUE },
+            { "vb", SENML_LABEL_BOOLEAN_VALUE },
+            { "vd", SENML_LABEL_DATA_VALUE },
+            { "vlo", SENML_LABEL_OBJLINK_VALUE }
+        };
+        for (uint32_t i = 0; i < sizeof(labels) / sizeof(labels[0]); i++) {
+            if (strlen(labels[i].name) == length && memcmp(labels[i].name, key, length) == 0) {
+                return labels[i].label;
+            }
+        }
+        return SENML_LABEL_UNKNOWN;
+    }
+
+    // CBOR
+
+    bool read_cbor_head(uint8_t &major, uint64_t &value)
+    {
+        if (_ptr >= _end) {
+            return false;
+        }
+        major = *_ptr >> 5;
+        const uint8_t info = *_ptr++ & 0x1f;
+        if (info < 24) {
+            value = info;
+            return true;
+        }
+        if (info == CBOR_INDEFINITE && (major == CBOR_TYPE_ARRAY || major == CBOR_TYPE_MAP)) {
+            _indefinite = (major == CBOR_TYPE_ARRAY) ? true : _indefinite;
+            value = UINT64_MAX;
+            return true;
+        }
+        if (info > 27) {
+            return false;
+        }
+        const uint32_t length = 1 << (info - 24);
+        if ((uint32_t)(_end - _ptr) < length) {
+            return false;
+        }
+        value = 0;
+        for (uint32_t i = 0; i < length; i++) {
+            value = (value << 8) | *_ptr++;
+        }
+        return true;
+    }
+
+    bool read_cbor_record(senml_record_s &record)
+    {
+        uint8_t major;
+        uint64_t pairs;
+        if (!read_cbor_head(major, pairs) || major != CBOR_TYPE_MAP) {
+            return false;
+        }
+        const bool indefinite = (pairs == UINT64_MAX);
+        for (uint64_t i = 0; indefinite || i < pairs; i++) {
+            if (indefinite && _ptr < _end && *_ptr == CBOR_BREAK) {
+                _ptr++;
+                break;
+            }
+
+            int label;
+            uint64_t value;
+            if (!read_cbor_head(major, value)) {
+                return false;
+            }
+            if (major == CBOR_TYPE_UNSIGNED && value <= 127) {
+                label = (int)value;
+            } else if (major == CBOR_TYPE_NEGATIVE && value < 127) {
+                label = -1 - (int)value;
+            } else if (major == CBOR_TYPE_TEXT && value <= (uint64_t)(_end - _ptr)) {
+                label = text_label(_ptr, (uint32_t)value);
+                _ptr += value;
+            } else {
+                return false;
+            }
+
+            senml_record_s field;
+            memset(&field, 0, sizeof(field));
+            if (!read_cbor_value(field_kind(label), field)) {
+                return false;
+            }
+            store_field(label, field, record);
+        }
+        return true;
+    }
+
+    bool read_cbor_value(ValueKind kind, senml_record_s &field)
+    {
+        uint8_t major;
+        uint64_t value;
+        const uint8_t initial = (_ptr < _end) ? *_ptr : 0;
+        if (!read_cbor_head(major, value)) {
+            return false;
+        }
+
+        switch (major) {
+            case CBOR_TYPE_UNSIGNED:
+            case CBOR_TYPE_NEGATIVE:
+                if (value > INT64_MAX || (kind != ValueNumber && kind != ValueNone)) {
+                    return false;
+                }
+                field.number.integer = true;
+                field.number.int_value = (major == CBOR_TYPE_UNSIGNED) ? (int64_t)value : -1 - (int64_t)value;
+                return true;
+            case CBOR_TYPE_BYTES:
+            case CBOR_TYPE_TEXT:
+                if (value > (uint64_t)(_end - _ptr) ||
+                    (kind != ValueNone && kind != (major == CBOR_TYPE_BYTES ? ValueData : ValueString))) {
+                    return false;
+                }
+                field.string.ptr = _ptr;
+                field.string.length = (uint32_t)value;
+                _ptr += value;
+                return true;
+            case CBOR_TYPE_SIMPLE:
+                if (initial == 0xf4 || initial == 0xf5) {
+                    field.boolean = (initial == 0xf5);
+                    return kind == ValueBoolean || kind == ValueNone;
+                }
+                if (initial < 0xf9 || initial > 0xfb || (kind != ValueNumber && kind != ValueNone)) {
+                    // null and undefined are accepted only for the unused fields
+                    return kind == ValueNone && (initial == 0xf6 || initial == 0xf7);
+                }
+                field.number.integer = false;
+                field.number.float_value = decode_cbor_float(initial, value);
+                return true;
+            default:
+                // Containers are not used in SenML records
+                return false;
+        }
+    }
+
+    static double decode_cbor_float(uint8_t initial, uint64_t bits)
+    {
+        if (initial == 0xfb) {
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        if (initial == 0xfa) {
+            uint32_t bits32 = (uint32_t)bits;
+            float value;
+            memcpy(&value, &bits32, sizeof(value));
+            return value;
+        }
+
+        // Half precision, RFC 7049 appendix D
+        const uint32_t half = (uint32_t)bits;
+        const int exponent = (half >> 10) & 0x1f;
+        const int mantissa = half & 0x3ff;
+        double value;
+        if (exponent == 0) {
+            value = mantissa * (1.0 / (1 << 24));
+        } else if (exponent != 31) {
+            value = (mantissa + 1024) * (exponent >= 25 ? (double)(1 << (exponent - 25)) : 1.0 / (1 << (25 - exponent)));
+        } else {
+            value = mantissa == 0 ? HUGE_VAL : NAN;
+        }
+        return (half & 0x8000) ? -value : value;
+    }
+
+    // JSON
+
+    bool skip_json_space()
+    {
+        while (_ptr < _end && (*_ptr == ' ' || *_ptr == '\t' || *_ptr == '\r' || *_ptr == '\n')) {
+            _ptr++;
+        }
+        return _ptr < _end;
+    }
+
+    bool expect_json(uint8_t c)
+    {
+        if (!skip_json_space() || *_ptr != c) {
+            return false;
+        }
+        _ptr++;
+        return true;
+    }
+
+    bool read_json_string(senml_string_s &string)
+    {
+        if (!expect_json('"')) {
+            return false;
+        }
+        string.ptr = _ptr;
+        string.escaped = false;
+        while (_ptr < _end && *_ptr != '"') {
+            if (*_ptr == '\\') {
+                string.escaped = true;
+                _ptr++;
+            }
+            _ptr++;
+        }
+        if (_ptr >= _end) {
+            return false;
+        }
+        string.length = (uint32_t)(_ptr - string.ptr);
+        _ptr++;
+        return true;
+    }
+
+    bool read_json_record(senml_record_s &record)
+    {
+        if (!expect_json('{')) {
+            return false;
+        }
+        if (expect_json('}')) {
+            return true;
+        }
+        do {
+            senml_string_s key;
+            if (!read_json_string(key) || key.escaped || !expect_json(':')) {
+                return false;
+            }
+            const int label = text_label(key.ptr, key.length);
+            senml_record_s field;
+            memset(&field, 0, sizeof(field));
+            if (!read_json_value(field_kind(label), field)) {
+                return false;
+            }
+            store_field(label, field, record);
+        } while (expect_json(','));
+        return expect_json('}');
+    }
+
+    bool read_json_value(ValueKind kind, senml_record_s &field)
+    {
+        if (!skip_json_space()) {
+            return false;
+        }
+        const uint8_t c = *_ptr;
+        if (c == '"') {
+            // Data values are base64url encoded strings
+            if (kind != ValueString && kind != ValueData && kind != ValueNone) {
+                return false;
+            }
+            if (!read_json_string(field.string)) {
+                return false;
+            }
+            field.string.escaped |= (kind == ValueData);
+            return true;
+        }
+        if (c == 't' || c == 'f' || c == 'n') {
+            const char *literal = (c == 't') ? "true" : (c == 'f') ? "false" : "null";
+            const uint32_t length = strlen(literal);
+            if ((uint32_t)(_end - _ptr) < length || memcmp(_ptr, literal, length) != 0) {
+                return false;
+            }
+            _ptr += length;
+            field.boolean = (c == 't');
+            return kind == ValueNone || (kind == ValueBoolean && c != 'n');
+        }
+        if (kind != ValueNumber && kind != ValueNone) {
+            return false;
+        }
+        return read_json_number(field.number);
+    }
+
+    bool read_json_number(senml_number_s &number)
+    {
+        char buffer[NUMBER_STRING_MAX_LEN + 1];
+        uint32_t length = 0;
+        bool integer = true;
+        while (_ptr < _end && length < NUMBER_STRING_MAX_LEN &&
+               ((*_ptr >= '0' && *_ptr <= '9') || *_ptr == '-' || *_ptr == '+' ||
+                *_ptr == '.' || *_ptr == 'e' || *_ptr == 'E')) {
+            integer &= (*_ptr != '.' && *_ptr != 'e' && *_ptr != 'E');
+            buffer[length++] = *_ptr++;
+        }
+        buffer[length] = '\0';
+        if (length == 0) {
+            return false;
+        }
+
+        char *end = NULL;
+        number.integer = integer;
+        if (integer) {
+            number.int_value = strtoll(buffer, &end, 10);
+        } else {
+            number.float_value = strtod(buffer, &end);
+        }
+        return end == buffer + length;
+    }
+
+    const uint8_t                   *_end;
+    const uint8_t                   *_ptr;
+    M2MSenMLSerializer::Format      _format;
+    uint64_t                        _remaining;
+    uint32_t                        _records;
+    bool                            _indefinite;
+    bool                            _started;
+    bool                            _error;
+    bool                            _has_base_value;
+    senml_string_s                  _base_name;
+    senml_number_s                  _base_value;
+};
+
+/*
+ * Decodes a JSON string or base64url data into a newly allocated buffer.
+ * Returns NULL if the encoding is not valid or allocation fails.
+ */
+uint8_t* decode_json_string(const senml_string_s &string, bool base64, uint32_t &length)
+{
+    uint8_t *buffer = (uint8_t*)malloc(string.length ? string.length : 1);
+    if (!buffer) {
+        return NULL;
+    }
+
+    length = 0;
+    if (base64) {
+        uint32_t bits = 0;
+        int count = 0;
+        for (uint32_t i = 0; i < string.length; i++) {
+            const uint8_t c = string.ptr[i];
+            int value;
+            if (c >= 'A' && c <= 'Z') {
+                value = c - 'A';
+            } else if (c >= 'a' && c <= 'z') {
+                value = c - 'a' + 26;
+            } else if (c >= '0' && c <= '9') {
+                value = c - '0' + 52;
+            } else if (c == '-' || c == '+') {
+                value = 62;
+            } else if (c == '_' || c == '/') {
+                value = 63;
+            } else if (c == '=') {
+                break;
+            } else {
+                free(buffer);
+                return NULL;
+            }
+            bits = (bits << 6) | value;
+            count += 6;
+            if (count >= 8) {
+                count -= 8;
+                buffer[length++] = (bits >> count) & 0xff;
+            }
+        }
+        return buffer;
+    }
+
+    for (uint32_t i = 0; i < string.length; i++) {
+        uint8_t c = string.ptr[i];
+        if (c != '\\') {
+            buffer[length++] = c;
+            continue;
+        }
+        if (++i >= string.length) {
+            break;
+        }
+        c = string.ptr[i];
+        switch (c) {
+            case 'b': buffer[length++] = '\b'; break;
+            case 'f': buffer[length++] = '\f'; break;
+            case 'n': buffer[length++] = '\n'; break;
+            case 'r': buffer[length++] = '\r'; break;
+            case 't': buffer[length++] = '\t'; break;
+            case 'u': {
+                // Characters of the basic multilingual plane, encoded as UTF-8
+                uint32_t code = 0;
+                if (i + 4 >= string.length) {
+                    free(buffer);
+                    return NULL;
+                }
+                for (int k = 0; k < 4; k++) {
+                    const uint8_t h = string.ptr[++i];
+                    code <<= 4;
+                    if (h >= '0' && h <= '9') {
+                        code |= h - '0';
+                    } else if ((h | 0x20) >= 'a' && (h | 0x20) <= 'f') {
+                        code |= (h | 0x20) - 'a' + 10;
+                    } else {
+                        free(buffer);
+                        return NULL;
+                    }
+                }
+                if (code < 0x80) {
+                    buffer[length++] = code;
+                } else if (code < 0x800) {
+                    buffer[length++] = 0xc0 | (code >> 6);
+                    buffer[length++] = 0x80 | (code & 0x3f);
+                } else {
+                    buffer[length++] = 0xe0 | (code >> 12);
+                    buffer[length++] = 0x80 | ((code >> 6) & 0x3f);
+                    buffer[length++] = 0x80 | (code & 0x3f);
+                }
+                break;
+            }
+            default:
+                buffer[length++] = c;
+                break;
+        }
+    }
+    return buffer;
+}
+
+/*
+ * Resolves the resource or resource instance named by base name + name,
+ * which must be below the path of the object instance.
+ */
+M2MResourceBase* find_target(const senml_string_s &base_name, const senml_string_s &name,
+                             M2MObjectInstance &object_instance, M2MResource *&parent_resource)
+{
+    if (base_name.escaped || name.escaped) {
+        return NULL;
+    }
+
+    StringBuffer<FULL_NAME_SIZE> full_name;
+    if (!full_name.append((const char*)base_name.ptr, base_name.length) ||
+        !full_name.append((const char*)name.ptr, name.length)) {
+        return NULL;
+    }
+
+    const char *path = full_name.c_str();
+    if (*path == '/') {
+        path++;
+    }
+    const char *instance_path = object_instance.uri_path();
+    const size_t instance_path_length = strlen(instance_path);
+    if (strncmp(path, instance_path, instance_path_length) != 0 || path[instance_path_length] != '/') {
+        return NULL;
+    }
+    path += instance_path_length + 1;
+
+    StringBuffer<M2MBase::MAX_NAME_SIZE + 1> resource_name;
+    const char *separator = strchr(path, '/');
+    const size_t resource_name_length = separator ? (size_t)(separator - path) : strlen(path);
+    if (!resource_name.append(path, resource_name_length)) {
+        return NULL;
+    }
+
+    parent_resource = object_instance.resource(resource_name.c_str());
+    if (!parent_resource || !separator) {
+        return parent_resource;
+    }
+    if (!parent_resource->supports_multiple_instances()) {
+        return NULL;
+    }
+    char *end = NULL;
+    const unsigned long instance_id = strtoul(separator + 1, &end, 10);
+    if (end == separator + 1 || *end != '\0' || instance_id > UINT16_MAX) {
+        return NULL;
+    }
+    return parent_resource->resource_instance((uint16_t)instance_id);
+}
+
+bool is_integral(double value)
+{
+    // Comparisons fail for NaN, conversion of anything outside of the range is undefined
+    return value >= -9223372036854775808.0 && value < 9223372036854775808.0 && floor(value) == value;
+}
+
+bool value_matches_type(const senml_record_s &record, M2MResourceBase::ResourceType type)
+{
+    switch (type) {
+        case M2MResourceBase::INTEGER:
+        case M2MResourceBase::TIME:
+            return record.kind == ValueNumber &&
+                   (record.number.integer || is_integral(record.number.float_value));
+        case M2MResourceBase::FLOAT:
+            return record.kind == ValueNumber;
+        case M2MResourceBase::BOOLEAN:
+            return record.kind == ValueBoolean || record.kind == ValueNumber;
+        case M2MResourceBase::OPAQUE:
+            return record.kind == ValueData;
+        case M2MResourceBase::OBJLINK:
+            return record.kind == ValueObjlnk || record.kind == ValueString;
+        case M2MResourceBase::STRING:
+        default:
+            return record.kind == ValueString;
+    }
+}
+
+bool set_value(M2MResourceBase &resource, const senml_record_s &record, M2MSenMLSerializer::Format format)
+{
+    const senml_number_s &number = record.number;
+    switch (resource.resource_instance_type()) {
+        case M2MResourceBase::INTEGER:
+        case M2MResourceBase::TIME:
+            return resource.set_value(number.integer ? number.int_value : (int64_t)number.float_value);
+        case M2MResourceBase::BOOLEAN:
+            if (record.kind == ValueBoolean) {
+                return resource.set_value((int64_t)record.boolean);
+            }
+            return resource.set_value((int64_t)(number.integer ? number.int_value != 0 : number.float_value != 0));
+        case M2MResourceBase::FLOAT:
+            return resource.set_value_float(number.integer ? (float)number.int_value : (float)number.float_value);
+        default:
+            break;
+    }
+
+    // Empty string or opaque value clears the resource, as in TLV
+    if (!record.string.length) {
+        resource.clear_value();
+        return true;
+    }
+
+    if (format == M2MSenMLSerializer::CBOR || !record.string.escaped) {
+        return resource.set_value(record.string.ptr, record.string.length);
+    }
+
+    uint32_t length;
+    uint8_t *decoded = decode_json_string(record.string, record.kind == ValueData, length);
+    if (!decoded) {
+        return false;
+    }
+    bool success = true;
+    if (length) {
+        success = resource.set_value(decoded, length);
+    } else {
+        resource.clear_value();
+    }
+    free(decoded);
+    return success;
+}
+
+M2MTLVDeserializer::Error process_records(const uint8_t *payload,
+                                          uint32_t payload_size,
+                                          M2MSenMLSerializer::Format format,
+                                          M2MObjectInstance &object_instance,
+                                          bool update_value)
+{
+    SenMLReader reader(payload, payload_size, format);
+    senml_record_s record;
+    while (reader.next(record)) {
+        M2MResource *parent_resource = NULL;
+        M2MResourceBase *target = find_target(reader.base_name(), record.name, object_instance, parent_resource);
+        if (!target) {
+            tr_debug("M2MSenMLDeserializer - record %.*s not found", (int)record.name.length, (const char*)record.name.ptr);
+            return M2MTLVDeserializer::NotFound;
+        }
+
+        if (!update_value) {
+            if (0 == (parent_resource->operation() & SN_GRS_PUT_ALLOWED)) {
+                return M2MTLVDeserializer::NotAllowed;
+            }
+            if (!value_matches_type(record, target->resource_instance_type())) {
+                return M2MTLVDeserializer::NotValid;
+            }
+        } else if (!set_value(*target, record, format)) {
+            return M2MTLVDeserializer::OutOfMemory;
+        }
+    }
+    return reader.error() ? M2MTLVDeserializer::NotValid : M2MTLVDeserializer::None;
+}
+
+} // namespace
+
+M2MTLVDeserializer::Error M2MSenMLDeserializer::deserialize_resources(const uint8_t *payload,
+                                                                      uint32_t payload_size,
+                                                                      M2MSenMLSerializer::Format format,
+                                                                      M2MObjectInstance &object_instance)
+{
+    tr_debug("M2MSenMLDeserializer::deserialize_resources()");
+    M2MTLVDeserializer::Error error = process_records(payload, payload_size, format, object_instance, false);
+    if (M2MTLVDeserializer::None == error) {
+        // Changes of all the resources are reported together
+        object_instance.begin_transaction();
+        error = process_records(payload, payload_size, format, object_instance, true);
+        object_instance.commit_transaction();
+    }
+    return error;
+}
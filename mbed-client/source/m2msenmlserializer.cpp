@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "include/m2msenmlserializer.h"
+#include "mbed-client/m2mconstants.h"
+#include "mbed-client/m2mstringbuffer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common_functions.h"
+#include "mbed-trace/mbed_trace.h"
+
+#define TRACE_GROUP "mClt"
+
+// SenML labels, RFC 8428 chapter 6
+#define SENML_LABEL_BASE_NAME       -2
+#define SENML_LABEL_NAME            0
+#define SENML_LABEL_VALUE           2
+#define SENML_LABEL_STRING_VALUE    3
+#define SENML_LABEL_BOOLEAN_VALUE   4
+#define SENML_LABEL_DATA_VALUE      8
+// Object link value has no numeric label, OMA-LWM2M 1.1 chapter 7.4.5
+#define SENML_LABEL_NONE            127
+
+#define CBOR_TYPE_UNSIGNED      0
+#define CBOR_TYPE_NEGATIVE      1
+#define CBOR_TYPE_BYTES         2
+#define CBOR_TYPE_TEXT          3
+#define CBOR_TYPE_ARRAY         4
+#define CBOR_TYPE_MAP           5
+#define CBOR_FALSE              0xf4
+#define CBOR_TRUE               0xf5
+#define CBOR_FLOAT32            0xfa
+
+#define INT64_STRING_MAX_LEN    21
+#define FLOAT_STRING_MAX_LEN    48
+
+// Base name is "/" + path + "/"
+#define BASE_NAME_SIZE (M2MBase::MAX_PATH_SIZE + 2)
+
+namespace {
+
+/*
+ * Same write convention as in M2MTLVSerializer, the write functions append the
+ * encoding at _data + _size and advance _size. When _data is NULL only _size is advanced,
+ * which is used to compute the exact buffer size before the actual write pass.
+ * The record count is needed up front for the CBOR array header and is collected
+ * during the sizing pass.
+ */
+class SenMLWriter {
+public:
+    SenMLWriter(M2MSenMLSerializer::Format format, const char *base_name)
+    : _format(format), _base_name(base_name), _data(NULL), _capacity(0), _size(0), _records(0)
+    {
+        // Record names are relative to the base name, which has a leading '/' that paths do not have
+        _name_offset = strlen(base_name) - 1;
+    }
+
+    void begin(uint8_t *data, uint32_t capacity)
+    {
+        uint32_t records = _records;
+        _data = data;
+        _capacity = capacity;
+        _size = 0;
+        _records = 0;
+        if (_format == M2MSenMLSerializer::JSON) {
+            write_byte('[');
+        } else if (_data) {
+            write_cbor_head(CBOR_TYPE_ARRAY, records);
+        }
+    }
+
+    void end()
+    {
+        if (_format == M2MSenMLSerializer::JSON) {
+            write_byte(']');
+        } else if (!_data) {
+            // Sizing pass, the array header is sized once the records are counted
+            write_cbor_head(CBOR_TYPE_ARRAY, _records);
+        }
+    }
+
+    void write_object_instances(const M2MObjectInstanceList &object_instance_list)
+    {
+        M2MObjectInstanceList::const_iterator it = object_instance_list.begin();
+        for (; it != object_instance_list.end(); it++) {
+            write_object_instance(**it);
+        }
+    }
+
+    void write_object_instance(const M2MObjectInstance &object_instance)
+    {
+        write_resources(object_instance.resources());
+    }
+
+    void write_resources(const M2MResourceList &resource_list)
+    {
+        M2MResourceList::const_iterator it = resource_list.begin();
+        for (; it != resource_list.end(); it++) {
+            if (((*it)->operation() & M2MBase::GET_ALLOWED) == M2MBase::GET_ALLOWED) {
+                write_resource(**it);
+            }
+        }
+    }
+
+    void write_resource(const M2MResource &resource)
+    {
+        if (!resource.supports_multiple_instances()) {
+            write_record(resource);
+            return;
+        }
+
+        const M2MResourceInstanceList &instance_list = resource.resource_instances();
+        M2MResourceInstanceList::const_iterator it = instance_list.begin();
+        for (; it != instance_list.end(); it++) {
+            if (((*it)->operation() & M2MBase::GET_ALLOWED) == M2MBase::GET_ALLOWED) {
+                write_record(**it);
+            }
+        }
+    }
+
+    void write_record(const M2MResourceBase &resource)
+    {
+        const bool first = (_records == 0);
+        const char *name = resource.uri_path() + _name_offset;
+
+        if (_format == M2MSenMLSerializer::CBOR) {
+            write_cbor_head(CBOR_TYPE_MAP, first ? 3 : 2);
+        } else {
+            if (!first) {
+                write_byte(',');
+            }
+            write_byte('{');
+        }
+
+        if (first) {
+            write_key(SENML_LABEL_BASE_NAME, "bn");
+            write_string((const uint8_t*)_base_name, strlen(_base_name));
+            write_separator();
+        }
+        write_key(SENML_LABEL_NAME, "n");
+        write_string((const uint8_t*)name, strlen(name));
+        write_separator();
+        write_value(resource);
+
+        if (_format == M2MSenMLSerializer::JSON) {
+            write_byte('}');
+        }
+        _records++;
+    }
+
+    uint32_t size() const
+    {
+        return _size;
+    }
+
+private:
+
+    void write_value(const M2MResourceBase &resource)
+    {
+        switch (resource.resource_instance_type()) {
+            case M2MResourceBase::INTEGER:
+            case M2MResourceBase::TIME:
+                write_key(SENML_LABEL_VALUE, "v");
+                write_integer(resource.get_value_int());
+                break;
+            case M2MResourceBase::FLOAT:
+                write_key(SENML_LABEL_VALUE, "v");
+                write_float(resource.get_value_float());
+                break;
+            case M2MResourceBase::BOOLEAN:
+                write_key(SENML_LABEL_BOOLEAN_VALUE, "vb");
+                write_boolean(resource.get_value_int() != 0);
+                break;
+            case M2MResourceBase::OPAQUE:
+                write_key(SENML_LABEL_DATA_VALUE, "vd");
+                write_data(resource.value(), resource.value_length());
+                break;
+            case M2MResourceBase::OBJLINK:
+                write_key(SENML_LABEL_NONE, "vlo");
+                write_string(resource.value(), resource.value_length());
+                break;
+            case M2MResourceBase::STRING:
+            default:
+                write_key(SENML_LABEL_STRING_VALUE, "vs");
+                write_string(resource.value(), resource.value_length());
+                break;
+        }
+    }
+
+    void write_bytes(const void *bytes, uint32_t length)
+    {
+        if (_data && length && _size + length <= _capacity) {
+            memcpy(_data + _size, bytes, length);
+        }
+        _size += length;
+    }
+
+    void write_byte(uint8_t byte)
+    {
+        write_bytes(&byte, 1);
+    }
+
+    void write_separator()
+    {
+        if (_format == M2MSenMLSerializer::JSON) {
+            write_byte(',');
+        }
+    }
+
+    void write_cbor_head(uint8_t major_type, uint64_t value)
+    {
+        uint8_t head[9];
+        uint32_t length;
+        head[0] = major_type << 5;
+        if (value < 24) {
+            head[0] |= (uint8_t)value;
+            length = 1;
+        } else if (value <= 0xff) {
+            head[0] |= 24;
+            head[1] = (uint8_t)value;
+            length = 2;
+        } else if (value <= 0xffff) {
+            head[0] |= 25;
+            common_write_16_bit((uint16_t)value, head + 1);
+            length = 3;
+        } else if (value <= 0xffffffff) {
+            head[0] |= 26;
+            common_write_32_bit((uint32_t)value, head + 1);
+            length = 5;
+        } else {
+            head[0] |= 27;
+            common_write_64_bit(value, head + 1);
+            length = 9;
+        }
+        write_bytes(head, length);
+    }
+
+    void write_key(int8_t label, const char *name)
+    {
+        if (_format == M2MSenMLSerializer::JSON) {
+            write_byte('"');
+            write_bytes(name, strlen(name));
+            write_bytes("\":", 2);
+        } else if (label == SENML_LABEL_NONE) {
+            write_cbor_head(CBOR_TYPE_TEXT, strlen(name));
+            write_bytes(name, strlen(name));
+        } else {
+            write_integer(label);
+        }
+    }
+
+    void write_integer(int64_t value)
+    {
+        if (_format == M2MSenMLSerializer::JSON) {
+            char buffer[INT64_STRING_MAX_LEN];
+            uint32_t length = m2m::itoa_c(value, buffer);
+            write_bytes(buffer, length);
+        } else if (value >= 0) {
+            write_cbor_head(CBOR_TYPE_UNSIGNED, (uint64_t)value);
+        } else {
+            write_cbor_head(CBOR_TYPE_NEGATIVE, (uint64_t)(-1 - value));
+        }
+    }
+
+    void write_float(float value)
+    {
+        if (_format == M2MSenMLSerializer::JSON) {
+            char buffer[FLOAT_STRING_MAX_LEN];
+            // Infinity and NaN have no JSON representation
+            int length = (value - value == 0) ? snprintf(buffer, sizeof(buffer), "%.9g", value) : 0;
+            if (length > 0 && (uint32_t)length < sizeof(buffer)) {
+                write_bytes(buffer, length);
+            } else {
+                write_bytes("null", 4);
+            }
+        } else {
+            uint8_t buffer[5];
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            buffer[0] = CBOR_FLOAT32;
+            common_write_32_bit(bits, buffer + 1);
+            write_bytes(buffer, sizeof(buffer));
+        }
+    }
+
+    void write_boolean(bool value)
+    {
+        if (_format == M2MSenMLSerializer::JSON) {
+            if (value) {
+                write_bytes("true", 4);
+            } else {
+                write_bytes("false", 5);
+            }
+        } else {
+            write_byte(value ? CBOR_TRUE : CBOR_FALSE);
+        }
+    }
+
+    void write_string(const uint8_t *string, uint32_t length)
+    {
+        if (_format == M2MSenMLSerializer::CBOR) {
+            write_cbor_head(CBOR_TYPE_TEXT, length);
+            write_bytes(string, length);
+            return;
+        }
+
+        static const char hex[] = "0123456789abcdef";
+        write_byte('"');
+        for (uint32_t i = 0; i < length; i++) {
+            const uint8_t c = string[i];
+            if (c == '"' || c == '\\') {
+                write_byte('\\');
+                write_byte(c);
+            } else if (c < 0x20) {
+                const char escape[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf] };
+                write_bytes(escape, sizeof(escape));
+            } else {
+                write_byte(c);
+            }
+        }
+        write_byte('"');
+    }
+
+    void write_data(const uint8_t *bytes, uint32_t length)
+    {
+        if (_format == M2MSenMLSerializer::CBOR) {
+            write_cbor_head(CBOR_TYPE_BYTES, length);
+            write_bytes(bytes, length);
+            return;
+        }
+
+        // base64url without padding, RFC 8428 chapter 4.3
+        static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        write_byte('"');
+        for (uint32_t i = 0; i < length; i += 3) {
+            const uint32_t remaining = length - i;
+            uint32_t triple = (uint32_t)bytes[i] << 16;
+            if (remaining > 1) {
+                triple |= (uint32_t)bytes[i + 1] << 8;
+            }
+            if (remaining > 2) {
+                triple |= bytes[i + 2];
+            }
+            char quad[4];
+            quad[0] = alphabet[(triple >> 18) & 0x3f];
+            quad[1] = alphabet[(triple >> 12) & 0x3f];
+            quad[2] = alphabet[(triple >> 6) & 0x3f];
+            quad[3] = alphabet[triple & 0x3f];
+            write_bytes(quad, remaining > 2 ? 4 : remaining + 1);
+        }
+        write_byte('"');
+    }
+
+    M2MSenMLSerializer::Format  _format;
+    const char                  *_base_name;
+    uint32_t                    _name_offset;
+    uint8_t                     *_data;
+    uint32_t                    _capacity;
+    uint32_t                    _size;
+    uint32_t                    _records;
+};
+
+/*
+ * Runs the sizing pass and the write pass into a single buffer.
+ */
+template <typename WriteFunction, typename Target>
+uint8_t* write_payload(SenMLWriter &writer, WriteFunction write, const Target &target, uint32_t &size)
+{
+    writer.begin(NULL, 0);
+    (writer.*write)(target);
+    writer.end();
+    size = writer.size();
+
+    uint8_t *data = (uint8_t*)malloc(size);
+    if (!data) {
+        /* memory allocation has failed */
+        size = 0;
+        return NULL;
+    }
+
+    writer.begin(data, size);
+    (writer.*write)(target);
+    writer.end();
+
+    // Values changed between the passes, the output is not consistent
+    if (writer.size() != size) {
+        tr_error("M2MSenMLSerializer - size changed during serialization");
+        free(data);
+        size = 0;
+        return NULL;
+    }
+    return data;
+}
+
+bool create_base_name(StringBuffer<BASE_NAME_SIZE> &base_name, const char *path)
+{
+    return base_name.append('/') && base_name.append(path) && base_name.append('/');
+}
+
+} // namespace
+
+bool M2MSenMLSerializer::is_senml(uint16_t content_format, Format &format)
+{
+    if (content_format == COAP_CONTENT_SENML_CBOR_TYPE) {
+        format = CBOR;
+        return true;
+    } else if (content_format == COAP_CONTENT_SENML_JSON_TYPE) {
+        format = JSON;
+        return true;
+    }
+    return false;
+}
+
+uint8_t* M2MSenMLSerializer::serialize(const M2MObject &object, const M2MObjectInstanceList &object_instance_list,
+                                       Format format, uint32_t &size)
+{
+    size = 0;
+    StringBuffer<BASE_NAME_SIZE> base_name;
+    if (!create_base_name(base_name, object.uri_path())) {
+        return NULL;
+    }
+
+    SenMLWriter writer(format, base_name.c_str());
+    return write_payload(writer, &SenMLWriter::write_object_instances, object_instance_list, size);
+}
+
+uint8_t* M2MSenMLSerializer::serialize(const M2MObjectInstance &object_instance, Format format, uint32_t &size)
+{
+    size = 0;
+    StringBuffer<BASE_NAME_SIZE> base_name;
+    if (!create_base_name(base_name, object_instance.uri_path())) {
+        return NULL;
+    }
+
+    SenMLWriter writer(format, base_name.c_str());
+    return write_payload(writer, &SenMLWriter::write_object_instance, object_instance, size);
+}
+
+uint8_t* M2MSenMLSerializer::serialize(const M2MResourceList &resource_list, Format format, uint32_t &size)
+{
+    size = 0;
+    SenMLWriter writer(format, "/");
+    return write_payload(writer, &SenMLWriter::write_resources, resource_list, size);
+}
+
+uint8_t* M2MSenMLSerializer::serialize(const M2MResourceBase &resource, Format format, uint32_t &size)
+{
+    size = 0;
+    const M2MResource &parent_resource = resource.get_parent_resource();
+    StringBuffer<BASE_NAME_SIZE> base_name;
+    if (!create_base_name(base_name, parent_resource.get_parent_object_instance().uri_path())) {
+        return NULL;
+    }
+
+    SenMLWriter writer(format, base_name.c_str());
+    if (resource.base_type() == M2MBase::Resource) {
+        return write_payload(writer, &SenMLWriter::write_resource, parent_resource, size);
+    }
+    return write_payload(writer, &SenMLWriter::write_record, resource, size);
+}
@@ -23,65 +23,74 @@ namespace m2m {
 
 const String::size_type String::npos = static_cast<size_t>(-1);
 
-char* String::strdup(const char* s)
+void String::init(const char* str, size_type n)
 {
-    const size_t len = strlen(s)+1;
-    char *p2 = static_cast<char*>(malloc(len));
-    if (p2) {
-        memcpy(p2, s, len);
-        allocated_ = len;
-        size_ = len-1;
+    p = inline_;
+    allocated_ = INLINE_SIZE;
+    size_ = 0;
+    if (n >= INLINE_SIZE) {
+        char* heap = static_cast<char*>(malloc(n + 1));
+        if (!heap) {
+            // leave an empty string
+            p[0] = 0;
+            return;
+        }
+        p = heap;
+        allocated_ = n + 1;
     }
-    return p2;
+    memcpy(p, str, n);
+    p[n] = 0;
+    size_ = n;
 }
 
 String::String()
-    : p( strdup("") )
 {
+    init("", 0);
 }
 
 String::~String()
 {
-    free(p);
+    if (!is_inline()) {
+        free(p);
+    }
     p = 0;
 }
 
 String::String(const String& s)
-    : p(0)
 {
-    p = static_cast<char*>(malloc(s.size_ + 1));
-
-    allocated_ = s.size_ + 1;
-    size_      = s.size_;
-    memcpy(p, s.p, size_ + 1);
+    init(s.p, s.size_);
 }
 
 String::String(const char* s)
-    : p(strdup(s))
 {
+    init(s, strlen(s));
 }
 
 String::String(const char* str, size_t n)
 {
-    p = static_cast<char*>(malloc(n + 1));
-
-    allocated_ = n + 1;
-    size_      = n;
-    memcpy(p, str, n);
-    p[n] = 0;
+    init(str, n);
 }
 
 String& String::operator=(const char* s)
 {
     if ( p != s ) {
-        // s could point into our own string, so we have to allocate a new string
         const size_t len = strlen(s);
-        char* copy = (char*) malloc( len + 1);
-        memmove(copy, s, len+1); // trailing 0
-        free( p );
-        p = copy;
+        if (len < allocated_) {
+            // fits in the current memory, s could point into our own string
+            memmove(p, s, len+1); // trailing 0
+        } else {
+            char* copy = (char*) malloc( len + 1);
+            if (!copy) {
+                return *this;
+            }
+            memcpy(copy, s, len+1); // trailing 0
+            if (!is_inline()) {
+                free( p );
+            }
+            p = copy;
+            allocated_ = len+1;
+        }
         size_ = len;
-        allocated_ = len+1;
     }
     return *this;
 }
@@ -299,18 +308,27 @@ int String::find_last_of(char c) const {
     return r;
 }
 
-void String::new_realloc( size_type n) {
-    if (n > 0 ) {
-        char* pnew = static_cast<char*>(realloc(p, n)); // could return NULL
-        if (pnew)
-            p = pnew;
+bool String::new_realloc( size_type n) {
+    char* pnew;
+    if (is_inline()) {
+        pnew = static_cast<char*>(malloc(n)); // could return NULL
+        if (pnew) {
+            memcpy(pnew, p, size_ + 1);
+        }
+    } else {
+        pnew = static_cast<char*>(realloc(p, n)); // could return NULL
+    }
+    if (pnew) {
+        p = pnew;
     }
+    return pnew != NULL;
 }
 
 void String::reserve( const size_type n) {
     if (n >= allocated_ ) {
-        this->new_realloc(n + 1);
-        allocated_ = n + 1;
+        if (this->new_realloc(n + 1)) {
+            allocated_ = n + 1;
+        }
     }
 }
 
@@ -333,9 +351,26 @@ void String::resize( const size_type n, const char c) {
 }
 
 void String::swap( String& s ) {
+    const bool was_inline = is_inline();
+    const bool other_was_inline = s.is_inline();
+
     std::swap( allocated_, s.allocated_ );
     std::swap( size_,      s.size_      );
     std::swap( p,          s.p          );
+
+    // inline content stays in its own object, so it is swapped separately
+    if (was_inline || other_was_inline) {
+        char tmp[INLINE_SIZE];
+        memcpy(tmp, inline_, INLINE_SIZE);
+        memcpy(inline_, s.inline_, INLINE_SIZE);
+        memcpy(s.inline_, tmp, INLINE_SIZE);
+        if (other_was_inline) {
+            p = inline_;
+        }
+        if (was_inline) {
+            s.p = s.inline_;
+        }
+    }
 }
 
 
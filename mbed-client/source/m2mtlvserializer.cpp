@@ -17,7 +17,9 @@
 #include "mbed-client/m2mconstants.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include "common_functions.h"
+#include "mbed-trace/mbed_trace.h"
 
 #define TRACE_GROUP "mClt"
 
@@ -27,214 +29,214 @@
 
 uint8_t* M2MTLVSerializer::serialize(const M2MObjectInstanceList &object_instance_list, uint32_t &size)
 {
-    return serialize_object_instances(object_instance_list, size);
+    // First pass computes the exact size, second pass writes into a single buffer
+    size = 0;
+    write_object_instances(object_instance_list, NULL, 0, size);
+    return allocate_and_write(&object_instance_list, NULL, NULL, size);
 }
 
 uint8_t* M2MTLVSerializer::serialize(const M2MResourceList &resource_list, uint32_t &size)
 {
-    bool valid = true;
-    return serialize_resources(resource_list, size,valid);
+    size = 0;
+    if (!write_resources(resource_list, NULL, 0, size)) {
+        size = 0;
+        return NULL;
+    }
+    return allocate_and_write(NULL, &resource_list, NULL, size);
 }
 
 uint8_t* M2MTLVSerializer::serialize(const M2MResource *resource, uint32_t &size)
 {
-    uint8_t* data = NULL;
-    serialize(resource, data, size);
-    return data;
+    size = 0;
+    if (!write_resource(resource, NULL, 0, size)) {
+        size = 0;
+        return NULL;
+    }
+    return allocate_and_write(NULL, NULL, resource, size);
 }
 
-uint8_t* M2MTLVSerializer::serialize_object_instances(const M2MObjectInstanceList &object_instance_list, uint32_t &size)
+bool M2MTLVSerializer::serialize(const M2MObjectInstanceList &object_instance_list, uint8_t *buffer,
+                                 uint32_t buffer_size, uint32_t &size)
 {
-    uint8_t *data = NULL;
-
-    if(!object_instance_list.empty()) {
-        M2MObjectInstanceList::const_iterator it;
-        it = object_instance_list.begin();
-        for (; it!=object_instance_list.end(); it++) {            
-            uint16_t id = (*it)->instance_id();
-            serialize(id, *it, data, size);            
-        }
+    size = 0;
+    write_object_instances(object_instance_list, NULL, 0, size);
+    if (!buffer || size > buffer_size) {
+        return buffer == NULL;
     }
-    return data;
+    uint32_t written = 0;
+    write_object_instances(object_instance_list, buffer, buffer_size, written);
+    return written == size;
 }
 
-uint8_t* M2MTLVSerializer::serialize_resources(const M2MResourceList &resource_list, uint32_t &size, bool &valid)
+bool M2MTLVSerializer::serialize(const M2MResourceList &resource_list, uint8_t *buffer,
+                                 uint32_t buffer_size, uint32_t &size)
 {
-    uint8_t *data = NULL;
-
-    if(!resource_list.empty()) {
-        M2MResourceList::const_iterator it;
-        it = resource_list.begin();
-        for (; it!=resource_list.end(); it++) {
-            if((*it)->name_id() == -1) {
-                valid = false;
-                break;
-            }
-        }
-        if(valid) {
-            it = resource_list.begin();
-            for (; it!=resource_list.end(); it++) {
-                if (((*it)->operation() & M2MBase::GET_ALLOWED) == M2MBase::GET_ALLOWED) {
-                    if(!serialize(*it, data, size)) {
-                        /* serializing has failed */
-                        /* free data so far */
-                        free(data);
-                        /* invalidate */
-                        valid = false;
-                        /* return NULL immediately */
-                        return NULL;
-                    }
-                }
-            }
-        }
+    size = 0;
+    if (!write_resources(resource_list, NULL, 0, size)) {
+        size = 0;
+        return false;
     }
-    return data;
+    if (!buffer || size > buffer_size) {
+        return buffer == NULL;
+    }
+    uint32_t written = 0;
+    return write_resources(resource_list, buffer, buffer_size, written) && written == size;
 }
 
-bool M2MTLVSerializer::serialize(uint16_t id, const M2MObjectInstance *object_instance, uint8_t *&data, uint32_t &size)
+uint8_t* M2MTLVSerializer::allocate_and_write(const M2MObjectInstanceList *object_instance_list,
+                                              const M2MResourceList *resource_list,
+                                              const M2MResource *resource,
+                                              uint32_t &size)
 {
-    uint8_t *resource_data = NULL;
-    uint32_t resource_size = 0;
-    bool success;
-
-    bool valid = true;
-    resource_data = serialize_resources(object_instance->resources(),resource_size,valid);
-    if(valid) {
-        if(serialize_TILV(TYPE_OBJECT_INSTANCE, id, resource_data, resource_size, data, size)) {
-            success = true;
-        } else {
-            /* serializing object instance failed */
-            success = false;
-        }
-        free(resource_data);
+    if (size == 0) {
+        return NULL;
+    }
+
+    uint8_t *data = (uint8_t*)malloc(size);
+    if (!data) {
+        /* memory allocation has failed */
+        size = 0;
+        return NULL;
+    }
+
+    uint32_t written = 0;
+    if (object_instance_list) {
+        write_object_instances(*object_instance_list, data, size, written);
+    } else if (resource_list) {
+        write_resources(*resource_list, data, size, written);
     } else {
-        /* serializing resources failed */
-        success = false;
+        write_resource(resource, data, size, written);
     }
-    return success;
-}
 
-bool M2MTLVSerializer::serialize(const M2MResource *resource, uint8_t *&data, uint32_t &size)
-{
-    bool success = false;
-    if(resource->name_id() != -1) {
-        success = resource->supports_multiple_instances() ?
-                serialize_multiple_resource(resource, data, size) :
-                serialize_resource(resource, data, size);
+    // Values changed between the passes, the output is not consistent
+    if (written != size) {
+        tr_error("M2MTLVSerializer - size changed during serialization");
+        free(data);
+        size = 0;
+        return NULL;
     }
-    return success;
+    return data;
 }
 
-bool M2MTLVSerializer::serialize_resource(const M2MResource *resource, uint8_t *&data, uint32_t &size)
+void M2MTLVSerializer::write_object_instances(const M2MObjectInstanceList &object_instance_list, uint8_t *data, uint32_t capacity, uint32_t &size)
 {
-    bool success = false;
-    if(resource->name_id() != -1) {
-        if ( (resource->resource_instance_type() == M2MResourceBase::INTEGER) ||
-             (resource->resource_instance_type() == M2MResourceBase::BOOLEAN) ||
-             (resource->resource_instance_type() == M2MResourceBase::TIME) ) {
-            success = serialize_TLV_binary_int(resource, TYPE_RESOURCE, resource->name_id(), data, size);
-        }
-        else if (resource->resource_instance_type() == M2MResourceBase::FLOAT) {
-            success = serialize_TLV_binary_float(resource, TYPE_RESOURCE, resource->name_id(), data, size);
-        }
-        else {
-             success = serialize_TILV(TYPE_RESOURCE, resource->name_id(),
-                      resource->value(), resource->value_length(), data, size);
+    M2MObjectInstanceList::const_iterator it = object_instance_list.begin();
+    for (; it != object_instance_list.end(); it++) {
+        // Instances containing resources without numeric id are left out
+        uint32_t resource_size = 0;
+        if (write_resources((*it)->resources(), NULL, 0, resource_size)) {
+            write_TILV_header(TYPE_OBJECT_INSTANCE, (*it)->instance_id(), resource_size, data, capacity, size);
+            write_resources((*it)->resources(), data, capacity, size);
         }
     }
-    return success;
 }
 
-bool M2MTLVSerializer::serialize_multiple_resource(const M2MResource *resource, uint8_t *&data, uint32_t &size)
+bool M2MTLVSerializer::write_resources(const M2MResourceList &resource_list, uint8_t *data, uint32_t capacity, uint32_t &size)
 {
-    bool success = false;
-    uint8_t *nested_data = NULL;
-    uint32_t nested_data_size = 0;
+    M2MResourceList::const_iterator it = resource_list.begin();
+    for (; it != resource_list.end(); it++) {
+        if ((*it)->name_id() == -1) {
+            return false;
+        }
+    }
 
-    const M2MResourceInstanceList &instance_list = resource->resource_instances();
-    if(!instance_list.empty()) {
-        M2MResourceInstanceList::const_iterator it;
-        it = instance_list.begin();
-        for (; it!=instance_list.end(); it++) {
-            uint16_t id = (*it)->instance_id();
-            if (((*it)->operation() & M2MBase::GET_ALLOWED) == M2MBase::GET_ALLOWED) {
-                if(!serialize_resource_instance(id, (*it), nested_data, nested_data_size)) {
-                    /* serializing instance has failed */
-                    /* free data so far allocated */
-                    free(nested_data);
-                    /* return fail immediately*/
-                    success = false;
-                    return success;
-                }
+    it = resource_list.begin();
+    for (; it != resource_list.end(); it++) {
+        if (((*it)->operation() & M2MBase::GET_ALLOWED) == M2MBase::GET_ALLOWED) {
+            if (!write_resource(*it, data, capacity, size)) {
+                return false;
             }
         }
     }
-    if(resource->name_id() != -1 &&
-            (resource->operation() & M2MBase::GET_ALLOWED) == M2MBase::GET_ALLOWED) {
-        success = serialize_TILV(TYPE_MULTIPLE_RESOURCE, resource->name_id(),
-                                    nested_data, nested_data_size, data, size);
-    }
-
-    free(nested_data);
-    return success;
+    return true;
 }
 
-bool M2MTLVSerializer::serialize_resource_instance(uint16_t id, const M2MResourceInstance *resource, uint8_t *&data, uint32_t &size)
+bool M2MTLVSerializer::write_resource(const M2MResource *resource, uint8_t *data, uint32_t capacity, uint32_t &size)
 {
-    bool success;
+    if (resource->name_id() == -1) {
+        return false;
+    }
 
-    if ( (resource->resource_instance_type() == M2MResourceBase::INTEGER) ||
-         (resource->resource_instance_type() == M2MResourceBase::BOOLEAN) ||
-         (resource->resource_instance_type() == M2MResourceBase::TIME) ) {
-        success=serialize_TLV_binary_int(resource, TYPE_RESOURCE_INSTANCE, id, data, size);
+    if (!resource->supports_multiple_instances()) {
+        write_resource_value(resource, TYPE_RESOURCE, resource->name_id(), data, capacity, size);
+        return true;
     }
-    else if (resource->resource_instance_type() == M2MResourceBase::FLOAT) {
-        success=serialize_TLV_binary_float(resource, TYPE_RESOURCE_INSTANCE, id, data, size);
+
+    if ((resource->operation() & M2MBase::GET_ALLOWED) != M2MBase::GET_ALLOWED) {
+        return false;
     }
-    else {
-        success=serialize_TILV(TYPE_RESOURCE_INSTANCE, id, resource->value(), resource->value_length(), data, size);
+
+    const M2MResourceInstanceList &instance_list = resource->resource_instances();
+    M2MResourceInstanceList::const_iterator it;
+
+    // Header length field depends on the nested size, so instances are sized first
+    uint32_t nested_size = 0;
+    it = instance_list.begin();
+    for (; it != instance_list.end(); it++) {
+        if (((*it)->operation() & M2MBase::GET_ALLOWED) == M2MBase::GET_ALLOWED) {
+            write_resource_value(*it, TYPE_RESOURCE_INSTANCE, (*it)->instance_id(), NULL, 0, nested_size);
+        }
     }
 
-    return success;
+    write_TILV_header(TYPE_MULTIPLE_RESOURCE, resource->name_id(), nested_size, data, capacity, size);
+    if (!data) {
+        size += nested_size;
+        return true;
+    }
+
+    it = instance_list.begin();
+    for (; it != instance_list.end(); it++) {
+        if (((*it)->operation() & M2MBase::GET_ALLOWED) == M2MBase::GET_ALLOWED) {
+            write_resource_value(*it, TYPE_RESOURCE_INSTANCE, (*it)->instance_id(), data, capacity, size);
+        }
+    }
+    return true;
 }
 
-/* See, OMA-TS-LightweightM2M-V1_0-20170208-A, Appendix C,
- * Data Types, Integer, Boolean and Time TLV Format */
-bool M2MTLVSerializer::serialize_TLV_binary_int(const M2MResourceBase *resource, uint8_t type, uint16_t id, uint8_t *&data, uint32_t &size)
+void M2MTLVSerializer::write_resource_value(const M2MResourceBase *resource, uint8_t type, uint16_t id, uint8_t *data, uint32_t capacity, uint32_t &size)
 {
-    int64_t valueInt = resource->get_value_int();
-    uint32_t buffer_size;
     /* max len 8 bytes */
     uint8_t buffer[8];
-
-    if (resource->resource_instance_type() == M2MResourceBase::BOOLEAN) {
-        buffer_size = 1;
-        buffer[0] = valueInt;
+    uint8_t *value = buffer;
+    uint32_t value_length;
+
+    const M2MResourceBase::ResourceType resource_type = resource->resource_instance_type();
+    if (resource_type == M2MResourceBase::INTEGER ||
+        resource_type == M2MResourceBase::BOOLEAN ||
+        resource_type == M2MResourceBase::TIME) {
+        /* See, OMA-TS-LightweightM2M-V1_0-20170208-A, Appendix C,
+         * Data Types, Integer, Boolean and Time TLV Format */
+        value_length = (resource_type == M2MResourceBase::BOOLEAN) ? 1 : 8;
+        if (data) {
+            int64_t valueInt = resource->get_value_int();
+            if (resource_type == M2MResourceBase::BOOLEAN) {
+                buffer[0] = valueInt;
+            } else {
+                common_write_64_bit(valueInt, buffer);
+            }
+        }
+    } else if (resource_type == M2MResourceBase::FLOAT) {
+        /* See, OMA-TS-LightweightM2M-V1_0-20170208-A, Appendix C,
+         * Data Type Float (32 bit only) TLV Format */
+        value_length = 4;
+        if (data) {
+            float valueFloat = resource->get_value_float();
+            common_write_32_bit(*(uint32_t*)&valueFloat, buffer);
+        }
     } else {
-        buffer_size = 8;
-        common_write_64_bit(valueInt, buffer);
+        value = resource->value();
+        value_length = resource->value_length();
     }
 
-    return serialize_TILV(type, id, buffer, buffer_size, data, size);
+    write_TILV_header(type, id, value_length, data, capacity, size);
+    if (data && value_length && size + value_length <= capacity) {
+        memcpy(data + size, value, value_length);
+    }
+    size += value_length;
 }
 
-/* See, OMA-TS-LightweightM2M-V1_0-20170208-A, Appendix C,
- * Data Type Float (32 bit only) TLV Format */
-bool M2MTLVSerializer::serialize_TLV_binary_float(const M2MResourceBase *resource, uint8_t type, uint16_t id, uint8_t *&data, uint32_t &size)
+void M2MTLVSerializer::write_TILV_header(uint8_t type, uint16_t id, uint32_t value_length, uint8_t *data, uint32_t capacity, uint32_t &size)
 {
-    float valueFloat = resource->get_value_float();
-    /* max len 8 bytes */
-    uint8_t buffer[4];
-
-    common_write_32_bit(*(uint32_t*)&valueFloat, buffer);
-
-    return serialize_TILV(type, id, buffer, 4, data, size);
-}
-
-
-bool M2MTLVSerializer::serialize_TILV(uint8_t type, uint16_t id, uint8_t *value, uint32_t value_length, uint8_t *&data, uint32_t &size)
-{
-    uint8_t *tlv = 0;
     const uint32_t type_length = TLV_TYPE_SIZE;
     type += id < 256 ? 0 : ID16;
     type += value_length < 8 ? value_length :
@@ -251,25 +253,12 @@ bool M2MTLVSerializer::serialize_TILV(uint8_t type, uint16_t id, uint8_t *value,
     uint8_t length_array[MAX_TLV_LENGTH_SIZE];
     serialize_length(value_length, length_size, length_array);
 
-    tlv = (uint8_t*)malloc(size + type_length + id_size + length_size + value_length);
-    if (!tlv) {
-        /* memory allocation has failed */
-        /* return failure immediately */
-        return false;
-        /* eventually NULL will be returned to serializer public method caller */
+    if (data && size + type_length + id_size + length_size <= capacity) {
+        memcpy(data+size, &tlv_type, type_length);
+        memcpy(data+size+type_length, id_array, id_size);
+        memcpy(data+size+type_length+id_size, length_array, length_size);
     }
-    if(data) {
-        memcpy(tlv, data, size);
-        free(data);
-    }
-    memcpy(tlv+size, &tlv_type, type_length);
-    memcpy(tlv+size+type_length, id_array, id_size);
-    memcpy(tlv+size+type_length+id_size, length_array, length_size);
-    memcpy(tlv+size+type_length+id_size+length_size, value, value_length);
-
-    data = tlv;
-    size += type_length + id_size + length_size + value_length;
-    return true;
+    size += type_length + id_size + length_size;
 }
 
 void M2MTLVSerializer::serialize_id(uint16_t id, uint32_t &size, uint8_t *id_ptr)
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Note: this macro is needed on armcc to get the the PRI*32 macros
+// from inttypes.h in a C++ code.
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
+#include "include/m2mtlvstreamdeserializer.h"
+#include "mbed-client/m2mconstants.h"
+#include "mbed-client/m2mconfig.h"
+#include "mbed-trace/mbed_trace.h"
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_GROUP "mClt"
+
+// Type, identifier and length fields take at most 1 + 2 + 3 bytes
+static uint8_t header_size(uint8_t type)
+{
+    uint8_t size = (type & ID16) ? 3 : 2;
+    return size + ((type & LENGTH24) >> 3);
+}
+
+M2MTLVStreamDeserializer::M2MTLVStreamDeserializer(M2MObjectInstance &object_instance,
+                                                   M2MTLVDeserializer::Operation operation)
+: _object_instance(object_instance),
+  _multiple_resource(NULL),
+  _target(NULL),
+  _value(NULL),
+  _offset(0),
+  _multiple_resource_end(0),
+  _length(0),
+  _received(0),
+  _next_block(0),
+  _id(0),
+  _first_id(0),
+  _header_len(0),
+  _type(0),
+  _state(M2MTLVStreamDeserializer::Header),
+  _operation(operation),
+  _error(M2MTLVDeserializer::None),
+  _first(true),
+  _finished(false)
+{
+}
+
+M2MTLVStreamDeserializer::~M2MTLVStreamDeserializer()
+{
+    free(_value);
+}
+
+M2MTLVDeserializer::Error M2MTLVStreamDeserializer::push(const uint8_t *data, uint32_t size)
+{
+    while (size && M2MTLVDeserializer::None == _error) {
+        if (M2MTLVStreamDeserializer::Header == _state) {
+            _header[_header_len++] = *data++;
+            size--;
+            _offset++;
+            if (_header_len == header_size(_header[0])) {
+                _error = begin_record();
+            }
+            continue;
+        }
+
+        uint32_t len = _length - _received;
+        if (len > size) {
+            len = size;
+        }
+
+        if (!_value && len == _length) {
+            // Whole value is in this block, no need to copy it
+            _error = end_record(data);
+        } else {
+            if (!_value) {
+                _value = (uint8_t*)malloc(_length);
+                if (!_value) {
+                    _error = M2MTLVDeserializer::OutOfMemory;
+                    break;
+                }
+            }
+            memcpy(_value + _received, data, len);
+        }
+        _received += len;
+        _offset += len;
+        data += len;
+        size -= len;
+
+        if (_received == _length && M2MTLVDeserializer::None == _error) {
+            if (_value) {
+                _error = end_record(_value);
+                free(_value);
+                _value = NULL;
+            }
+            _target = NULL;
+            _state = M2MTLVStreamDeserializer::Header;
+            leave_multiple_resource();
+        }
+    }
+    return _error;
+}
+
+M2MTLVDeserializer::Error M2MTLVStreamDeserializer::finish()
+{
+    _finished = true;
+    if (M2MTLVDeserializer::None == _error &&
+        (M2MTLVStreamDeserializer::Header != _state || _header_len || _multiple_resource || _first)) {
+        tr_error("M2MTLVStreamDeserializer::finish() - payload ends in the middle of a record");
+        _error = M2MTLVDeserializer::NotValid;
+    }
+    return _error;
+}
+
+uint16_t M2MTLVStreamDeserializer::first_id() const
+{
+    return _first_id;
+}
+
+bool M2MTLVStreamDeserializer::finished() const
+{
+    return _finished;
+}
+
+uint32_t M2MTLVStreamDeserializer::next_block() const
+{
+    return _next_block;
+}
+
+void M2MTLVStreamDeserializer::set_next_block(uint32_t block)
+{
+    _next_block = block;
+}
+
+M2MTLVDeserializer::Error M2MTLVStreamDeserializer::begin_record()
+{
+    TypeIdLength til(_header, 0);
+    til.deserialize();
+    _header_len = 0;
+    _type = til._type;
+    _id = til._id;
+    _length = til._length;
+    _received = 0;
+
+    if (_first) {
+        _first = false;
+        _first_id = _id;
+        if (TYPE_RESOURCE != _type && TYPE_MULTIPLE_RESOURCE != _type) {
+            return M2MTLVDeserializer::NotValid;
+        }
+    }
+
+    if (_multiple_resource && _offset + _length > _multiple_resource_end) {
+        tr_error("M2MTLVStreamDeserializer::begin_record() - resource instance exceeds resource");
+        return M2MTLVDeserializer::NotValid;
+    }
+
+    // Length comes from the peer, a value split between blocks is buffered with it
+    if (_length > SN_COAP_MAX_INCOMING_MESSAGE_SIZE) {
+        tr_error("M2MTLVStreamDeserializer::begin_record() - length %" PRIu32 " exceeds maximum message size", _length);
+        return M2MTLVDeserializer::OutOfMemory;
+    }
+
+    M2MTLVDeserializer::Error error = M2MTLVDeserializer::None;
+    if (TYPE_MULTIPLE_RESOURCE == _type) {
+        if (_multiple_resource) {
+            return M2MTLVDeserializer::NotValid;
+        }
+        error = find_resource();
+        if (M2MTLVDeserializer::None == error) {
+            _multiple_resource = (M2MResource*)_target;
+            _multiple_resource_end = _offset + _length;
+            _target = NULL;
+            // Resource instances follow as records of their own
+            leave_multiple_resource();
+        }
+        return error;
+    }
+
+    if (_multiple_resource) {
+        error = (TYPE_RESOURCE_INSTANCE == _type) ? find_resource_instance() : M2MTLVDeserializer::NotValid;
+    } else if (TYPE_RESOURCE == _type || TYPE_RESOURCE_INSTANCE == _type) {
+        error = find_resource();
+    } else {
+        error = M2MTLVDeserializer::NotValid;
+    }
+
+    if (M2MTLVDeserializer::None == error) {
+        if (0 == (_target->operation() & SN_GRS_PUT_ALLOWED)) {
+            tr_debug("M2MTLVStreamDeserializer::begin_record() - NOT_ALLOWED");
+            error = M2MTLVDeserializer::NotAllowed;
+        } else if (!_length) {
+            _target->clear_value();
+            _target = NULL;
+            leave_multiple_resource();
+        } else {
+            _state = M2MTLVStreamDeserializer::Value;
+        }
+    }
+    return error;
+}
+
+M2MTLVDeserializer::Error M2MTLVStreamDeserializer::end_record(const uint8_t *value)
+{
+    tr_debug("M2MTLVStreamDeserializer::end_record() - id %d, length %" PRIu32, _id, _length);
+    if (!M2MTLVDeserializer::set_resource_instance_value(_target, value, _length)) {
+        return M2MTLVDeserializer::OutOfMemory;
+    }
+    return M2MTLVDeserializer::None;
+}
+
+M2MTLVDeserializer::Error M2MTLVStreamDeserializer::find_resource()
+{
+    const bool multi = (TYPE_MULTIPLE_RESOURCE == _type);
+    const M2MResourceList &list = _object_instance.resources();
+    M2MResourceList::const_iterator it = list.begin();
+    for (; it != list.end(); it++) {
+        if ((*it)->name_id() == _id && (!multi || (*it)->supports_multiple_instances())) {
+            _target = *it;
+            return M2MTLVDeserializer::None;
+        }
+    }
+
+    if (M2MTLVDeserializer::Put == _operation) {
+        return M2MTLVDeserializer::NotFound;
+    }
+
+    String name;
+    name.append_int(_id);
+    M2MResource *resource = _object_instance.create_dynamic_resource(name, "", M2MResourceInstance::OPAQUE,
+                                                                     true, multi);
+    if (!resource) {
+        return M2MTLVDeserializer::OutOfMemory;
+    }
+    resource->set_operation(M2MBase::GET_PUT_POST_DELETE_ALLOWED);
+    _target = resource;
+    return M2MTLVDeserializer::None;
+}
+
+M2MTLVDeserializer::Error M2MTLVStreamDeserializer::find_resource_instance()
+{
+    const M2MResourceInstanceList &list = _multiple_resource->resource_instances();
+    M2MResourceInstanceList::const_iterator it = list.begin();
+    for (; it != list.end(); it++) {
+        if ((*it)->instance_id() == _id) {
+            _target = *it;
+            return M2MTLVDeserializer::None;
+        }
+    }
+
+    if (M2MTLVDeserializer::Put == _operation) {
+        return M2MTLVDeserializer::NotFound;
+    }
+
+    M2MResourceInstance *instance = _object_instance.create_dynamic_resource_instance(_multiple_resource->name(), "",
+                                                                                      _multiple_resource->resource_instance_type(),
+                                                                                      true, _id);
+    if (!instance) {
+        return M2MTLVDeserializer::OutOfMemory;
+    }
+    instance->set_operation(M2MBase::GET_PUT_POST_DELETE_ALLOWED);
+    _target = instance;
+    return M2MTLVDeserializer::None;
+}
+
+void M2MTLVStreamDeserializer::leave_multiple_resource()
+{
+    if (_multiple_resource && _offset >= _multiple_resource_end) {
+        _multiple_resource = NULL;
+    }
+}
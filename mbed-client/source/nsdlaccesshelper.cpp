@@ -59,7 +59,7 @@ uint8_t __nsdl_c_send_to_server(struct nsdl_s * nsdl_handle,
     M2MNsdlInterface *interface = (M2MNsdlInterface*)sn_nsdl_get_context(nsdl_handle);
 #if defined(FEA_TRACE_SUPPORT) || MBED_CONF_MBED_TRACE_ENABLE || YOTTA_CFG_MBED_TRACE || (defined(YOTTA_CFG) && !defined(NDEBUG))
     coap_version_e version = COAP_VERSION_UNKNOWN;
-    sn_coap_hdr_s *header = sn_coap_parser(nsdl_handle->grs->coap, data_len, data_ptr, &version);
+    sn_coap_hdr_s *header = sn_coap_parser_zero_copy(nsdl_handle->grs->coap, data_len, data_ptr, &version);
     sn_nsdl_print_coap_data(header, true);
     sn_coap_parser_release_allocated_coap_msg_mem(nsdl_handle->grs->coap, header);
 #endif
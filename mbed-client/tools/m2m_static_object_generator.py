@@ -0,0 +1,226 @@
+#!/usr/bin/env python
+# Copyright (c) 2018 ARM Limited. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Generates pre-built parameter tables of an LWM2M object tree from an OMA object
+model description (LWM2M XML). The output is a header and a source file defining
+a m2m_static_object_s, which is instantiated with
+M2MInterfaceFactory::create_object(const m2m_static_object_s &).
+
+Example:
+    m2m_static_object_generator.py 3303.xml --instances 0-3 --output-dir generated
+"""
+
+import argparse
+import os
+import re
+import sys
+import xml.etree.ElementTree as ElementTree
+
+DATA_TYPES = {
+    'string': 'M2MBase::STRING',
+    'integer': 'M2MBase::INTEGER',
+    'unsigned integer': 'M2MBase::INTEGER',
+    'float': 'M2MBase::FLOAT',
+    'boolean': 'M2MBase::BOOLEAN',
+    'opaque': 'M2MBase::OPAQUE',
+    'time': 'M2MBase::TIME',
+    'objlnk': 'M2MBase::OBJLINK',
+    'corelnk': 'M2MBase::STRING',
+    '': 'M2MBase::OPAQUE',  # executable resources have no type
+}
+
+OPERATIONS = {
+    'r': 'M2MBase::GET_ALLOWED',
+    'w': 'M2MBase::PUT_ALLOWED',
+    'rw': 'M2MBase::GET_PUT_ALLOWED',
+    'e': 'M2MBase::POST_ALLOWED',
+    '': 'M2MBase::NOT_ALLOWED',
+}
+
+
+class Resource(object):
+    def __init__(self, resource_id, name, operations, multiple, data_type):
+        self.resource_id = resource_id
+        self.name = name
+        self.operations = operations
+        self.multiple = multiple
+        self.data_type = data_type
+
+
+def child_text(element, tag):
+    child = element.find(tag)
+    if child is None or child.text is None:
+        return ''
+    return child.text.strip()
+
+
+def parse_object(path):
+    root = ElementTree.parse(path).getroot()
+    obj = root if root.tag == 'Object' else root.find('Object')
+    if obj is None:
+        raise ValueError('%s: no Object element' % path)
+
+    object_id = int(child_text(obj, 'ObjectID'))
+    resources = []
+    for item in obj.find('Resources').findall('Item'):
+        operations = child_text(item, 'Operations').lower()
+        data_type = child_text(item, 'Type').lower()
+        if operations not in OPERATIONS:
+            raise ValueError('%s: resource %s has unknown operations "%s"' % (path, item.get('ID'), operations))
+        if data_type not in DATA_TYPES:
+            raise ValueError('%s: resource %s has unknown type "%s"' % (path, item.get('ID'), data_type))
+        resources.append(Resource(int(item.get('ID')),
+                                  child_text(item, 'Name'),
+                                  operations,
+                                  child_text(item, 'MultipleInstances').lower() == 'multiple',
+                                  data_type))
+    return object_id, child_text(obj, 'Name'), resources
+
+
+def parse_instances(value):
+    instances = []
+    for part in value.split(','):
+        if '-' in part:
+            first, last = part.split('-', 1)
+            instances.extend(range(int(first), int(last) + 1))
+        else:
+            instances.append(int(part))
+    if len(set(instances)) != len(instances):
+        raise ValueError('duplicate instance ids in "%s"' % value)
+    return instances
+
+
+def c_bool(value):
+    return 'true' if value else 'false'
+
+
+def generate_source(out, header_name, prefix, object_id, object_name, resources, instances):
+    out.write('// Generated by m2m_static_object_generator.py, do not edit.\n')
+    out.write('// Object %d: %s\n\n' % (object_id, object_name))
+    out.write('#include "%s"\n' % header_name)
+    out.write('#include "mbed-client/m2mconstants.h"\n\n')
+
+    object_path = '%d' % object_id
+
+    # Object and object instances
+    out.write('M2M_STATIC_PARAM_TYPE\n')
+    out.write('static sn_nsdl_static_resource_parameters_s %s_static = {\n' % prefix)
+    out.write('    M2M_STATIC_NO_ATTRIBUTES (char*)"%s", false, SN_GRS_DYNAMIC, false\n};\n\n' % object_path)
+
+    out.write('static sn_nsdl_dynamic_resource_parameters_s %s_dynamic = {\n' % prefix)
+    out.write('    NULL, &%s_static, NULL, {NULL, NULL}, 0, COAP_CONTENT_OMA_TLV_TYPE_OLD, 0,\n' % prefix)
+    out.write('    M2MBase::GET_ALLOWED, 0, true, false, false, false\n};\n\n')
+
+    out.write('static const M2MBase::lwm2m_parameters_s %s_params = {\n' % prefix)
+    out.write('    0, {(char*)"%s"}, &%s_dynamic, M2MBase::Object, M2MBase::OBJLINK, false, false, false, false\n};\n\n'
+              % (object_path, prefix))
+
+    out.write('M2M_STATIC_PARAM_TYPE\n')
+    out.write('static sn_nsdl_static_resource_parameters_s %s_instances_static[] = {\n' % prefix)
+    for instance_id in instances:
+        out.write('    { M2M_STATIC_NO_ATTRIBUTES (char*)"%s/%d", false, SN_GRS_DYNAMIC, false },\n'
+                  % (object_path, instance_id))
+    out.write('};\n\n')
+
+    out.write('static sn_nsdl_dynamic_resource_parameters_s %s_instances_dynamic[] = {\n' % prefix)
+    for index in range(len(instances)):
+        out.write('    { NULL, &%s_instances_static[%d], NULL, {NULL, NULL}, 0, COAP_CONTENT_OMA_TLV_TYPE_OLD, 0,\n'
+                  % (prefix, index))
+        out.write('      M2MBase::GET_ALLOWED, 0, true, false, false, false },\n')
+    out.write('};\n\n')
+
+    # Identifier of the instances is written by the loader, so these stay in RAM
+    out.write('static M2MBase::lwm2m_parameters_s %s_instances_params[] = {\n' % prefix)
+    for index in range(len(instances)):
+        out.write('    { 0, {NULL}, &%s_instances_dynamic[%d], M2MBase::ObjectInstance, M2MBase::OBJLINK, false, false, true, false },\n'
+                  % (prefix, index))
+    out.write('};\n\n')
+
+    # Resources of each instance
+    for instance_id in instances:
+        instance_prefix = '%s_%d' % (prefix, instance_id)
+        out.write('M2M_STATIC_PARAM_TYPE\n')
+        out.write('static sn_nsdl_static_resource_parameters_s %s_static[] = {\n' % instance_prefix)
+        for res in resources:
+            out.write('    { M2M_STATIC_NO_ATTRIBUTES (char*)"%s/%d/%d", false, SN_GRS_DYNAMIC, false }, // %s\n'
+                      % (object_path, instance_id, res.resource_id, res.name))
+        out.write('};\n\n')
+
+        out.write('static sn_nsdl_dynamic_resource_parameters_s %s_dynamic[] = {\n' % instance_prefix)
+        for index, res in enumerate(resources):
+            content_type = 'COAP_CONTENT_OMA_TLV_TYPE_OLD' if res.multiple else 'COAP_CONTENT_OMA_PLAIN_TEXT_TYPE'
+            observable = 'r' in res.operations
+            out.write('    { NULL, &%s_static[%d], NULL, {NULL, NULL}, 0, %s, 0,\n'
+                      % (instance_prefix, index, content_type))
+            out.write('      %s, 0, true, false, %s, false },\n' % (OPERATIONS[res.operations], c_bool(observable)))
+        out.write('};\n\n')
+
+        out.write('static const M2MBase::lwm2m_parameters_s %s_resources[] = {\n' % instance_prefix)
+        for index, res in enumerate(resources):
+            out.write('    { 0, {(char*)"%d"}, &%s_dynamic[%d], M2MBase::Resource, %s, %s, false, false, false },\n'
+                      % (res.resource_id, instance_prefix, index, DATA_TYPES[res.data_type], c_bool(res.multiple)))
+        out.write('};\n\n')
+
+    out.write('static const m2m_static_object_instance_s %s_instances[] = {\n' % prefix)
+    for index, instance_id in enumerate(instances):
+        out.write('    { &%s_instances_params[%d], %d, %d, %s_%d_resources },\n'
+                  % (prefix, index, instance_id, len(resources), prefix, instance_id))
+    out.write('};\n\n')
+
+    out.write('const m2m_static_object_s %s = {\n' % prefix)
+    out.write('    &%s_params, %d, %s_instances\n};\n' % (prefix, len(instances), prefix))
+
+
+def generate_header(out, guard, prefix, object_id, object_name):
+    out.write('// Generated by m2m_static_object_generator.py, do not edit.\n')
+    out.write('// Object %d: %s\n\n' % (object_id, object_name))
+    out.write('#ifndef %s\n#define %s\n\n' % (guard, guard))
+    out.write('#include "mbed-client/m2mstaticobject.h"\n\n')
+    out.write('extern const m2m_static_object_s %s;\n\n' % prefix)
+    out.write('#endif // %s\n' % guard)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generates pre-built LWM2M object tree tables from an OMA object model')
+    parser.add_argument('model', help='LWM2M object model XML file')
+    parser.add_argument('--instances', default='0',
+                        help='object instance ids to generate, e.g. "0,1" or "0-99" (default: 0)')
+    parser.add_argument('--name', help='C identifier of the generated object (default: m2m_object_<id>)')
+    parser.add_argument('--output-dir', default='.', help='directory for the generated files')
+    args = parser.parse_args()
+
+    try:
+        object_id, object_name, resources = parse_object(args.model)
+        instances = parse_instances(args.instances)
+    except (ValueError, ElementTree.ParseError) as error:
+        sys.stderr.write('error: %s\n' % error)
+        return 1
+
+    prefix = args.name or 'm2m_object_%d' % object_id
+    if not re.match(r'^[A-Za-z_][A-Za-z0-9_]*$', prefix):
+        sys.stderr.write('error: "%s" is not a valid C identifier\n' % prefix)
+        return 1
+
+    header_name = prefix + '.h'
+    with open(os.path.join(args.output_dir, header_name), 'w') as out:
+        generate_header(out, prefix.upper() + '_H', prefix, object_id, object_name)
+    with open(os.path.join(args.output_dir, prefix + '.cpp'), 'w') as out:
+        generate_source(out, header_name, prefix, object_id, object_name, resources, instances)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -233,6 +233,10 @@ typedef struct sn_coap_hdr_ {
 
     /* Here are not so often used Options */
     sn_coap_options_list_s *options_list_ptr;   /**< Must be set to NULL if not used */
+
+    /* Set only by sn_coap_parser_zero_copy(), pointers inside this range are not owned by the message */
+    uint8_t                *packet_ref_ptr;     /**< Packet buffer the message refers to, NULL if message owns its buffers */
+    uint16_t                packet_ref_len;     /**< Length of the referred packet buffer */
 } sn_coap_hdr_s;
 
 /* * * * * * * * * * * * * * */
@@ -312,6 +316,44 @@ typedef struct sn_nsdl_addr_ {
  */
 extern sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr);
 
+/**
+ * \fn sn_coap_hdr_s *sn_coap_parser_zero_copy(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+ *
+ * \brief Parses CoAP message from given Packet data without copying option values
+ *
+ *        Token and single part options (e.g. one segment Uri-Path) point directly to the given
+ *        Packet data, options consisting of several parts are still copied. Packet data is not modified.
+ *        Packet data must stay valid until the message is released with
+ *        sn_coap_parser_release_allocated_coap_msg_mem() or detached with sn_coap_parser_detach_from_packet().
+ *
+ * \param *handle Pointer to CoAP library handle
+ *
+ * \param packet_data_len is length of given Packet data to be parsed to CoAP message
+ *
+ * \param *packet_data_ptr is source for Packet data to be parsed to CoAP message
+ *
+ * \param *coap_version_ptr is destination for parsed CoAP specification version
+ *
+ * \return Return value is pointer to parsed CoAP message, see sn_coap_parser()
+ */
+extern sn_coap_hdr_s *sn_coap_parser_zero_copy(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr);
+
+/**
+ * \fn int8_t sn_coap_parser_detach_from_packet(struct coap_s *handle, sn_coap_hdr_s *coap_msg_ptr)
+ *
+ * \brief Copies token and options referring to the Packet data into own buffers
+ *
+ *        Must be called for a message parsed with sn_coap_parser_zero_copy() before it is retained
+ *        beyond the lifetime of the Packet data. As with sn_coap_parser(), the payload is not copied.
+ *
+ * \param *handle Pointer to CoAP library handle
+ *
+ * \param *coap_msg_ptr is the message to be detached
+ *
+ * \return 0 on success, -1 if memory allocation fails, message is still valid but remains attached
+ */
+extern int8_t sn_coap_parser_detach_from_packet(struct coap_s *handle, sn_coap_hdr_s *coap_msg_ptr);
+
 /**
  * \fn void sn_coap_parser_release_allocated_coap_msg_mem(struct coap_s *handle, sn_coap_hdr_s *freed_coap_msg_ptr)
  *
@@ -29,6 +29,24 @@ extern "C" {
 
 #include "sn_coap_header.h"
 
+/**
+ * \brief Statistics of a pool of freed objects kept for reuse
+ */
+typedef struct sn_coap_mem_pool_stats_ {
+    uint32_t hits;      /**< Allocations served from the pool */
+    uint32_t misses;    /**< Allocations which called the malloc function */
+    uint8_t  cached;    /**< Objects currently held by the pool */
+} sn_coap_mem_pool_stats_s;
+
+/**
+ * \brief Statistics of all the object pools of a CoAP library handle
+ */
+typedef struct sn_coap_mem_stats_ {
+    sn_coap_mem_pool_stats_s headers;   /**< Message headers, sn_coap_hdr_s */
+    sn_coap_mem_pool_stats_s options;   /**< Option lists, sn_coap_options_list_s */
+    sn_coap_mem_pool_stats_s send_msgs; /**< Messages stored for re-sending */
+} sn_coap_mem_stats_s;
+
 /**
  * \fn struct coap_s *sn_coap_protocol_init(void* (*used_malloc_func_ptr)(uint16_t), void (*used_free_func_ptr)(void*),
         uint8_t (*used_tx_callback_ptr)(sn_nsdl_capab_e , uint8_t *, uint16_t, sn_nsdl_addr_s *),
@@ -110,7 +128,10 @@ extern int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst
  *         In following failure cases NULL is returned:\n
  *          -Given NULL pointer\n
  *          -Failure in parsed header of non-confirmable message\ŋ
- *          -Out of memory (malloc() returns NULL)
+ *          -Out of memory (malloc() returns NULL)\n
+ *         Token and options of the returned message may refer to packet_data_ptr,
+ *         call sn_coap_parser_detach_from_packet() before keeping the message
+ *         after the packet buffer is released.
  */
 extern sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, void *);
 
@@ -133,6 +154,23 @@ extern sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr
 
 extern int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time);
 
+/**
+ * \fn int8_t sn_coap_protocol_get_next_deadline(struct coap_s *handle, uint32_t *deadline_ptr)
+ *
+ * \brief Returns the earliest time at which sn_coap_protocol_exec() has work to do,
+ *        i.e. next re-sending or expiry of duplication or blockwise data.
+ *        Caller can sleep until then instead of calling sn_coap_protocol_exec() periodically.
+ *        Deadline must be re-queried after messages are built or parsed.
+ *
+ * \param *handle Pointer to CoAP library handle
+ *
+ * \param *deadline_ptr Destination for the deadline, in the same time base as current_time of sn_coap_protocol_exec()
+ *
+ * \return  0 if deadline was set
+ *          -1 if nothing is pending or parameters are invalid
+ */
+extern int8_t sn_coap_protocol_get_next_deadline(struct coap_s *handle, uint32_t *deadline_ptr);
+
 /**
  * \fn int8_t sn_coap_protocol_set_block_size(uint16_t block_size)
  *
@@ -155,6 +193,34 @@ extern int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t bl
  */
 extern int8_t sn_coap_protocol_set_duplicate_buffer_size(struct coap_s *handle, uint8_t message_count);
 
+/**
+ * \fn int8_t sn_coap_protocol_set_mem_pool_size(struct coap_s *handle, uint8_t pool_size)
+ *
+ * \brief If object pooling is enabled, this function changes how many freed message headers,
+ *        option lists and re-sending messages are kept for reuse, per object type.
+ *        Objects exceeding the new size are freed. Setting 0 releases all the pooled objects.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param pool_size Maximum number of objects kept per object type
+ *
+ * \return  0 = success
+ *          -1 = failure
+ */
+extern int8_t sn_coap_protocol_set_mem_pool_size(struct coap_s *handle, uint8_t pool_size);
+
+/**
+ * \fn int8_t sn_coap_protocol_get_mem_pool_stats(struct coap_s *handle, sn_coap_mem_stats_s *stats_ptr)
+ *
+ * \brief If object pooling is enabled, this function returns the hit and miss counts of the object pools.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param *stats_ptr Destination for the statistics
+ *
+ * \return  0 = success
+ *          -1 = failure
+ */
+extern int8_t sn_coap_protocol_get_mem_pool_stats(struct coap_s *handle, sn_coap_mem_stats_s *stats_ptr);
+
 /**
  * \fn int8_t sn_coap_protocol_set_retransmission_parameters(uint8_t resending_count, uint8_t resending_intervall)
  *
@@ -235,6 +301,27 @@ extern int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint
  */
 extern int8_t sn_coap_convert_block_size(uint16_t block_size);
 
+/**
+ * \fn int8_t sn_coap_protocol_set_block_reassembly_in_place(struct coap_s *handle, uint8_t in_place)
+ *
+ * \brief This function changes how received blockwise payload is reassembled.
+ *
+ * By default every block is stored separately and blocks are concatenated when the last one is
+ * received, which requires the blocks to arrive in order. When reassembly in place is enabled,
+ * a buffer for the whole payload is allocated when a block with Size1 (requests) or Size2 (responses)
+ * option is received, blocks are written directly to their offset in any order, and the buffer is
+ * handed over as the payload of the message with COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED status.
+ * Transfers without the size option keep using the default mode.
+ *
+ * Payloads received in place are not visible to sn_coap_protocol_block_remove().
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param in_place 1 to enable reassembly in place, 0 to disable.
+ *
+ * \return  0 = success, -1 = failure
+ */
+extern int8_t sn_coap_protocol_set_block_reassembly_in_place(struct coap_s *handle, uint8_t in_place);
+
 /**
  * \fn int8_t sn_coap_protocol_handle_block2_response_internally(struct coap_s *handle, uint8_t handle_response)
  *
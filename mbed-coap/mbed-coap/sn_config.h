@@ -115,6 +115,15 @@
  */
 #undef SN_COAP_BLOCKWISE_ENABLED                    /* 0 */
 
+/**
+ * \def SN_COAP_MEM_POOL_SIZE
+ * \brief Sets the number of freed CoAP message headers, option lists and
+ * re-sending messages which are kept for reuse, per object type. This avoids
+ * heap churn as these are allocated and freed on every sent and received message.
+ * Setting this to 0 disables the feature. Default is 4.
+ */
+#undef SN_COAP_MEM_POOL_SIZE                        /* 4 */
+
 #ifdef MBED_CLIENT_USER_CONFIG_FILE
 #include MBED_CLIENT_USER_CONFIG_FILE
 #endif
@@ -71,7 +71,9 @@ struct sn_coap_hdr_;
 
 /* These parameters sets maximum values application can set with API */
 #define SN_COAP_MAX_ALLOWED_RESENDING_COUNT             6   /**< Maximum allowed count of re-sending */
+#ifndef SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS
 #define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS    6   /**< Maximum allowed number of saved re-sending messages */
+#endif
 #define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES   512 /**< Maximum allowed size of re-sending buffer */
 #define SN_COAP_MAX_ALLOWED_RESPONSE_TIMEOUT            40  /**< Maximum allowed re-sending timeout */
 
@@ -96,7 +98,21 @@ struct sn_coap_hdr_;
 
 
 /* Maximum allowed number of saved messages for duplicate searching */
+#ifndef SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT
 #define SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT   6
+#endif
+
+/* Slots in the tables used to look up duplication infos and re-sending messages by port and message ID.
+ * Must be a power of two and larger than the maximum number of stored messages. */
+#ifndef SN_COAP_MSG_INDEX_SIZE
+#define SN_COAP_MSG_INDEX_SIZE                          16
+#endif
+
+#if (SN_COAP_MSG_INDEX_SIZE & (SN_COAP_MSG_INDEX_SIZE - 1)) || \
+    (SN_COAP_MSG_INDEX_SIZE <= SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT) || \
+    (SN_COAP_MSG_INDEX_SIZE <= SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS)
+#error "SN_COAP_MSG_INDEX_SIZE must be a power of two and larger than the maximum number of stored messages"
+#endif
 
 /* Maximum time in seconds of messages to be stored for duplication detection */
 #define SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED    60 /* RESPONSE_TIMEOUT * RESPONSE_RANDOM_FACTOR * (2 ^ MAX_RETRANSMIT - 1) + the expected maximum round trip time */
@@ -143,6 +159,21 @@ struct sn_coap_hdr_;
 #define SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE UINT16_MAX
 #endif
 
+/* * For object pooling * */
+
+/* Number of freed message headers, option lists and re-sending messages kept for reuse, per object type */
+/* Setting of this value to 0 will disable pooling, every object is then allocated and freed directly   */
+
+#ifdef YOTTA_CFG_COAP_MEM_POOL_SIZE
+#define SN_COAP_MEM_POOL_SIZE YOTTA_CFG_COAP_MEM_POOL_SIZE
+#elif defined MBED_CONF_MBED_CLIENT_SN_COAP_MEM_POOL_SIZE
+#define SN_COAP_MEM_POOL_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_MEM_POOL_SIZE
+#endif
+
+#ifndef SN_COAP_MEM_POOL_SIZE
+#define SN_COAP_MEM_POOL_SIZE                       4
+#endif
+
 /* * For Option handling * */
 #define COAP_OPTION_MAX_AGE_DEFAULT                 60 /**< Default value of Max-Age if option not present */
 #define COAP_OPTION_URI_PORT_NONE                   (-1) /**< Internal value to represent no Uri-Port option */
@@ -151,6 +182,28 @@ struct sn_coap_hdr_;
 
 int8_t prepare_blockwise_message(struct coap_s *handle, struct sn_coap_hdr_ *coap_hdr_ptr);
 
+/* Fixed size objects which are recycled through the per handle pools */
+typedef enum coap_mem_pool_type_ {
+    COAP_MEM_POOL_HDR = 0,      /* sn_coap_hdr_s */
+    COAP_MEM_POOL_OPTIONS,      /* sn_coap_options_list_s */
+    COAP_MEM_POOL_SEND_MSG,     /* coap_send_msg_s */
+    COAP_MEM_POOL_TYPE_COUNT
+} coap_mem_pool_type_e;
+
+/* Free list of one object type, blocks are chained through their first bytes */
+typedef struct coap_mem_pool_ {
+    void                *free_list;
+    uint8_t             count;      /* Blocks currently in free_list */
+    uint32_t            hits;       /* Allocations served from free_list */
+    uint32_t            misses;     /* Allocations passed to the malloc function */
+} coap_mem_pool_s;
+
+/* Allocates uninitialized object of given type, from the pool if possible */
+void *sn_coap_mem_pool_alloc(struct coap_s *handle, coap_mem_pool_type_e type);
+
+/* Returns object allocated with sn_coap_mem_pool_alloc() to the pool, or frees it if the pool is full */
+void sn_coap_mem_pool_free(struct coap_s *handle, coap_mem_pool_type_e type, void *ptr);
+
 /* Structure which is stored to Linked list for message sending purposes */
 typedef struct coap_send_msg_ {
     uint8_t             resending_counter;  /* Tells how many times message is still tried to resend */
@@ -166,6 +219,12 @@ typedef struct coap_send_msg_ {
 
 typedef NS_LIST_HEAD(coap_send_msg_s, link) coap_send_msg_list_t;
 
+/* Slot of a fixed size open addressing table indexing stored messages by port and message ID */
+typedef struct coap_msg_index_entry_ {
+    void                *msg_ptr;   /* coap_send_msg_s or coap_duplication_info_s, NULL if slot is free */
+    uint16_t            hash;
+} coap_msg_index_entry_s;
+
 /* Structure which is stored to Linked list for message duplication detection purposes */
 typedef struct coap_duplication_info_ {
     uint32_t            timestamp; /* Tells when duplication information is stored to Linked list */
@@ -215,6 +274,30 @@ typedef struct coap_blockwise_payload_ {
 
 typedef NS_LIST_HEAD(coap_blockwise_payload_s, link) coap_blockwise_payload_list_t;
 
+/* Structure which is stored to Linked list when blockwise payload is received in place */
+typedef struct coap_blockwise_reassembly_ {
+    uint32_t            timestamp;      /* Tells when latest block was received */
+
+    uint8_t             addr_len;
+    uint8_t             *addr_ptr;
+    uint16_t            port;
+    uint8_t             *token_ptr;
+    uint8_t             token_len;
+
+    bool                block1;         /* Payload of a request (Block1) or of a response (Block2) */
+    bool                last_block_received;
+    uint16_t            block_size;
+    uint16_t            allocated_len;  /* Size of payload_ptr, from Size1 or Size2 option */
+    uint16_t            payload_len;    /* Length of whole payload, valid when last block is received */
+    uint16_t            received_len;   /* Bytes written to payload_ptr */
+    uint8_t             *payload_ptr;
+    uint8_t             *bitmap_ptr;    /* One bit per received block */
+
+    ns_list_link_t      link;
+} coap_blockwise_reassembly_s;
+
+typedef NS_LIST_HEAD(coap_blockwise_reassembly_s, link) coap_blockwise_reassembly_list_t;
+
 struct coap_s {
     void *(*sn_coap_protocol_malloc)(uint16_t);
     void (*sn_coap_protocol_free)(void *);
@@ -224,17 +307,25 @@ struct coap_s {
 
     #if ENABLE_RESENDINGS /* If Message resending is not used at all, this part of code will not be compiled */
         coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list */
+        coap_msg_index_entry_s resent_msgs_index[SN_COAP_MSG_INDEX_SIZE]; /* Lookup table for the resending messages */
         uint16_t count_resent_msgs;
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
-        coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
+        coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list, oldest first */
+        coap_msg_index_entry_s        duplication_msgs_index[SN_COAP_MSG_INDEX_SIZE]; /* Lookup table for the duplication infos */
         uint16_t                      count_duplication_msgs;
     #endif
 
     #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not enabled, this part of code will not be compiled */
         coap_blockwise_msg_list_t     linked_list_blockwise_sent_msgs; /* Blockwise message to to be sent is stored to this Linked list */
         coap_blockwise_payload_list_t linked_list_blockwise_received_payloads; /* Blockwise payload to to be received is stored to this Linked list */
+        coap_blockwise_reassembly_list_t linked_list_blockwise_reassemblies; /* Blockwise payload to be received in place is stored to this Linked list */
+    #endif
+
+    #if SN_COAP_MEM_POOL_SIZE /* If object pooling is not used at all, this part of code will not be compiled */
+        coap_mem_pool_s               mem_pools[COAP_MEM_POOL_TYPE_COUNT];
+        uint8_t                       sn_coap_mem_pool_size; /* Maximum number of blocks kept per pool */
     #endif
 
     uint32_t system_time;    /* System time seconds */
@@ -245,6 +336,7 @@ struct coap_s {
     uint8_t sn_coap_resending_intervall;
     uint8_t sn_coap_duplication_buffer_size;
     uint8_t sn_coap_internal_block2_resp_handling; /* If this is set then coap itself sends a next GET request automatically */
+    uint8_t sn_coap_block_reassembly_in_place; /* If this is set then blockwise payload with Size1/Size2 is received to a preallocated buffer */
 };
 
 #ifdef __cplusplus
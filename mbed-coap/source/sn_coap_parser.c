@@ -42,9 +42,13 @@
 /* * * * LOCAL FUNCTION PROTOTYPES * * * */
 /* * * * * * * * * * * * * * * * * * * * */
 
+static sn_coap_hdr_s *sn_coap_parser_parse(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr, bool zero_copy);
 static void     sn_coap_parser_header_parse(uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, coap_version_e *coap_version_ptr);
 static int8_t   sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len);
-static int8_t   sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len);
+static int8_t   sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len, bool zero_copy);
+static bool     sn_coap_parser_is_packet_ref(const sn_coap_hdr_s *coap_msg_ptr, const uint8_t *ptr);
+static int8_t   sn_coap_parser_detach_buffer(struct coap_s *handle, const sn_coap_hdr_s *coap_msg_ptr, uint8_t **buffer_pptr, uint16_t buffer_len);
+static void     sn_coap_parser_free_buffer(struct coap_s *handle, const sn_coap_hdr_s *coap_msg_ptr, uint8_t *buffer_ptr);
 static int16_t  sn_coap_parser_options_count_needed_memory_multiple_option(uint8_t *packet_data_ptr, uint16_t packet_left_len, sn_coap_option_numbers_e option, uint16_t option_number_len);
 static int8_t   sn_coap_parser_payload_parse(uint16_t packet_data_len, uint8_t *packet_data_start_ptr, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr);
 
@@ -74,7 +78,7 @@ sn_coap_hdr_s *sn_coap_parser_alloc_message(struct coap_s *handle)
     }
 
     /* * * * Allocate memory for returned CoAP message and initialize allocated memory with with default values  * * * */
-    returned_coap_msg_ptr = handle->sn_coap_protocol_malloc(sizeof(sn_coap_hdr_s));
+    returned_coap_msg_ptr = sn_coap_mem_pool_alloc(handle, COAP_MEM_POOL_HDR);
 
     return sn_coap_parser_init_message(returned_coap_msg_ptr);
 }
@@ -92,7 +96,7 @@ sn_coap_options_list_s *sn_coap_parser_alloc_options(struct coap_s *handle, sn_c
     }
 
     /* * * * Allocate memory for options and initialize allocated memory with with default values  * * * */
-    coap_msg_ptr->options_list_ptr = handle->sn_coap_protocol_malloc(sizeof(sn_coap_options_list_s));
+    coap_msg_ptr->options_list_ptr = sn_coap_mem_pool_alloc(handle, COAP_MEM_POOL_OPTIONS);
 
     if (coap_msg_ptr->options_list_ptr == NULL) {
         tr_error("sn_coap_parser_alloc_options - failed to allocate options list!");
@@ -113,6 +117,55 @@ sn_coap_options_list_s *sn_coap_parser_alloc_options(struct coap_s *handle, sn_c
 }
 
 sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+{
+    return sn_coap_parser_parse(handle, packet_data_len, packet_data_ptr, coap_version_ptr, false);
+}
+
+sn_coap_hdr_s *sn_coap_parser_zero_copy(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+{
+    return sn_coap_parser_parse(handle, packet_data_len, packet_data_ptr, coap_version_ptr, true);
+}
+
+int8_t sn_coap_parser_detach_from_packet(struct coap_s *handle, sn_coap_hdr_s *coap_msg_ptr)
+{
+    if (handle == NULL || coap_msg_ptr == NULL) {
+        return -1;
+    }
+
+    if (coap_msg_ptr->packet_ref_ptr == NULL) {
+        return 0;
+    }
+
+    if (sn_coap_parser_detach_buffer(handle, coap_msg_ptr, &coap_msg_ptr->token_ptr, coap_msg_ptr->token_len) != 0 ||
+        sn_coap_parser_detach_buffer(handle, coap_msg_ptr, &coap_msg_ptr->uri_path_ptr, coap_msg_ptr->uri_path_len) != 0) {
+        return -1;
+    }
+
+    sn_coap_options_list_s *options_ptr = coap_msg_ptr->options_list_ptr;
+    if (options_ptr) {
+        if (sn_coap_parser_detach_buffer(handle, coap_msg_ptr, &options_ptr->proxy_uri_ptr, options_ptr->proxy_uri_len) != 0 ||
+            sn_coap_parser_detach_buffer(handle, coap_msg_ptr, &options_ptr->etag_ptr, options_ptr->etag_len) != 0 ||
+            sn_coap_parser_detach_buffer(handle, coap_msg_ptr, &options_ptr->uri_host_ptr, options_ptr->uri_host_len) != 0 ||
+            sn_coap_parser_detach_buffer(handle, coap_msg_ptr, &options_ptr->location_path_ptr, options_ptr->location_path_len) != 0 ||
+            sn_coap_parser_detach_buffer(handle, coap_msg_ptr, &options_ptr->location_query_ptr, options_ptr->location_query_len) != 0 ||
+            sn_coap_parser_detach_buffer(handle, coap_msg_ptr, &options_ptr->uri_query_ptr, options_ptr->uri_query_len) != 0) {
+            return -1;
+        }
+    }
+
+    /* Payload keeps pointing to the packet as with sn_coap_parser(), it is never released by the parser */
+    coap_msg_ptr->packet_ref_ptr = NULL;
+    coap_msg_ptr->packet_ref_len = 0;
+
+    return 0;
+}
+
+/**
+ * \brief Parses CoAP message, common part of sn_coap_parser() and sn_coap_parser_zero_copy()
+ *
+ * \param zero_copy if true, token and single part options point to the packet data
+ */
+static sn_coap_hdr_s *sn_coap_parser_parse(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr, bool zero_copy)
 {
     uint8_t       *data_temp_ptr                    = packet_data_ptr;
     sn_coap_hdr_s *parsed_and_returned_coap_msg_ptr = NULL;
@@ -130,6 +183,11 @@ sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, u
         return NULL;
     }
 
+    if (zero_copy) {
+        parsed_and_returned_coap_msg_ptr->packet_ref_ptr = packet_data_ptr;
+        parsed_and_returned_coap_msg_ptr->packet_ref_len = packet_data_len;
+    }
+
     /* * * * Header parsing, move pointer over the header...  * * * */
     sn_coap_parser_header_parse(&data_temp_ptr, parsed_and_returned_coap_msg_ptr, coap_version_ptr);
 
@@ -156,43 +214,63 @@ void sn_coap_parser_release_allocated_coap_msg_mem(struct coap_s *handle, sn_coa
     }
 
     if (freed_coap_msg_ptr != NULL) {
-        if (freed_coap_msg_ptr->uri_path_ptr != NULL) {
-            handle->sn_coap_protocol_free(freed_coap_msg_ptr->uri_path_ptr);
-        }
-
-        if (freed_coap_msg_ptr->token_ptr != NULL) {
-            handle->sn_coap_protocol_free(freed_coap_msg_ptr->token_ptr);
-        }
+        sn_coap_parser_free_buffer(handle, freed_coap_msg_ptr, freed_coap_msg_ptr->uri_path_ptr);
+        sn_coap_parser_free_buffer(handle, freed_coap_msg_ptr, freed_coap_msg_ptr->token_ptr);
 
         if (freed_coap_msg_ptr->options_list_ptr != NULL) {
-            if (freed_coap_msg_ptr->options_list_ptr->proxy_uri_ptr != NULL) {
-                handle->sn_coap_protocol_free(freed_coap_msg_ptr->options_list_ptr->proxy_uri_ptr);
-            }
-
-            if (freed_coap_msg_ptr->options_list_ptr->etag_ptr != NULL) {
-                handle->sn_coap_protocol_free(freed_coap_msg_ptr->options_list_ptr->etag_ptr);
-            }
+            sn_coap_parser_free_buffer(handle, freed_coap_msg_ptr, freed_coap_msg_ptr->options_list_ptr->proxy_uri_ptr);
+            sn_coap_parser_free_buffer(handle, freed_coap_msg_ptr, freed_coap_msg_ptr->options_list_ptr->etag_ptr);
+            sn_coap_parser_free_buffer(handle, freed_coap_msg_ptr, freed_coap_msg_ptr->options_list_ptr->uri_host_ptr);
+            sn_coap_parser_free_buffer(handle, freed_coap_msg_ptr, freed_coap_msg_ptr->options_list_ptr->location_path_ptr);
+            sn_coap_parser_free_buffer(handle, freed_coap_msg_ptr, freed_coap_msg_ptr->options_list_ptr->location_query_ptr);
+            sn_coap_parser_free_buffer(handle, freed_coap_msg_ptr, freed_coap_msg_ptr->options_list_ptr->uri_query_ptr);
+
+            sn_coap_mem_pool_free(handle, COAP_MEM_POOL_OPTIONS, freed_coap_msg_ptr->options_list_ptr);
+        }
 
-            if (freed_coap_msg_ptr->options_list_ptr->uri_host_ptr != NULL) {
-                handle->sn_coap_protocol_free(freed_coap_msg_ptr->options_list_ptr->uri_host_ptr);
-            }
+        sn_coap_mem_pool_free(handle, COAP_MEM_POOL_HDR, freed_coap_msg_ptr);
+    }
+}
 
-            if (freed_coap_msg_ptr->options_list_ptr->location_path_ptr != NULL) {
-                handle->sn_coap_protocol_free(freed_coap_msg_ptr->options_list_ptr->location_path_ptr);
-            }
+/**
+ * \brief Checks whether the pointer refers to the packet data of a zero copy parsed message
+ */
+static bool sn_coap_parser_is_packet_ref(const sn_coap_hdr_s *coap_msg_ptr, const uint8_t *ptr)
+{
+    return coap_msg_ptr->packet_ref_ptr != NULL &&
+           ptr >= coap_msg_ptr->packet_ref_ptr &&
+           ptr < coap_msg_ptr->packet_ref_ptr + coap_msg_ptr->packet_ref_len;
+}
 
-            if (freed_coap_msg_ptr->options_list_ptr->location_query_ptr != NULL) {
-                handle->sn_coap_protocol_free(freed_coap_msg_ptr->options_list_ptr->location_query_ptr);
-            }
+/**
+ * \brief Replaces a buffer referring to the packet data with an allocated copy
+ *
+ * \return 0 on success, -1 if memory allocation fails
+ */
+static int8_t sn_coap_parser_detach_buffer(struct coap_s *handle, const sn_coap_hdr_s *coap_msg_ptr, uint8_t **buffer_pptr, uint16_t buffer_len)
+{
+    if (!sn_coap_parser_is_packet_ref(coap_msg_ptr, *buffer_pptr)) {
+        return 0;
+    }
 
-            if (freed_coap_msg_ptr->options_list_ptr->uri_query_ptr != NULL) {
-                handle->sn_coap_protocol_free(freed_coap_msg_ptr->options_list_ptr->uri_query_ptr);
-            }
+    uint8_t *copy_ptr = handle->sn_coap_protocol_malloc(buffer_len);
+    if (copy_ptr == NULL) {
+        tr_error("sn_coap_parser_detach_from_packet - failed to allocate buffer!");
+        return -1;
+    }
 
-            handle->sn_coap_protocol_free(freed_coap_msg_ptr->options_list_ptr);
-        }
+    memcpy(copy_ptr, *buffer_pptr, buffer_len);
+    *buffer_pptr = copy_ptr;
+    return 0;
+}
 
-        handle->sn_coap_protocol_free(freed_coap_msg_ptr);
+/**
+ * \brief Frees a buffer of the message unless it refers to the packet data
+ */
+static void sn_coap_parser_free_buffer(struct coap_s *handle, const sn_coap_hdr_s *coap_msg_ptr, uint8_t *buffer_ptr)
+{
+    if (buffer_ptr != NULL && !sn_coap_parser_is_packet_ref(coap_msg_ptr, buffer_ptr)) {
+        handle->sn_coap_protocol_free(buffer_ptr);
     }
 }
 
@@ -259,6 +337,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
     uint8_t i                      = 0;
     int8_t  ret_status             = 0;
     uint16_t message_left          = 0;
+    const bool zero_copy           = dst_coap_msg_ptr->packet_ref_ptr != NULL;
 
     /*  Parse token, if exists  */
     dst_coap_msg_ptr->token_len = *packet_data_start_ptr & COAP_HEADER_TOKEN_LENGTH_MASK;
@@ -269,14 +348,18 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             return -1;
         }
 
-        dst_coap_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(dst_coap_msg_ptr->token_len);
+        if (zero_copy) {
+            dst_coap_msg_ptr->token_ptr = *packet_data_pptr;
+        } else {
+            dst_coap_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(dst_coap_msg_ptr->token_len);
 
-        if (dst_coap_msg_ptr->token_ptr == NULL) {
-            tr_error("sn_coap_parser_options_parse - failed to allocate token!");
-            return -1;
-        }
+            if (dst_coap_msg_ptr->token_ptr == NULL) {
+                tr_error("sn_coap_parser_options_parse - failed to allocate token!");
+                return -1;
+            }
 
-        memcpy(dst_coap_msg_ptr->token_ptr, *packet_data_pptr, dst_coap_msg_ptr->token_len);
+            memcpy(dst_coap_msg_ptr->token_ptr, *packet_data_pptr, dst_coap_msg_ptr->token_len);
+        }
         (*packet_data_pptr) += dst_coap_msg_ptr->token_len;
     }
 
@@ -379,14 +462,18 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 dst_coap_msg_ptr->options_list_ptr->proxy_uri_len = option_len;
                 (*packet_data_pptr)++;
 
-                dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = handle->sn_coap_protocol_malloc(option_len);
+                if (zero_copy) {
+                    dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = *packet_data_pptr;
+                } else {
+                    dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = handle->sn_coap_protocol_malloc(option_len);
 
-                if (dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr == NULL) {
-                    tr_error("sn_coap_parser_options_parse - COAP_OPTION_PROXY_URI allocation failed!");
-                    return -1;
-                }
+                    if (dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr == NULL) {
+                        tr_error("sn_coap_parser_options_parse - COAP_OPTION_PROXY_URI allocation failed!");
+                        return -1;
+                    }
 
-                memcpy(dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr, *packet_data_pptr, option_len);
+                    memcpy(dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr, *packet_data_pptr, option_len);
+                }
                 (*packet_data_pptr) += option_len;
 
                 break;
@@ -398,7 +485,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                              message_left,
                              &dst_coap_msg_ptr->options_list_ptr->etag_ptr,
                              (uint16_t *)&dst_coap_msg_ptr->options_list_ptr->etag_len,
-                             COAP_OPTION_ETAG, option_len);
+                             COAP_OPTION_ETAG, option_len, zero_copy);
                 if (ret_status >= 0) {
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
@@ -415,13 +502,17 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 dst_coap_msg_ptr->options_list_ptr->uri_host_len = option_len;
                 (*packet_data_pptr)++;
 
-                dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = handle->sn_coap_protocol_malloc(option_len);
+                if (zero_copy) {
+                    dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = *packet_data_pptr;
+                } else {
+                    dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = handle->sn_coap_protocol_malloc(option_len);
 
-                if (dst_coap_msg_ptr->options_list_ptr->uri_host_ptr == NULL) {
-                    tr_error("sn_coap_parser_options_parse - COAP_OPTION_URI_HOST allocation failed!");
-                    return -1;
+                    if (dst_coap_msg_ptr->options_list_ptr->uri_host_ptr == NULL) {
+                        tr_error("sn_coap_parser_options_parse - COAP_OPTION_URI_HOST allocation failed!");
+                        return -1;
+                    }
+                    memcpy(dst_coap_msg_ptr->options_list_ptr->uri_host_ptr, *packet_data_pptr, option_len);
                 }
-                memcpy(dst_coap_msg_ptr->options_list_ptr->uri_host_ptr, *packet_data_pptr, option_len);
                 (*packet_data_pptr) += option_len;
 
                 break;
@@ -434,7 +525,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 /* This is managed independently because User gives this option in one character table */
                 ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->options_list_ptr->location_path_ptr, &dst_coap_msg_ptr->options_list_ptr->location_path_len,
-                             COAP_OPTION_LOCATION_PATH, option_len);
+                             COAP_OPTION_LOCATION_PATH, option_len, zero_copy);
                 if (ret_status >= 0) {
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
@@ -458,7 +549,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_LOCATION_QUERY:
                 ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->options_list_ptr->location_query_ptr, &dst_coap_msg_ptr->options_list_ptr->location_query_len,
-                             COAP_OPTION_LOCATION_QUERY, option_len);
+                             COAP_OPTION_LOCATION_QUERY, option_len, zero_copy);
                 if (ret_status >= 0) {
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
@@ -471,7 +562,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_URI_PATH:
                 ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->uri_path_ptr, &dst_coap_msg_ptr->uri_path_len,
-                             COAP_OPTION_URI_PATH, option_len);
+                             COAP_OPTION_URI_PATH, option_len, zero_copy);
                 if (ret_status >= 0) {
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
@@ -496,7 +587,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_URI_QUERY:
                 ret_status = sn_coap_parser_options_parse_multiple_options(handle, packet_data_pptr, message_left,
                              &dst_coap_msg_ptr->options_list_ptr->uri_query_ptr, &dst_coap_msg_ptr->options_list_ptr->uri_query_len,
-                             COAP_OPTION_URI_QUERY, option_len);
+                             COAP_OPTION_URI_QUERY, option_len, zero_copy);
                 if (ret_status >= 0) {
                     i += (ret_status - 1); /* i += is because possible several Options are handled by sn_coap_parser_options_parse_multiple_options() */
                 } else {
@@ -593,7 +684,7 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
  *
  * \return Return value is count of Uri-query optios parsed. In failure case -1 is returned.
 */
-static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len)
+static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len, bool zero_copy)
 {
     int16_t     uri_query_needed_heap       = sn_coap_parser_options_count_needed_memory_multiple_option(*packet_data_pptr, packet_left_len, option, option_number_len);
     uint8_t    *temp_parsed_uri_query_ptr   = NULL;
@@ -603,6 +694,15 @@ static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handl
         return -1;
     }
 
+    /* Option with a single part is used as is from the packet, several parts need to be joined */
+    if (zero_copy && uri_query_needed_heap && uri_query_needed_heap == option_number_len) {
+        (*packet_data_pptr)++;
+        *dst_pptr = *packet_data_pptr;
+        *dst_len_ptr = uri_query_needed_heap;
+        (*packet_data_pptr) += option_number_len;
+        return 1;
+    }
+
     if (uri_query_needed_heap) {
         *dst_pptr = (uint8_t *) handle->sn_coap_protocol_malloc(uri_query_needed_heap);
 
@@ -50,9 +50,14 @@
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT/* If Message duplication detection is not used at all, this part of code will not be compiled */
 static void                  sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id, void *param);
 static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(struct coap_s *handle, sn_nsdl_addr_s *scr_addr_ptr, uint16_t msg_id);
-static void                  sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *scr_addr_ptr, uint16_t port, uint16_t msg_id);
+static void                  sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle);
 #endif
+#if ENABLE_RESENDINGS || SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+static uint16_t              sn_coap_protocol_msg_index_hash(uint16_t port, uint16_t msg_id);
+static bool                  sn_coap_protocol_msg_index_add(coap_msg_index_entry_s *index, uint16_t hash, void *msg_ptr);
+static void                  sn_coap_protocol_msg_index_remove(coap_msg_index_entry_s *index, uint16_t hash, const void *msg_ptr);
+#endif
 #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not enabled, this part of code will not be compiled */
 static void                  sn_coap_protocol_linked_list_blockwise_msg_remove(struct coap_s *handle, coap_blockwise_msg_s *removed_msg_ptr);
 static void                  sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t stored_payload_len, uint8_t *stored_payload_ptr, uint8_t *token_ptr, uint8_t token_len, uint32_t block_number);
@@ -61,14 +66,20 @@ static bool                  sn_coap_protocol_linked_list_blockwise_payload_comp
 static void                  sn_coap_protocol_linked_list_blockwise_payload_remove(struct coap_s *handle, coap_blockwise_payload_s *removed_payload_ptr);
 static void                  sn_coap_protocol_linked_list_blockwise_payload_remove_oldest(struct coap_s *handle, uint8_t *token_ptr, uint8_t token_len);
 static uint32_t              sn_coap_protocol_linked_list_blockwise_payloads_get_len(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint8_t *token_ptr, uint8_t token_len);
+static coap_blockwise_reassembly_s *sn_coap_protocol_blockwise_reassembly_get(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, bool block1, int32_t block_option, uint32_t size);
+static int8_t                sn_coap_protocol_blockwise_reassembly_store(struct coap_s *handle, coap_blockwise_reassembly_s *reassembly_ptr, sn_coap_hdr_s *received_coap_msg_ptr, int32_t block_option);
+static void                  sn_coap_protocol_blockwise_reassembly_remove(struct coap_s *handle, coap_blockwise_reassembly_s *removed_reassembly_ptr);
 static void                  sn_coap_protocol_handle_blockwise_timout(struct coap_s *handle);
 static sn_coap_hdr_s        *sn_coap_handle_blockwise_message(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param);
 static sn_coap_hdr_s        *sn_coap_protocol_copy_header(struct coap_s *handle, sn_coap_hdr_s *source_header_ptr);
 #endif
 #if ENABLE_RESENDINGS
 static uint8_t               sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, uint32_t sending_time, void *param);
-static sn_nsdl_transmit_s   *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
 static void                  sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
+static coap_send_msg_s      *sn_coap_protocol_linked_list_send_msg_find(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
+static void                  sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static void                  sn_coap_protocol_linked_list_send_msg_schedule(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static uint16_t              sn_coap_protocol_send_msg_id(const coap_send_msg_s *stored_msg_ptr);
 static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t packet_data_len);
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
 static uint16_t              sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
@@ -94,22 +105,7 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     ns_list_foreach_safe(coap_duplication_info_s, tmp, &handle->linked_list_duplication_msgs) {
         if (tmp->coap == handle) {
-            if (tmp->address) {
-                if (tmp->address->addr_ptr) {
-                    handle->sn_coap_protocol_free(tmp->address->addr_ptr);
-                    tmp->address->addr_ptr = 0;
-                }
-                handle->sn_coap_protocol_free(tmp->address);
-                tmp->address = 0;
-            }
-            if (tmp->packet_ptr) {
-                handle->sn_coap_protocol_free(tmp->packet_ptr);
-                tmp->packet_ptr = 0;
-            }
-            ns_list_remove(&handle->linked_list_duplication_msgs, tmp);
-            handle->count_duplication_msgs--;
-            handle->sn_coap_protocol_free(tmp);
-            tmp = 0;
+            sn_coap_protocol_linked_list_duplication_info_remove(handle, tmp);
         }
     }
 
@@ -146,6 +142,14 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
             tmp = 0;
         }
     }
+    ns_list_foreach_safe(coap_blockwise_reassembly_s, tmp, &handle->linked_list_blockwise_reassemblies) {
+        sn_coap_protocol_blockwise_reassembly_remove(handle, tmp);
+    }
+#endif
+
+#if SN_COAP_MEM_POOL_SIZE
+    /* Everything above may have returned objects to the pools */
+    sn_coap_protocol_set_mem_pool_size(handle, 0);
 #endif
 
     handle->sn_coap_protocol_free(handle);
@@ -204,10 +208,15 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 
     ns_list_init(&handle->linked_list_blockwise_sent_msgs);
     ns_list_init(&handle->linked_list_blockwise_received_payloads);
+    ns_list_init(&handle->linked_list_blockwise_reassemblies);
     handle->sn_coap_block_data_size = SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE;
 
 #endif /* ENABLE_RESENDINGS */
 
+#if SN_COAP_MEM_POOL_SIZE
+    handle->sn_coap_mem_pool_size = SN_COAP_MEM_POOL_SIZE;
+#endif
+
     /* Randomize global message ID */
     randLIB_seed_random();
     message_id = randLIB_get_16bit();
@@ -228,6 +237,22 @@ int8_t sn_coap_protocol_handle_block2_response_internally(struct coap_s *handle,
     return 0;
 }
 
+int8_t sn_coap_protocol_set_block_reassembly_in_place(struct coap_s *handle, uint8_t in_place)
+{
+    (void) handle;
+    (void) in_place;
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    if (handle == NULL) {
+        return -1;
+    }
+
+    handle->sn_coap_block_reassembly_in_place = in_place;
+    return 0;
+#else
+    return -1;
+#endif
+}
+
 int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_size)
 {
     (void) handle;
@@ -286,6 +311,91 @@ int8_t sn_coap_protocol_set_duplicate_buffer_size(struct coap_s *handle, uint8_t
     return -1;
 }
 
+static const uint16_t mem_pool_object_size[COAP_MEM_POOL_TYPE_COUNT] = {
+    sizeof(sn_coap_hdr_s),
+    sizeof(sn_coap_options_list_s),
+    sizeof(coap_send_msg_s)
+};
+
+void *sn_coap_mem_pool_alloc(struct coap_s *handle, coap_mem_pool_type_e type)
+{
+#if SN_COAP_MEM_POOL_SIZE
+    coap_mem_pool_s *pool = &handle->mem_pools[type];
+    void *ptr = pool->free_list;
+    if (ptr) {
+        pool->free_list = *(void **)ptr;
+        pool->count--;
+        pool->hits++;
+        return ptr;
+    }
+    pool->misses++;
+#endif
+    return handle->sn_coap_protocol_malloc(mem_pool_object_size[type]);
+}
+
+void sn_coap_mem_pool_free(struct coap_s *handle, coap_mem_pool_type_e type, void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+#if SN_COAP_MEM_POOL_SIZE
+    coap_mem_pool_s *pool = &handle->mem_pools[type];
+    if (pool->count < handle->sn_coap_mem_pool_size) {
+        *(void **)ptr = pool->free_list;
+        pool->free_list = ptr;
+        pool->count++;
+        return;
+    }
+#endif
+    handle->sn_coap_protocol_free(ptr);
+}
+
+int8_t sn_coap_protocol_set_mem_pool_size(struct coap_s *handle, uint8_t pool_size)
+{
+    (void) handle;
+    (void) pool_size;
+#if SN_COAP_MEM_POOL_SIZE
+    if (handle == NULL) {
+        return -1;
+    }
+    handle->sn_coap_mem_pool_size = pool_size;
+    for (int i = 0; i < COAP_MEM_POOL_TYPE_COUNT; i++) {
+        coap_mem_pool_s *pool = &handle->mem_pools[i];
+        while (pool->count > pool_size) {
+            void *ptr = pool->free_list;
+            pool->free_list = *(void **)ptr;
+            pool->count--;
+            handle->sn_coap_protocol_free(ptr);
+        }
+    }
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+int8_t sn_coap_protocol_get_mem_pool_stats(struct coap_s *handle, sn_coap_mem_stats_s *stats_ptr)
+{
+    (void) handle;
+    (void) stats_ptr;
+#if SN_COAP_MEM_POOL_SIZE
+    if (handle == NULL || stats_ptr == NULL) {
+        return -1;
+    }
+    sn_coap_mem_pool_stats_s *dst[COAP_MEM_POOL_TYPE_COUNT] = {
+        &stats_ptr->headers, &stats_ptr->options, &stats_ptr->send_msgs
+    };
+    for (int i = 0; i < COAP_MEM_POOL_TYPE_COUNT; i++) {
+        dst[i]->hits = handle->mem_pools[i].hits;
+        dst[i]->misses = handle->mem_pools[i].misses;
+        dst[i]->cached = handle->mem_pools[i].count;
+    }
+    return 0;
+#else
+    return -1;
+#endif
+}
+
 int8_t sn_coap_protocol_set_retransmission_parameters(struct coap_s *handle,
         uint8_t resending_count, uint8_t resending_intervall)
 {
@@ -334,9 +444,8 @@ void sn_coap_protocol_clear_retransmission_buffer(struct coap_s *handle)
         return;
     }
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        ns_list_remove(&handle->linked_list_resent_msgs, tmp);
+        sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
         sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-        --handle->count_resent_msgs;
     }
 #endif
 }
@@ -352,8 +461,7 @@ int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t ms
             uint16_t temp_msg_id = (tmp->send_msg_ptr->packet_ptr[2] << 8);
             temp_msg_id += (uint16_t)tmp->send_msg_ptr->packet_ptr[3];
             if(temp_msg_id == msg_id){
-                ns_list_remove(&handle->linked_list_resent_msgs, tmp);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
                 return 0;
             }
@@ -583,7 +691,8 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
     }
 
     /* * * * Parse Packet data to CoAP message by using CoAP Header parser * * * */
-    returned_dst_coap_msg_ptr = sn_coap_parser(handle, packet_data_len, packet_data_ptr, &coap_version);
+    /* Options refer to the packet, they are copied only if the message is stored beyond its lifetime */
+    returned_dst_coap_msg_ptr = sn_coap_parser_zero_copy(handle, packet_data_len, packet_data_ptr, &coap_version);
 
     /* Check status of returned pointer */
     if (returned_dst_coap_msg_ptr == NULL) {
@@ -636,7 +745,6 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
         }
     }
 
-
 #if !SN_COAP_BLOCKWISE_ENABLED && !SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is enabled, this part of code will not be compiled */
     /* If blockwising used in received message */
     if (returned_dst_coap_msg_ptr->options_list_ptr != NULL &&
@@ -672,10 +780,7 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
                 coap_duplication_info_s *stored_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs);
 
                 /* Remove oldest stored duplication message for getting room for new duplication message */
-                sn_coap_protocol_linked_list_duplication_info_remove(handle,
-                                                                     stored_duplication_info_ptr->address->addr_ptr,
-                                                                     stored_duplication_info_ptr->address->port,
-                                                                     stored_duplication_info_ptr->msg_id);
+                sn_coap_protocol_linked_list_duplication_info_remove(handle, stored_duplication_info_ptr);
             }
 
             /* Store Duplication info to Linked list */
@@ -708,6 +813,12 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
     if (returned_dst_coap_msg_ptr->options_list_ptr != NULL &&
             (returned_dst_coap_msg_ptr->options_list_ptr->block1 != COAP_OPTION_BLOCK_NONE ||
              returned_dst_coap_msg_ptr->options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE)) {
+        /* Blockwise handling may store the message beyond the lifetime of the packet */
+        if (sn_coap_parser_detach_from_packet(handle, returned_dst_coap_msg_ptr) != 0) {
+            tr_error("sn_coap_protocol_parse - failed to detach message from packet!");
+            sn_coap_parser_release_allocated_coap_msg_mem(handle, returned_dst_coap_msg_ptr);
+            return NULL;
+        }
         returned_dst_coap_msg_ptr = sn_coap_handle_blockwise_message(handle, src_addr_ptr, returned_dst_coap_msg_ptr, param);
     } else {
         /* Get ... */
@@ -766,15 +877,8 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
 
         /* Check if there is ongoing active message resendings */
         if (stored_resending_msgs_count > 0) {
-            sn_nsdl_transmit_s *removed_msg_ptr = NULL;
-
-            /* Check if received message was confirmation for some active resending message */
-            removed_msg_ptr = sn_coap_protocol_linked_list_send_msg_search(handle, src_addr_ptr, returned_dst_coap_msg_ptr->msg_id);
-
-            if (removed_msg_ptr != NULL) {
-                /* Remove resending message from active message resending Linked list */
-                sn_coap_protocol_linked_list_send_msg_remove(handle, src_addr_ptr, returned_dst_coap_msg_ptr->msg_id);
-            }
+            /* If received message was confirmation for some active resending message, remove it from active message resending Linked list */
+            sn_coap_protocol_linked_list_send_msg_remove(handle, src_addr_ptr, returned_dst_coap_msg_ptr->msg_id);
         }
     }
 #endif /* ENABLE_RESENDINGS */
@@ -804,59 +908,50 @@ int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time)
 #endif
 
 #if ENABLE_RESENDINGS
-    /* Check if there is ongoing active message sendings */
-    /* foreach_safe isn't sufficient because callback routine could cancel messages. */
-rescan:
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        // First check that msg belongs to handle
-        if( stored_msg_ptr->coap == handle ){
-            /* Check if it is time to send this message */
-            if (current_time >= stored_msg_ptr->resending_time) {
-                /* * * Increase Resending counter  * * */
-                stored_msg_ptr->resending_counter++;
-
-                /* Check if all re-sendings have been done */
-                if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
-                    coap_version_e coap_version = COAP_VERSION_UNKNOWN;
-
-                    /* Get message ID from stored sending message */
-                    uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-                    temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
-                    /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
-
-                    /* If RX callback have been defined.. */
-                    if (stored_msg_ptr->coap->sn_coap_rx_callback != 0) {
-                        sn_coap_hdr_s *tmp_coap_hdr_ptr;
-                        /* Parse CoAP message, set status and call RX callback */
-                        tmp_coap_hdr_ptr = sn_coap_parser(stored_msg_ptr->coap, stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->packet_ptr, &coap_version);
-
-                        if (tmp_coap_hdr_ptr != 0) {
-                            tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
-                            stored_msg_ptr->coap->sn_coap_rx_callback(tmp_coap_hdr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
-
-                            sn_coap_parser_release_allocated_coap_msg_mem(stored_msg_ptr->coap, tmp_coap_hdr_ptr);
-                        }
-                    }
-
-                    /* Free memory of stored message */
-                    sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
-                } else {
-                    /* Send message  */
-                    stored_msg_ptr->coap->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr->packet_ptr,
-                            stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
-
-                    /* * * Count new Resending time  * * */
-                    stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
-                                                                                       handle->sn_coap_resending_intervall,
-                                                                                       stored_msg_ptr->resending_counter);
+    /* Resending list is ordered by resending time, so only the messages which are due are visited. */
+    /* The head is re-read on every round because callback routine could cancel messages. */
+    coap_send_msg_s *stored_msg_ptr;
+    while ((stored_msg_ptr = ns_list_get_first(&handle->linked_list_resent_msgs)) != NULL &&
+           current_time >= stored_msg_ptr->resending_time) {
+        /* * * Increase Resending counter  * * */
+        stored_msg_ptr->resending_counter++;
+
+        /* Check if all re-sendings have been done */
+        if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
+            coap_version_e coap_version = COAP_VERSION_UNKNOWN;
+
+            /* Remove message from Linked list */
+            sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
+
+            /* If RX callback have been defined.. */
+            if (stored_msg_ptr->coap->sn_coap_rx_callback != 0) {
+                sn_coap_hdr_s *tmp_coap_hdr_ptr;
+                /* Parse CoAP message, set status and call RX callback */
+                tmp_coap_hdr_ptr = sn_coap_parser(stored_msg_ptr->coap, stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->packet_ptr, &coap_version);
+
+                if (tmp_coap_hdr_ptr != 0) {
+                    tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
+                    stored_msg_ptr->coap->sn_coap_rx_callback(tmp_coap_hdr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
+
+                    sn_coap_parser_release_allocated_coap_msg_mem(stored_msg_ptr->coap, tmp_coap_hdr_ptr);
                 }
-                /* Callback routine could have wiped the list (eg as a response to sending failed) */
-                /* Be super cautious and rescan from the start */
-                goto rescan;
             }
+
+            /* Free memory of stored message */
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+        } else {
+            /* Send message  */
+            stored_msg_ptr->coap->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr->packet_ptr,
+                    stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
+
+            /* * * Count new Resending time  * * */
+            stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
+                                                                               handle->sn_coap_resending_intervall,
+                                                                               stored_msg_ptr->resending_counter);
+
+            /* Move message to its new place in the resending order */
+            ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+            sn_coap_protocol_linked_list_send_msg_schedule(handle, stored_msg_ptr);
         }
     }
 
@@ -865,6 +960,68 @@ rescan:
     return 0;
 }
 
+int8_t sn_coap_protocol_get_next_deadline(struct coap_s *handle, uint32_t *deadline_ptr)
+{
+    bool pending = false;
+    uint32_t deadline = 0;
+
+    if (handle == NULL || deadline_ptr == NULL) {
+        return -1;
+    }
+
+#if ENABLE_RESENDINGS
+    coap_send_msg_s *stored_msg_ptr = ns_list_get_first(&handle->linked_list_resent_msgs);
+    if (stored_msg_ptr) {
+        deadline = stored_msg_ptr->resending_time;
+        pending = true;
+    }
+#endif
+
+#if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+    /* Oldest info is the first one to expire */
+    coap_duplication_info_s *stored_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs);
+    if (stored_duplication_info_ptr) {
+        uint32_t expiry = stored_duplication_info_ptr->timestamp + SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED + 1;
+        if (!pending || expiry < deadline) {
+            deadline = expiry;
+        }
+        pending = true;
+    }
+#endif
+
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    /* Blockwise timestamps are refreshed in place, so these lists are not ordered */
+    ns_list_foreach(coap_blockwise_msg_s, stored_blockwise_msg_ptr, &handle->linked_list_blockwise_sent_msgs) {
+        uint32_t expiry = stored_blockwise_msg_ptr->timestamp + SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED + 1;
+        if (!pending || expiry < deadline) {
+            deadline = expiry;
+        }
+        pending = true;
+    }
+    ns_list_foreach(coap_blockwise_payload_s, stored_blockwise_payload_ptr, &handle->linked_list_blockwise_received_payloads) {
+        uint32_t expiry = stored_blockwise_payload_ptr->timestamp + SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED + 1;
+        if (!pending || expiry < deadline) {
+            deadline = expiry;
+        }
+        pending = true;
+    }
+    ns_list_foreach(coap_blockwise_reassembly_s, stored_reassembly_ptr, &handle->linked_list_blockwise_reassemblies) {
+        uint32_t expiry = stored_reassembly_ptr->timestamp + SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED + 1;
+        if (!pending || expiry < deadline) {
+            deadline = expiry;
+        }
+        pending = true;
+    }
+#endif
+
+    if (!pending) {
+        return -1;
+    }
+
+    *deadline_ptr = deadline;
+    return 0;
+}
+
 #if ENABLE_RESENDINGS  /* If Message resending is not used at all, this part of code will not be compiled */
 
 /**************************************************************************//**
@@ -937,87 +1094,113 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
     stored_msg_ptr->coap = handle;
     stored_msg_ptr->param = param;
 
+    if (!sn_coap_protocol_msg_index_add(handle->resent_msgs_index,
+                                        sn_coap_protocol_msg_index_hash(dst_addr_ptr->port, sn_coap_protocol_send_msg_id(stored_msg_ptr)),
+                                        stored_msg_ptr)) {
+        tr_error("sn_coap_protocol_linked_list_send_msg_store - resend index full!");
+        sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+        return 0;
+    }
+
     /* Storing Resending message to Linked list */
-    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    sn_coap_protocol_linked_list_send_msg_schedule(handle, stored_msg_ptr);
     ++handle->count_resent_msgs;
     return 1;
 }
 
 /**************************************************************************//**
- * \fn static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
+ * \fn static void sn_coap_protocol_linked_list_send_msg_remove(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
  *
- * \brief Searches stored resending message from Linked list
+ * \brief Removes stored resending message from Linked list
  *
  * \param *src_addr_ptr is searching key for searched message
+ * \param msg_id is searching key for removed message
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
+{
+    coap_send_msg_s *stored_msg_ptr = sn_coap_protocol_linked_list_send_msg_find(handle, src_addr_ptr, msg_id);
+
+    if (stored_msg_ptr) {
+        /* Remove message from Linked list */
+        sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
+
+        /* Free memory of stored message */
+        sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+    }
+}
+
+/**************************************************************************//**
+ * \fn static coap_send_msg_s *sn_coap_protocol_linked_list_send_msg_find(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
  *
- * \param msg_id is searching key for searched message
+ * \brief Looks up stored resending message from the index (Address, port and Message ID as key)
  *
- * \return Return value is pointer to found stored resending message in Linked
- *         list or NULL if message not found
+ * \return Return value is pointer to found stored resending message or NULL if message not found
  *****************************************************************************/
 
-static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,
-        sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
+static coap_send_msg_s *sn_coap_protocol_linked_list_send_msg_find(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
-        /* If message's Message ID is same than is searched */
-        if (temp_msg_id == msg_id) {
-            /* If message's Source address is same than is searched */
-            if (0 == memcmp(src_addr_ptr->addr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr->addr_ptr, src_addr_ptr->addr_len)) {
-                /* If message's Source address port is same than is searched */
-                if (stored_msg_ptr->send_msg_ptr->dst_addr_ptr->port == src_addr_ptr->port) {
-                    /* * * Message found, return pointer to that stored resending message * * * */
-                    return stored_msg_ptr->send_msg_ptr;
-                }
+    const uint16_t hash = sn_coap_protocol_msg_index_hash(src_addr_ptr->port, msg_id);
+    uint16_t slot = hash & (SN_COAP_MSG_INDEX_SIZE - 1);
+
+    while (handle->resent_msgs_index[slot].msg_ptr) {
+        if (handle->resent_msgs_index[slot].hash == hash) {
+            coap_send_msg_s *stored_msg_ptr = handle->resent_msgs_index[slot].msg_ptr;
+            sn_nsdl_addr_s *stored_addr_ptr = stored_msg_ptr->send_msg_ptr->dst_addr_ptr;
+
+            if (sn_coap_protocol_send_msg_id(stored_msg_ptr) == msg_id &&
+                stored_addr_ptr->port == src_addr_ptr->port &&
+                0 == memcmp(src_addr_ptr->addr_ptr, stored_addr_ptr->addr_ptr, src_addr_ptr->addr_len)) {
+                return stored_msg_ptr;
             }
         }
+        slot = (slot + 1) & (SN_COAP_MSG_INDEX_SIZE - 1);
     }
 
     /* Message not found */
     return NULL;
 }
+
 /**************************************************************************//**
- * \fn static void sn_coap_protocol_linked_list_send_msg_remove(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
+ * \fn static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
  *
- * \brief Removes stored resending message from Linked list
+ * \brief Removes stored resending message from Linked list and index without freeing it
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    sn_coap_protocol_msg_index_remove(handle->resent_msgs_index,
+                                      sn_coap_protocol_msg_index_hash(stored_msg_ptr->send_msg_ptr->dst_addr_ptr->port,
+                                                                      sn_coap_protocol_send_msg_id(stored_msg_ptr)),
+                                      stored_msg_ptr);
+    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    --handle->count_resent_msgs;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_schedule(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
  *
- * \param *src_addr_ptr is searching key for searched message
- * \param msg_id is searching key for removed message
+ * \brief Inserts resending message to Linked list, which is kept ordered by resending time.
+ *        Messages with equal time keep their insertion order.
  *****************************************************************************/
 
-static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
+static void sn_coap_protocol_linked_list_send_msg_schedule(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
 {
-    /* Loop all stored resending messages in Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
-        /* If message's Message ID is same than is searched */
-        if (temp_msg_id == msg_id) {
-            /* If message's Source address is same than is searched */
-            if (0 == memcmp(src_addr_ptr->addr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr->addr_ptr, src_addr_ptr->addr_len)) {
-                /* If message's Source address port is same than is searched */
-                if (stored_msg_ptr->send_msg_ptr->dst_addr_ptr->port == src_addr_ptr->port) {
-                    /* * * Message found * * */
-
-                    /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
-
-                    /* Free memory of stored message */
-                    sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
-
-                    return;
-                }
-            }
+    ns_list_foreach(coap_send_msg_s, next_msg_ptr, &handle->linked_list_resent_msgs) {
+        if (next_msg_ptr->resending_time > stored_msg_ptr->resending_time) {
+            ns_list_add_before(&handle->linked_list_resent_msgs, next_msg_ptr, stored_msg_ptr);
+            return;
         }
     }
+    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
+}
+
+static uint16_t sn_coap_protocol_send_msg_id(const coap_send_msg_s *stored_msg_ptr)
+{
+    /* Get message ID from stored resending message */
+    uint16_t msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
+    msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
+    return msg_id;
 }
 
 uint32_t sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter)
@@ -1029,6 +1212,84 @@ uint32_t sn_coap_calculate_new_resend_time(const uint32_t current_time, const ui
 
 #endif /* ENABLE_RESENDINGS */
 
+#if ENABLE_RESENDINGS || SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+
+/**************************************************************************//**
+ * \fn static uint16_t sn_coap_protocol_msg_index_hash(uint16_t port, uint16_t msg_id)
+ *
+ * \brief Hash of a stored message key. Address is left out as messages are
+ *        nearly always exchanged with one peer, it is compared on lookup.
+ *****************************************************************************/
+
+static uint16_t sn_coap_protocol_msg_index_hash(uint16_t port, uint16_t msg_id)
+{
+    uint32_t key = ((uint32_t)port << 16) | msg_id;
+    return (uint16_t)((key * 2654435761u) >> 16);
+}
+
+/**************************************************************************//**
+ * \fn static bool sn_coap_protocol_msg_index_add(coap_msg_index_entry_s *index, uint16_t hash, void *msg_ptr)
+ *
+ * \brief Adds message to the index using linear probing
+ *
+ * \return true if added, false if the index is full
+ *****************************************************************************/
+
+static bool sn_coap_protocol_msg_index_add(coap_msg_index_entry_s *index, uint16_t hash, void *msg_ptr)
+{
+    uint16_t slot = hash & (SN_COAP_MSG_INDEX_SIZE - 1);
+    uint16_t probes = 0;
+
+    /* Leave at least one slot free so that lookups always terminate */
+    while (index[slot].msg_ptr) {
+        if (++probes >= SN_COAP_MSG_INDEX_SIZE - 1) {
+            return false;
+        }
+        slot = (slot + 1) & (SN_COAP_MSG_INDEX_SIZE - 1);
+    }
+
+    index[slot].msg_ptr = msg_ptr;
+    index[slot].hash = hash;
+    return true;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_msg_index_remove(coap_msg_index_entry_s *index, uint16_t hash, const void *msg_ptr)
+ *
+ * \brief Removes message from the index, following entries are shifted back
+ *        to keep their probe sequences unbroken
+ *****************************************************************************/
+
+static void sn_coap_protocol_msg_index_remove(coap_msg_index_entry_s *index, uint16_t hash, const void *msg_ptr)
+{
+    const uint16_t mask = SN_COAP_MSG_INDEX_SIZE - 1;
+    uint16_t hole = hash & mask;
+
+    while (index[hole].msg_ptr != msg_ptr) {
+        if (!index[hole].msg_ptr) {
+            return;
+        }
+        hole = (hole + 1) & mask;
+    }
+
+    uint16_t next = hole;
+    for (;;) {
+        next = (next + 1) & mask;
+        if (!index[next].msg_ptr) {
+            break;
+        }
+        uint16_t home = index[next].hash & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            index[hole] = index[next];
+            hole = next;
+        }
+    }
+    index[hole].msg_ptr = NULL;
+    index[hole].hash = 0;
+}
+
+#endif /* ENABLE_RESENDINGS || SN_COAP_DUPLICATION_MAX_MSGS_COUNT */
+
 void sn_coap_protocol_send_rst(struct coap_s *handle, uint16_t msg_id, sn_nsdl_addr_s *addr_ptr, void *param)
 {
     uint8_t packet_ptr[4];
@@ -1112,6 +1373,17 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
     stored_duplication_info_ptr->coap = handle;
 
     stored_duplication_info_ptr->param = param;
+
+    if (!sn_coap_protocol_msg_index_add(handle->duplication_msgs_index,
+                                        sn_coap_protocol_msg_index_hash(addr_ptr->port, msg_id),
+                                        stored_duplication_info_ptr)) {
+        tr_error("sn_coap_protocol_linked_list_duplication_info_store - duplication index full!");
+        handle->sn_coap_protocol_free(stored_duplication_info_ptr->address->addr_ptr);
+        handle->sn_coap_protocol_free(stored_duplication_info_ptr->address);
+        handle->sn_coap_protocol_free(stored_duplication_info_ptr);
+        return;
+    }
+
     /* * * * Storing Duplication info to Linked list * * * */
 
     ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
@@ -1132,92 +1404,71 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_search(struct coap_s *handle,
         sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
 {
-    /* Loop all nodes in Linked list for searching Message ID */
-    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        /* If message's Message ID is same than is searched */
-        if (stored_duplication_info_ptr->msg_id == msg_id) {
-            /* If message's Source address is same than is searched */
-            if (0 == memcmp(addr_ptr->addr_ptr, stored_duplication_info_ptr->address->addr_ptr, addr_ptr->addr_len)) {
-                /* If message's Source address port is same than is searched */
-                if (stored_duplication_info_ptr->address->port == addr_ptr->port) {
-                    /* * * Correct Duplication info found * * * */
-                    return stored_duplication_info_ptr;
-                }
+    const uint16_t hash = sn_coap_protocol_msg_index_hash(addr_ptr->port, msg_id);
+    uint16_t slot = hash & (SN_COAP_MSG_INDEX_SIZE - 1);
+
+    while (handle->duplication_msgs_index[slot].msg_ptr) {
+        if (handle->duplication_msgs_index[slot].hash == hash) {
+            coap_duplication_info_s *stored_duplication_info_ptr = handle->duplication_msgs_index[slot].msg_ptr;
+
+            if (stored_duplication_info_ptr->msg_id == msg_id &&
+                stored_duplication_info_ptr->address->port == addr_ptr->port &&
+                0 == memcmp(addr_ptr->addr_ptr, stored_duplication_info_ptr->address->addr_ptr, addr_ptr->addr_len)) {
+                /* * * Correct Duplication info found * * * */
+                return stored_duplication_info_ptr;
             }
         }
+        slot = (slot + 1) & (SN_COAP_MSG_INDEX_SIZE - 1);
     }
     return NULL;
 }
 
 /**************************************************************************//**
- * \fn static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *addr_ptr, uint16_t port, uint16_t msg_id)
- *
- * \brief Removes stored Duplication info from Linked list
- *
- * \param *addr_ptr is pointer to Address key to be removed
+ * \fn static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
  *
- * \param port is Port key to be removed
+ * \brief Removes stored Duplication info from Linked list and index and frees it
  *
- * \param msg_id is Message ID key to be removed
+ * \param *removed_duplication_info_ptr is the Duplication info to be removed
  *****************************************************************************/
 
-static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *addr_ptr, uint16_t port, uint16_t msg_id)
+static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
 {
-    /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        /* If message's Address is same than is searched */
-        if (handle == removed_duplication_info_ptr->coap && 0 == memcmp(addr_ptr,
-                                                                        removed_duplication_info_ptr->address->addr_ptr,
-                                                                        removed_duplication_info_ptr->address->addr_len)) {
-            /* If message's Address prt is same than is searched */
-            if (removed_duplication_info_ptr->address->port == port) {
-                /* If Message ID is same than is searched */
-                if (removed_duplication_info_ptr->msg_id == msg_id) {
-                    /* * * * Correct Duplication info found, remove it from Linked list * * * */
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
-
-                    /* Free memory of stored Duplication info */
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
-                    removed_duplication_info_ptr->address->addr_ptr = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
-                    removed_duplication_info_ptr->address = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
-                    removed_duplication_info_ptr->packet_ptr = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-                    removed_duplication_info_ptr = 0;
-                    return;
-                }
-            }
-        }
-    }
+    sn_coap_protocol_msg_index_remove(handle->duplication_msgs_index,
+                                      sn_coap_protocol_msg_index_hash(removed_duplication_info_ptr->address->port,
+                                                                      removed_duplication_info_ptr->msg_id),
+                                      removed_duplication_info_ptr);
+    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
+    --handle->count_duplication_msgs;
+
+    /* Free memory of stored Duplication info */
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
+    removed_duplication_info_ptr->address->addr_ptr = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
+    removed_duplication_info_ptr->address = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
+    removed_duplication_info_ptr->packet_ptr = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
 }
 
 /**************************************************************************//**
  * \fn static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle)
  *
  * \brief Removes old stored Duplication detection infos from Linked list
+ *
+ *        Infos are appended in arrival order, so the list is ordered by age
+ *        and the scan stops at the first info which has not expired.
  *****************************************************************************/
 
 static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle)
 {
-    /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach_safe(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
-            /* * * * Old Duplication info found, remove it from Linked list * * * */
-            ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-            --handle->count_duplication_msgs;
-
-            /* Free memory of stored Duplication info */
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
-            removed_duplication_info_ptr->address->addr_ptr = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->address);
-            removed_duplication_info_ptr->address = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->packet_ptr);
-            removed_duplication_info_ptr->packet_ptr = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-            removed_duplication_info_ptr = 0;
+    coap_duplication_info_s *removed_duplication_info_ptr;
+
+    while ((removed_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs)) != NULL) {
+        if ((handle->system_time - removed_duplication_info_ptr->timestamp) <= SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
+            break;
         }
+        /* * * * Old Duplication info found, remove it from Linked list * * * */
+        sn_coap_protocol_linked_list_duplication_info_remove(handle, removed_duplication_info_ptr);
     }
 }
 
@@ -1558,6 +1809,171 @@ static void sn_coap_protocol_handle_blockwise_timout(struct coap_s *handle)
             sn_coap_protocol_linked_list_blockwise_payload_remove(handle, removed_blocwise_payload_ptr);
         }
     }
+
+    /* Loop all incoming Blockwise payloads received in place */
+    ns_list_foreach_safe(coap_blockwise_reassembly_s, removed_reassembly_ptr, &handle->linked_list_blockwise_reassemblies) {
+        if ((handle->system_time - removed_reassembly_ptr->timestamp)  > SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED) {
+            sn_coap_protocol_blockwise_reassembly_remove(handle, removed_reassembly_ptr);
+        }
+    }
+}
+
+/**************************************************************************//**
+ * \fn static coap_blockwise_reassembly_s *sn_coap_protocol_blockwise_reassembly_get(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr,
+ *                                                                                  sn_coap_hdr_s *received_coap_msg_ptr, bool block1,
+ *                                                                                  int32_t block_option, uint32_t size)
+ *
+ * \brief Searches in place reassembly of the received block (Address and token as key),
+ *        or creates one if the block carries the size of the whole payload.
+ *
+ * \param *src_addr_ptr is pointer to source Address of the block
+ * \param *received_coap_msg_ptr is pointer to received block
+ * \param block1 true if block is part of a request, false if it is part of a response
+ * \param block_option is Block1 or Block2 option of the block
+ * \param size is Size1 or Size2 option of the block, 0 if not present
+ *
+ * \return Return value is pointer to reassembly or NULL if block must be handled by the Linked list of blocks
+ *****************************************************************************/
+
+static coap_blockwise_reassembly_s *sn_coap_protocol_blockwise_reassembly_get(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr,
+                                                                              sn_coap_hdr_s *received_coap_msg_ptr, bool block1,
+                                                                              int32_t block_option, uint32_t size)
+{
+    uint16_t block_size = 1u << ((block_option & 0x07) + 4);
+
+    ns_list_foreach(coap_blockwise_reassembly_s, reassembly_ptr, &handle->linked_list_blockwise_reassemblies) {
+        if (reassembly_ptr->block1 != block1 ||
+            reassembly_ptr->port != src_addr_ptr->port ||
+            reassembly_ptr->addr_len != src_addr_ptr->addr_len ||
+            memcmp(reassembly_ptr->addr_ptr, src_addr_ptr->addr_ptr, src_addr_ptr->addr_len) ||
+            reassembly_ptr->token_len != received_coap_msg_ptr->token_len ||
+            memcmp(reassembly_ptr->token_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len)) {
+            continue;
+        }
+
+        if (reassembly_ptr->block_size == block_size) {
+            return reassembly_ptr;
+        }
+
+        /* Peer changed block size, bitmap is no longer valid */
+        tr_warn("sn_coap_protocol_blockwise_reassembly_get - block size changed, restarting");
+        sn_coap_protocol_blockwise_reassembly_remove(handle, reassembly_ptr);
+        break;
+    }
+
+    if (size == 0 || size > SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE || size > UINT16_MAX ||
+        block_size > handle->sn_coap_block_data_size) {
+        return NULL;
+    }
+
+    /* Allocate structure, bitmap, address and token at once, payload separately as its ownership is passed to application */
+    uint16_t bitmap_len = ((size + block_size - 1) / block_size + 7) / 8;
+    coap_blockwise_reassembly_s *reassembly_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_blockwise_reassembly_s) + bitmap_len +
+                                                                                  src_addr_ptr->addr_len + received_coap_msg_ptr->token_len);
+    if (!reassembly_ptr) {
+        tr_error("sn_coap_protocol_blockwise_reassembly_get - failed to allocate reassembly!");
+        return NULL;
+    }
+
+    reassembly_ptr->payload_ptr = handle->sn_coap_protocol_malloc(size);
+    if (!reassembly_ptr->payload_ptr) {
+        tr_error("sn_coap_protocol_blockwise_reassembly_get - failed to allocate payload!");
+        handle->sn_coap_protocol_free(reassembly_ptr);
+        return NULL;
+    }
+
+    reassembly_ptr->timestamp = handle->system_time;
+    reassembly_ptr->bitmap_ptr = (uint8_t *)(reassembly_ptr + 1);
+    memset(reassembly_ptr->bitmap_ptr, 0, bitmap_len);
+    reassembly_ptr->addr_len = src_addr_ptr->addr_len;
+    reassembly_ptr->addr_ptr = reassembly_ptr->bitmap_ptr + bitmap_len;
+    memcpy(reassembly_ptr->addr_ptr, src_addr_ptr->addr_ptr, src_addr_ptr->addr_len);
+    reassembly_ptr->port = src_addr_ptr->port;
+    reassembly_ptr->token_len = received_coap_msg_ptr->token_len;
+    reassembly_ptr->token_ptr = reassembly_ptr->addr_ptr + src_addr_ptr->addr_len;
+    if (received_coap_msg_ptr->token_len) {
+        memcpy(reassembly_ptr->token_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+    }
+    reassembly_ptr->block1 = block1;
+    reassembly_ptr->last_block_received = false;
+    reassembly_ptr->block_size = block_size;
+    reassembly_ptr->allocated_len = size;
+    reassembly_ptr->payload_len = 0;
+    reassembly_ptr->received_len = 0;
+
+    ns_list_add_to_end(&handle->linked_list_blockwise_reassemblies, reassembly_ptr);
+
+    return reassembly_ptr;
+}
+
+/**************************************************************************//**
+ * \fn static int8_t sn_coap_protocol_blockwise_reassembly_store(struct coap_s *handle, coap_blockwise_reassembly_s *reassembly_ptr,
+ *                                                              sn_coap_hdr_s *received_coap_msg_ptr, int32_t block_option)
+ *
+ * \brief Copies payload of the received block to its offset in the reassembly buffer.
+ *        Blocks already received are ignored.
+ *
+ * \param *received_coap_msg_ptr is pointer to received block
+ * \param block_option is Block1 or Block2 option of the block
+ *
+ * \return 1 if whole payload is received, 0 if blocks are still missing, -1 if block does not fit to the payload
+ *****************************************************************************/
+
+static int8_t sn_coap_protocol_blockwise_reassembly_store(struct coap_s *handle, coap_blockwise_reassembly_s *reassembly_ptr,
+                                                          sn_coap_hdr_s *received_coap_msg_ptr, int32_t block_option)
+{
+    uint32_t block_number = block_option >> 4;
+    uint32_t offset = block_number * reassembly_ptr->block_size;
+    uint32_t end = offset + received_coap_msg_ptr->payload_len;
+    bool last_block = !(block_option & 0x08);
+
+    /* Only the last block may be shorter than block size, and it must not move once known.
+     * Block number is checked separately as an empty block may start at the end of the buffer. */
+    if (end > reassembly_ptr->allocated_len ||
+        block_number >= (reassembly_ptr->allocated_len + reassembly_ptr->block_size - 1) / reassembly_ptr->block_size ||
+        (!last_block && received_coap_msg_ptr->payload_len != reassembly_ptr->block_size) ||
+        (reassembly_ptr->last_block_received && (last_block ? end != reassembly_ptr->payload_len : end > reassembly_ptr->payload_len))) {
+        tr_error("sn_coap_protocol_blockwise_reassembly_store - block %" PRIu32 " does not fit to payload!", block_number);
+        return -1;
+    }
+
+    if (!(reassembly_ptr->bitmap_ptr[block_number / 8] & (1u << (block_number % 8)))) {
+        reassembly_ptr->bitmap_ptr[block_number / 8] |= 1u << (block_number % 8);
+        if (received_coap_msg_ptr->payload_len) {
+            memcpy(reassembly_ptr->payload_ptr + offset, received_coap_msg_ptr->payload_ptr, received_coap_msg_ptr->payload_len);
+        }
+        reassembly_ptr->received_len += received_coap_msg_ptr->payload_len;
+    }
+
+    if (last_block) {
+        reassembly_ptr->last_block_received = true;
+        reassembly_ptr->payload_len = end;
+    }
+
+    /* Blocks beyond the last one have been received */
+    if (reassembly_ptr->last_block_received && reassembly_ptr->received_len > reassembly_ptr->payload_len) {
+        tr_error("sn_coap_protocol_blockwise_reassembly_store - blocks beyond last block received!");
+        return -1;
+    }
+
+    reassembly_ptr->timestamp = handle->system_time;
+
+    return (reassembly_ptr->last_block_received && reassembly_ptr->received_len == reassembly_ptr->payload_len) ? 1 : 0;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_blockwise_reassembly_remove(struct coap_s *handle, coap_blockwise_reassembly_s *removed_reassembly_ptr)
+ *
+ * \brief Removes reassembly from Linked list. Payload is freed unless it has been handed over.
+ *
+ * \param removed_reassembly_ptr is reassembly to be removed
+ *****************************************************************************/
+
+static void sn_coap_protocol_blockwise_reassembly_remove(struct coap_s *handle, coap_blockwise_reassembly_s *removed_reassembly_ptr)
+{
+    ns_list_remove(&handle->linked_list_blockwise_reassemblies, removed_reassembly_ptr);
+    handle->sn_coap_protocol_free(removed_reassembly_ptr->payload_ptr);
+    handle->sn_coap_protocol_free(removed_reassembly_ptr);
 }
 
 #endif /* SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE */
@@ -1579,7 +1995,7 @@ static void sn_coap_protocol_handle_blockwise_timout(struct coap_s *handle)
 coap_send_msg_s *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t packet_data_len)
 {
 
-    coap_send_msg_s *msg_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_send_msg_s));
+    coap_send_msg_s *msg_ptr = sn_coap_mem_pool_alloc(handle, COAP_MEM_POOL_SEND_MSG);
 
     if (msg_ptr == NULL) {
         return NULL;
@@ -1596,7 +2012,7 @@ coap_send_msg_s *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn
 
     m = handle->sn_coap_protocol_malloc(sizeof *m + trail_size);
     if (!m) {
-        handle->sn_coap_protocol_free(msg_ptr);
+        sn_coap_mem_pool_free(handle, COAP_MEM_POOL_SEND_MSG, msg_ptr);
         return NULL;
     }
     //Init data
@@ -1628,7 +2044,7 @@ static void sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handl
     if (freed_send_msg_ptr != NULL) {
         handle->sn_coap_protocol_free(freed_send_msg_ptr->send_msg_ptr);
         freed_send_msg_ptr->send_msg_ptr = NULL;
-        handle->sn_coap_protocol_free(freed_send_msg_ptr);
+        sn_coap_mem_pool_free(handle, COAP_MEM_POOL_SEND_MSG, freed_send_msg_ptr);
         freed_send_msg_ptr = NULL;
     }
 }
@@ -1864,30 +2280,56 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 received_coap_msg_ptr->payload_len = handle->sn_coap_block_data_size;
             }
 
-            // Check that incoming block number is in order.
             uint32_t block_number = received_coap_msg_ptr->options_list_ptr->block1 >> 4;
             bool blocks_in_order = true;
+            /* Block option length can be 1-3 bytes. First 4-20 bits are for block number. Last 4 bits are ALWAYS more bit + block size. */
+            bool more_blocks = received_coap_msg_ptr->options_list_ptr->block1 & 0x08;
+            coap_blockwise_reassembly_s *reassembly_ptr = NULL;
 
-            if (block_number > 0 &&
-                !sn_coap_protocol_linked_list_blockwise_payload_compare_block_number(handle,
-                                                                                     src_addr_ptr,
-                                                                                     received_coap_msg_ptr->token_ptr,
-                                                                                     received_coap_msg_ptr->token_len,
-                                                                                     block_number)) {
-                blocks_in_order = false;
+            if (handle->sn_coap_block_reassembly_in_place) {
+                reassembly_ptr = sn_coap_protocol_blockwise_reassembly_get(handle, src_addr_ptr, received_coap_msg_ptr, true,
+                                                                           received_coap_msg_ptr->options_list_ptr->block1,
+                                                                           received_coap_msg_ptr->options_list_ptr->use_size1 ? received_coap_msg_ptr->options_list_ptr->size1 : 0);
             }
 
-            sn_coap_protocol_linked_list_blockwise_payload_store(handle,
-                                                                 src_addr_ptr,
-                                                                 received_coap_msg_ptr->payload_len,
-                                                                 received_coap_msg_ptr->payload_ptr,
-                                                                 received_coap_msg_ptr->token_ptr,
-                                                                 received_coap_msg_ptr->token_len,
-                                                                 block_number);
+            if (reassembly_ptr) {
+                // Blocks are written to their offset, so they may arrive in any order.
+                int8_t reassembly_status = sn_coap_protocol_blockwise_reassembly_store(handle, reassembly_ptr, received_coap_msg_ptr,
+                                                                                       received_coap_msg_ptr->options_list_ptr->block1);
+                if (reassembly_status < 0) {
+                    sn_coap_protocol_blockwise_reassembly_remove(handle, reassembly_ptr);
+                    reassembly_ptr = NULL;
+                    blocks_in_order = false;
+                    more_blocks = true;
+                } else if (reassembly_status == 0 && !more_blocks) {
+                    // Last block arrived before some of the others, keep waiting for them
+                    blocks_in_order = false;
+                    more_blocks = true;
+                } else if (reassembly_status == 1) {
+                    more_blocks = false;
+                }
+            } else {
+                // Check that incoming block number is in order.
+                if (block_number > 0 &&
+                    !sn_coap_protocol_linked_list_blockwise_payload_compare_block_number(handle,
+                                                                                         src_addr_ptr,
+                                                                                         received_coap_msg_ptr->token_ptr,
+                                                                                         received_coap_msg_ptr->token_len,
+                                                                                         block_number)) {
+                    blocks_in_order = false;
+                }
+
+                sn_coap_protocol_linked_list_blockwise_payload_store(handle,
+                                                                     src_addr_ptr,
+                                                                     received_coap_msg_ptr->payload_len,
+                                                                     received_coap_msg_ptr->payload_ptr,
+                                                                     received_coap_msg_ptr->token_ptr,
+                                                                     received_coap_msg_ptr->token_len,
+                                                                     block_number);
+            }
 
             /* If not last block (more value is set) */
-            /* Block option length can be 1-3 bytes. First 4-20 bits are for block number. Last 4 bits are ALWAYS more bit + block size. */
-            if (received_coap_msg_ptr->options_list_ptr->block1 & 0x08) {
+            if (more_blocks) {
                 src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
                 if (src_coap_blockwise_ack_msg_ptr == NULL) {
                     tr_error("sn_coap_handle_blockwise_message - (recv block1) failed to allocate ack message!");
@@ -1974,6 +2416,14 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
                 received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
 
+            } else if (reassembly_ptr) {
+                /* * * Whole payload has been received in place, hand the buffer over without copying * * */
+                // In block message case, payload_ptr freeing must be done in application level
+                received_coap_msg_ptr->payload_ptr = reassembly_ptr->payload_ptr;
+                received_coap_msg_ptr->payload_len = reassembly_ptr->payload_len;
+                reassembly_ptr->payload_ptr = NULL;
+                sn_coap_protocol_blockwise_reassembly_remove(handle, reassembly_ptr);
+                received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
             } else {
                 /* * * This is the last block when whole Blockwise payload from received * * */
                 /* * * blockwise messages is gathered and returned to User               * * */
@@ -2016,16 +2466,34 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
         if (received_coap_msg_ptr->msg_code > COAP_MSG_CODE_REQUEST_DELETE) {
             if (handle->sn_coap_internal_block2_resp_handling) {
                 uint32_t block_number = 0;
+                coap_blockwise_reassembly_s *reassembly_ptr = NULL;
+                int8_t reassembly_status = 0;
 
-                /* Store blockwise payload to Linked list */
-                //todo: add block number to stored values - just to make sure all packets are in order
-                sn_coap_protocol_linked_list_blockwise_payload_store(handle,
-                                                                     src_addr_ptr,
-                                                                     received_coap_msg_ptr->payload_len,
-                                                                     received_coap_msg_ptr->payload_ptr,
-                                                                     received_coap_msg_ptr->token_ptr,
-                                                                     received_coap_msg_ptr->token_len,
-                                                                     received_coap_msg_ptr->options_list_ptr->block2 >> 4);
+                if (handle->sn_coap_block_reassembly_in_place) {
+                    reassembly_ptr = sn_coap_protocol_blockwise_reassembly_get(handle, src_addr_ptr, received_coap_msg_ptr, false,
+                                                                               received_coap_msg_ptr->options_list_ptr->block2,
+                                                                               received_coap_msg_ptr->options_list_ptr->use_size2 ? received_coap_msg_ptr->options_list_ptr->size2 : 0);
+                }
+
+                if (reassembly_ptr) {
+                    reassembly_status = sn_coap_protocol_blockwise_reassembly_store(handle, reassembly_ptr, received_coap_msg_ptr,
+                                                                                    received_coap_msg_ptr->options_list_ptr->block2);
+                    if (reassembly_status < 0) {
+                        sn_coap_protocol_blockwise_reassembly_remove(handle, reassembly_ptr);
+                        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
+                        return NULL;
+                    }
+                } else {
+                    /* Store blockwise payload to Linked list */
+                    //todo: add block number to stored values - just to make sure all packets are in order
+                    sn_coap_protocol_linked_list_blockwise_payload_store(handle,
+                                                                         src_addr_ptr,
+                                                                         received_coap_msg_ptr->payload_len,
+                                                                         received_coap_msg_ptr->payload_ptr,
+                                                                         received_coap_msg_ptr->token_ptr,
+                                                                         received_coap_msg_ptr->token_len,
+                                                                         received_coap_msg_ptr->options_list_ptr->block2 >> 4);
+                }
                 /* If not last block (more value is set) */
                 if (received_coap_msg_ptr->options_list_ptr->block2 & 0x08) {
                     coap_blockwise_msg_s *previous_blockwise_msg_ptr = NULL;
@@ -2171,6 +2639,22 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     dst_ack_packet_data_ptr = 0;
                 }
 
+                //Last block received, whole payload received in place
+                else if (reassembly_ptr) {
+                    if (reassembly_status != 1) {
+                        tr_error("sn_coap_handle_blockwise_message - (send block2) blocks missing from payload!");
+                        sn_coap_protocol_blockwise_reassembly_remove(handle, reassembly_ptr);
+                        sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
+                        return NULL;
+                    }
+
+                    received_coap_msg_ptr->payload_ptr = reassembly_ptr->payload_ptr;
+                    received_coap_msg_ptr->payload_len = reassembly_ptr->payload_len;
+                    reassembly_ptr->payload_ptr = NULL;
+                    sn_coap_protocol_blockwise_reassembly_remove(handle, reassembly_ptr);
+                    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
+                }
+
                 //Last block received
                 else {
                     /* * * This is the last block when whole Blockwise payload from received * * */
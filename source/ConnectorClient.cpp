@@ -132,6 +132,16 @@ static bool write_security_object_data_to_kcm(const M2MResourceBase& resource, c
             }
             break;
 
+        case M2MSecurity::TLSSession:
+            if (object_instance_id == M2MSecurity::Bootstrap) {
+                ccs_delete_item(KEY_BOOTSTRAP_TLS_SESSION, CCS_CONFIG_ITEM);
+                status = ccs_set_item(KEY_BOOTSTRAP_TLS_SESSION, buffer, buffer_size, CCS_CONFIG_ITEM);
+            } else {
+                ccs_delete_item(KEY_LWM2M_TLS_SESSION, CCS_CONFIG_ITEM);
+                status = ccs_set_item(KEY_LWM2M_TLS_SESSION, buffer, buffer_size, CCS_CONFIG_ITEM);
+            }
+            break;
+
         default:
             break;
     }
@@ -165,6 +175,14 @@ static int read_security_object_data_from_kcm(const M2MResourceBase& resource, v
                 return read_callback_helper(g_fcc_lwm2m_device_private_key_name, buffer, buffer_len);
             }
 
+        case M2MSecurity::TLSSession:
+            // No stored session is not an error, the handshake just negotiates a new one
+            if (ccs_get_item((object_instance_id == M2MSecurity::Bootstrap) ? KEY_BOOTSTRAP_TLS_SESSION : KEY_LWM2M_TLS_SESSION,
+                             (uint8_t*)buffer, *buffer_len, buffer_len, CCS_CONFIG_ITEM) != CCS_STATUS_SUCCESS) {
+                *buffer_len = 0;
+            }
+            return CCS_STATUS_SUCCESS;
+
         default:
             break;
     }
@@ -860,6 +878,7 @@ void ConnectorClient::bootstrap_data_ready(M2MSecurity *security_object)
             ccs_delete_item(g_fcc_lwm2m_server_ca_certificate_name, CCS_CERTIFICATE_ITEM);
             ccs_delete_item(g_fcc_lwm2m_device_certificate_name, CCS_CERTIFICATE_ITEM);
             ccs_delete_item(g_fcc_lwm2m_device_private_key_name, CCS_PRIVATE_KEY_ITEM);
+            ccs_delete_item(KEY_LWM2M_TLS_SESSION, CCS_CONFIG_ITEM);
             // Start re-bootstrap timer
             tr_info("ConnectorClient::bootstrap_data_ready() - Re-directing bootstrap in 100 milliseconds");
             _rebootstrap_timer.start_timer(100, M2MTimerObserver::BootstrapFlowTimer, true);
@@ -930,6 +949,7 @@ void ConnectorClient::error(M2MInterface::Error error)
         ccs_delete_item(g_fcc_lwm2m_server_ca_certificate_name, CCS_CERTIFICATE_ITEM);
         ccs_delete_item(g_fcc_lwm2m_device_certificate_name, CCS_CERTIFICATE_ITEM);
         ccs_delete_item(g_fcc_lwm2m_device_private_key_name, CCS_PRIVATE_KEY_ITEM);
+        ccs_delete_item(KEY_LWM2M_TLS_SESSION, CCS_CONFIG_ITEM);
         // Delete the lwm2m security instance
         int32_t id = _security->get_security_instance_id(M2MSecurity::M2MServer);
         if (id >= 0) {
@@ -1009,6 +1029,9 @@ ccs_status_e ConnectorClient::set_connector_credentials(M2MSecurity *security)
         return status;
     }
 
+    // Session of the previous credentials can not be resumed
+    ccs_delete_item(KEY_LWM2M_TLS_SESSION, CCS_CONFIG_ITEM);
+
     size_t buffer_size = MAX_CERTIFICATE_SIZE;
     uint8_t public_key[MAX_CERTIFICATE_SIZE];
     uint8_t *public_key_ptr = (uint8_t*)&public_key;
@@ -1334,6 +1357,12 @@ void ConnectorClient::init_security_object()
                 if (res) {
                     res->set_resource_read_callback(close_certificate_chain_callback, this);
                 }
+
+                res = _security->get_resource(M2MSecurity::TLSSession, i);
+                if (res) {
+                    res->set_resource_read_callback(read_security_object_data_from_kcm, this);
+                    res->set_resource_write_callback(write_security_object_data_to_kcm, this);
+                }
             }
         }
     }
@@ -23,6 +23,8 @@
 #define KEY_INTERNAL_ENDPOINT                   "mbed.InternalEndpoint"
 #define KEY_DEVICE_SOFTWAREVERSION              "mbed.SoftwareVersion"
 #define KEY_FIRST_TO_CLAIM                      "mbed.FirstToClaim"
+#define KEY_BOOTSTRAP_TLS_SESSION               "mbed.BootstrapTLSSession"
+#define KEY_LWM2M_TLS_SESSION                   "mbed.LwM2MTLSSession"
 
 #ifdef __cplusplus
 extern "C" {